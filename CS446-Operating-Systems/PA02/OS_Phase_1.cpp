@@ -34,6 +34,8 @@
 
 // global variables
    clock_t timer; // keeps track of time
+   bool deterministic = false; // true to use simulated time instead of processor time
+   float simulatedTime = 0.0; // current simulated time (seconds)
    map<string, float> cycleData; // cycles per action
    char logLocation; // location to log to
    ofstream outputFile; // output file stream
@@ -44,6 +46,8 @@
    void threadActions( PCB& process );
    void *runner( void *actVoidPtr ); 
    void printAction( stringstream& actionOutput ); 
+   float currentTime();
+   void waitUntil( float endTime );
 
 // main program
 int main( int argc, char* argv[] )
@@ -63,8 +67,14 @@ int main( int argc, char* argv[] )
 
       // read in configuration file
 
+         // check for deterministic option
+         if( argc == 3 && strcmp( argv[ 1 ], "--deterministic" ) == 0 )
+         {
+            deterministic = true;
+         }
+
          // check for incorrect arguments 
-         if( argc != 2 )
+         else if( argc != 2 )
          {
             // print failure 
             cout << "Incorrect arguments given. Please try again." << endl;
@@ -74,7 +84,7 @@ int main( int argc, char* argv[] )
          }
 
          // save configuration information
-         saveSucess = saveConfig( argv[1], phase, metaPath, logPath );
+         saveSucess = saveConfig( argv[ argc - 1 ], phase, metaPath, logPath );
 
          // check for failed save
          if( !saveSucess )
@@ -443,6 +453,7 @@ void threadActions( PCB& process )
 
    // set time output      
    timer = clock();   
+   simulatedTime = 0.0;
 
    // get the default attributes
    pthread_attr_init(&attr);
@@ -516,7 +527,7 @@ void *runner( void* actVoidPtr )
       // start system descriptor
       if( actPtr->actionDescriptor == "start")
       {
-         actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+         actionOutput << currentTime();
          actionOutput << " - " << "Simulator program starting \n";
          printAction( actionOutput );
       }
@@ -524,7 +535,7 @@ void *runner( void* actVoidPtr )
       // end system descriptor
       else
       {
-         actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+         actionOutput << currentTime();
          actionOutput << " - " << "Simulator program ending \n";
          printAction( actionOutput );
       }
@@ -537,11 +548,11 @@ void *runner( void* actVoidPtr )
       // start application descriptor
       if( actPtr->actionDescriptor == "start")
       {
-         actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+         actionOutput << currentTime();
          actionOutput << " - " << "OS: preparing process 1 \n";
          printAction( actionOutput );
 
-         actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+         actionOutput << currentTime();
          actionOutput << " - " << "OS: starting process 1 \n";   
          printAction( actionOutput );
       }      
@@ -549,7 +560,7 @@ void *runner( void* actVoidPtr )
       // end application descriptor
       else
       {
-         actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+         actionOutput << currentTime();
          actionOutput << " - " << "OS: removing process 1 \n";    
          printAction( actionOutput );     
       }
@@ -560,18 +571,18 @@ void *runner( void* actVoidPtr )
    else if( actPtr->actionType == 'P' )
    {
       // set current time
-      floatTime = ((float)(clock() - timer)/CLOCKS_PER_SEC);
+      floatTime = currentTime();
 
       // run application descriptor start
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process 1: start processing action \n"; 
       printAction( actionOutput );
 
       // run for specified time
-      while( ((float)(clock()-timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+      waitUntil( floatTime + runTime );
 
       // run application desciptor end 
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process 1: end processing action \n";
       printAction( actionOutput );      
    }
@@ -580,18 +591,18 @@ void *runner( void* actVoidPtr )
    else if( actPtr->actionType == 'I' )
    {
       // set current time
-      floatTime = ((float)(clock() - timer)/CLOCKS_PER_SEC);
+      floatTime = currentTime();
 
       // input descriptor start
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process 1: start " << actPtr->actionDescriptor << " input \n"; 
       printAction( actionOutput );
 
       // run for specified time
-      while( ((float)(clock()-timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+      waitUntil( floatTime + runTime );
 
       // input desciptor end 
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process 1: end " << actPtr->actionDescriptor << " input \n";
       printAction( actionOutput );
    }
@@ -600,18 +611,18 @@ void *runner( void* actVoidPtr )
    else if( actPtr->actionType == 'O' )
    {
       // set current time
-      floatTime = ((float)(clock() - timer)/CLOCKS_PER_SEC);
+      floatTime = currentTime();
 
       // output descriptor start
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process 1: start " << actPtr->actionDescriptor << " output \n"; 
       printAction( actionOutput );
       
       // run for specified time
-      while( ((float)(clock()-timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+      waitUntil( floatTime + runTime );
 
       // output desciptor end 
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process 1: end " << actPtr->actionDescriptor << " output \n";
       printAction( actionOutput );
    }   
@@ -619,7 +630,7 @@ void *runner( void* actVoidPtr )
    // unrecognized action type
    else 
    {
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process 1: unrecognized action \n";
       printAction( actionOutput );
    }   
@@ -659,3 +670,50 @@ void printAction( stringstream& actionOutput )
    actionOutput.clear();
 }
 
+/**
+currentTime
+
+Returns the time since the simulation started. In deterministic mode
+this is the simulated time, so the log is the same on every run.
+
+@pre timer was set
+@post none
+@return float with time in seconds
+*/
+float currentTime()
+{
+   // for simulated time
+   if( deterministic )
+   {
+      return simulatedTime;
+   }
+
+   return ((float)(clock()-timer)/CLOCKS_PER_SEC);
+}
+
+/**
+waitUntil
+
+Waits until the given time. In deterministic mode the simulated time
+is moved forward instead.
+
+@param endTime time (in seconds) to wait until
+@pre timer was set
+@post current time is at or past endTime
+@return void
+*/
+void waitUntil( float endTime )
+{
+   // for simulated time
+   if( deterministic )
+   {
+      if( endTime > simulatedTime )
+      {
+         simulatedTime = endTime;
+      }
+
+      return;
+   }
+
+   while( currentTime() < endTime ); // busy wait
+}
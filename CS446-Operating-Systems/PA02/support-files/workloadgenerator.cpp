@@ -0,0 +1,1129 @@
+/**
+ * @file   workloadgenerator.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Non-interactive meta-data generator for Operating System simulator
+ *
+ * Writes meta-data files of any size from command line settings, for load
+ * tests. Processes are made in blocks of BLOCK_PROCESSES, each with its own
+ * random number generator seeded from the seed and the block number, so
+ * the file only depends on the seed and settings, not on the number of
+ * threads. Threads take the next block to make, and the main thread writes
+ * finished blocks to the file in order, a whole block per write. At most
+ * SLOTS_PER_THREAD blocks per thread wait to be written at once.
+ *
+ * Burst lengths may be drawn from fixed, uniform, exponential, Pareto or
+ * bimodal distributions. Processes may be drawn from a mix of classes
+ * (batch, interactive and I/O-bound), each with its own processing
+ * percent, devices and bursts, and may alternate between CPU and I/O
+ * phases, so processing and I/O actions come in runs like real programs.
+ */
+
+// header files
+   #include <iostream> // used for I/O
+   #include <string> // used for block text
+   #include <vector> // used for block slots and threads
+   #include <cstring> // used for c string operations
+   #include <cstdlib> // used for string conversions
+   #include <cmath> // used for burst distributions
+   #include <cerrno> // used to retry interrupted writes
+   #include <climits> // used for setting limits
+   #include <ctime> // used to time generation
+   #include <stdint.h> // used for random number state
+   #include <fcntl.h> // used to open output file
+   #include <unistd.h> // used to write output file
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+   const int MAX_LINE_LENGTH = 70;
+   const int TOKEN_LEN = 48;
+   const long long BLOCK_PROCESSES = 1024;
+   const int SLOTS_PER_THREAD = 4;
+   const int MAX_THREADS = 256;
+   const int PERCENT = 100;
+   const double BYTES_PER_MB = 1048576.0;
+   const int MAX_BURST_CYCLES = 1000000;
+   const long long MAX_ARRIVAL = INT_MAX; // latest arrival the simulator reads (msec)
+   const double PHASE_CONTRAST = 0.8;
+
+   // devices, indexed by DeviceID
+   enum DeviceID
+   {
+      DEVICE_HARD_DRIVE,
+      DEVICE_KEYBOARD,
+      DEVICE_MONITOR,
+      DEVICE_PRINTER,
+      DEVICE_COUNT
+   };
+
+   const char* const INPUT_ACTIONS[ DEVICE_COUNT ] = { "I(hard drive)", "I(keyboard)", "I(monitor)", "I(printer)" };
+   const char* const OUTPUT_ACTIONS[ DEVICE_COUNT ] = { "O(hard drive)", "O(keyboard)", "O(monitor)", "O(printer)" };
+
+   // true if device can be used for input (I) or output (O) actions
+   const bool DEVICE_INPUT[ DEVICE_COUNT ] = { true, true, false, false };
+   const bool DEVICE_OUTPUT[ DEVICE_COUNT ] = { true, false, true, true };
+
+   // burst length distributions, indexed by BurstKind
+   enum BurstKind
+   {
+      BURST_FIXED, // always first cycles
+      BURST_UNIFORM, // whole cycles from first to second, equally likely
+      BURST_EXPONENTIAL, // exponential with mean first
+      BURST_PARETO, // Pareto with least value first and shape second
+      BURST_BIMODAL, // exponential with mean first, or mean second by chance
+      BURST_KIND_COUNT
+   };
+
+   const char* const BURST_NAMES[ BURST_KIND_COUNT ] = { "fixed", "uniform", "exponential", "pareto", "bimodal" };
+   const int BURST_PARAMETERS[ BURST_KIND_COUNT ] = { 1, 2, 1, 2, 3 };
+
+   // process classes, indexed by ClassID
+   enum ClassID
+   {
+      CLASS_BATCH, // long processing bursts, heavy tailed
+      CLASS_INTERACTIVE, // short processing bursts between keyboard and monitor
+      CLASS_IO_BOUND, // mostly hard drive and printer actions
+      CLASS_COUNT
+   };
+
+// global variables
+
+// class declaration
+
+// distribution of the cycles of one kind of action (parameters by BurstKind)
+struct BurstModel
+{
+   int kind; // BurstKind
+   double first; // first parameter
+   double second; // second parameter
+   double chance; // chance of second mode (BURST_BIMODAL)
+};
+
+// actions made by one kind of process
+struct ProcessClass
+{
+   int runPercent; // percent of actions that are processing
+   double deviceWeights[ DEVICE_COUNT ]; // relative use of each device
+   BurstModel runBurst; // cycles of processing actions
+   BurstModel ioBurst; // cycles of I/O actions
+};
+
+// settings given on the command line
+struct GeneratorSettings
+{
+   string outputPath; // file written ("-" for the monitor)
+   uint64_t seed; // random seed
+   long long processCount; // processes made
+   int opCount; // actions per process
+   ProcessClass custom; // class of every process, unless classes are mixed
+   ProcessClass classes[ CLASS_COUNT ]; // classes of a mix
+   double classWeights[ CLASS_COUNT ]; // share of each class in a mix
+   bool classMix; // true if processes are drawn from classes
+   int phaseLength; // mean actions per CPU or I/O phase (0 for no phases)
+   long long arrivalGap; // msec between arrivals of processes
+   int threadCount; // threads making blocks
+};
+
+// state of a splitmix64 random number generator
+struct RandomState
+{
+   uint64_t state;
+};
+
+// blocks shared by the making threads and the writing thread
+struct BlockQueue
+{
+   const GeneratorSettings* settings;
+   long long blockCount; // blocks in file
+   long long nextBlock; // next block to make
+   long long writtenBlocks; // blocks written (in order)
+   vector<string> slots; // text of blocks waiting to be written
+   vector<bool> ready; // true once slot's block is made
+   pthread_mutex_t lock;
+   pthread_cond_t blockMade; // signaled when a block is made
+   pthread_cond_t slotFreed; // signaled when a block is written
+};
+
+// function prototypes
+   bool readSettings( int argc, char* argv[], GeneratorSettings& settings );
+   void setClasses( GeneratorSettings& settings );
+   bool readBurst( const char* text, BurstModel& burst );
+   bool readWeights( const char* text, double* weights, int count );
+   bool readNumber( const char* text, long long minimum, long long& value );
+   void printUsage();
+   void *makeBlocks( void* queueVoidPtr );
+   void makeBlock( const GeneratorSettings& settings, long long block, string& text );
+   void makeProcess( const GeneratorSettings& settings, const ProcessClass& processClass, long long process,
+                     RandomState& random, string& text, int& lineLength );
+   int chooseWeighted( RandomState& random, const double* weights, const bool* allowed, int count );
+   int drawCycles( RandomState& random, const BurstModel& burst );
+   void appendAction( string& text, int& lineLength, const char* action, long long cycles );
+   bool writeText( int fileDescriptor, const char* text, size_t length );
+   void seedRandom( RandomState& random, uint64_t seed, long long block );
+   uint64_t nextRandom( RandomState& random );
+   double nextUniform( RandomState& random );
+
+// main program
+int main( int argc, char* argv[] )
+{
+   // initialize variables
+   GeneratorSettings settings;
+   BlockQueue queue;
+   vector<pthread_t> threads;
+   struct timespec startTime;
+   struct timespec endTime;
+   const char* header = "Start Program Meta-Data Code:\nS(start)0; \n";
+   const char* footer = "S(end)0.\nEnd Program Meta-Data Code.\n";
+   size_t slotIndex;
+   size_t byteCount;
+   int fileDescriptor;
+   int threadIndex;
+   bool writeSucess;
+   double seconds;
+
+   // read in settings
+   if( !readSettings( argc, argv, settings ) )
+   {
+      printUsage();
+
+      // return failure
+      return 1;
+   }
+
+   // open output file
+   if( settings.outputPath == "-" )
+   {
+      fileDescriptor = STDOUT_FILENO;
+   }
+
+   else
+   {
+      fileDescriptor = open( settings.outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+   }
+
+      // check for file that could not be opened
+      if( fileDescriptor < 0 )
+      {
+         // print failure
+         cerr << "Error in output file. Please try again." << endl;
+
+         // return failure
+         return 1;
+      }
+
+   clock_gettime( CLOCK_MONOTONIC, &startTime );
+
+   // prepare blocks
+   queue.settings = &settings;
+   queue.blockCount = ( settings.processCount + BLOCK_PROCESSES - 1 ) / BLOCK_PROCESSES;
+   queue.nextBlock = 0;
+   queue.writtenBlocks = 0;
+   queue.slots.resize( settings.threadCount * SLOTS_PER_THREAD );
+   queue.ready.assign( queue.slots.size(), false );
+   pthread_mutex_init( &queue.lock, NULL );
+   pthread_cond_init( &queue.blockMade, NULL );
+   pthread_cond_init( &queue.slotFreed, NULL );
+
+   // start threads making blocks
+   threads.resize( settings.threadCount );
+
+   for( threadIndex = 0; threadIndex < settings.threadCount; threadIndex++ )
+   {
+      pthread_create( &( threads[ threadIndex ] ), NULL, makeBlocks, &queue );
+   }
+
+   // write blocks in order as they are made
+   writeSucess = writeText( fileDescriptor, header, strlen( header ) );
+   byteCount = strlen( header );
+
+   while( queue.writtenBlocks < queue.blockCount )
+   {
+      slotIndex = queue.writtenBlocks % queue.slots.size();
+
+      pthread_mutex_lock( &queue.lock );
+
+      while( !queue.ready[ slotIndex ] )
+      {
+         pthread_cond_wait( &queue.blockMade, &queue.lock );
+      }
+
+      pthread_mutex_unlock( &queue.lock );
+
+      // write block (without lock, its slot is not reused until freed)
+      writeSucess = writeSucess && writeText( fileDescriptor, queue.slots[ slotIndex ].data(), queue.slots[ slotIndex ].size() );
+      byteCount += queue.slots[ slotIndex ].size();
+
+      // free slot for the block one lap later
+      pthread_mutex_lock( &queue.lock );
+      queue.ready[ slotIndex ] = false;
+      queue.writtenBlocks++;
+      pthread_cond_broadcast( &queue.slotFreed );
+      pthread_mutex_unlock( &queue.lock );
+   }
+
+   writeSucess = writeSucess && writeText( fileDescriptor, footer, strlen( footer ) );
+   byteCount += strlen( footer );
+
+   // wait for threads
+   for( threadIndex = 0; threadIndex < settings.threadCount; threadIndex++ )
+   {
+      pthread_join( threads[ threadIndex ], NULL );
+   }
+
+   pthread_cond_destroy( &queue.slotFreed );
+   pthread_cond_destroy( &queue.blockMade );
+   pthread_mutex_destroy( &queue.lock );
+
+   // close output file
+   if( fileDescriptor != STDOUT_FILENO && close( fileDescriptor ) != 0 )
+   {
+      writeSucess = false;
+   }
+
+      // check for failed write
+      if( !writeSucess )
+      {
+         // print failure
+         cerr << "Error writing output file. Please try again." << endl;
+
+         // return failure
+         return 1;
+      }
+
+   clock_gettime( CLOCK_MONOTONIC, &endTime );
+   seconds = ( endTime.tv_sec - startTime.tv_sec ) + ( endTime.tv_nsec - startTime.tv_nsec ) / 1e9;
+
+   // print summary (to the error stream, so it is not mixed with the file)
+   cerr << "Wrote " << settings.processCount << " processes (" << byteCount / BYTES_PER_MB << " MB) in "
+        << seconds << " seconds with " << settings.threadCount << " threads" << endl;
+
+   // return sucess
+   return 0;
+}
+
+// function implementation
+
+/**
+readSettings
+
+Reads settings from the command line. Settings not given keep their
+defaults, which make files like those of programgenerator.
+
+@param argc number of command line arguments
+@param argv command line arguments
+@param settings reference to save settings to
+@pre none
+@post settings were saved
+@return bool representing settings were valid
+*/
+bool readSettings( int argc, char* argv[], GeneratorSettings& settings )
+{
+   // initialize variables
+   long long value;
+   int argIndex;
+   int deviceID;
+   string flag;
+
+   // set defaults
+   settings.seed = 1;
+   settings.processCount = 10;
+   settings.opCount = 10;
+   settings.custom.runPercent = 50;
+   settings.custom.runBurst.kind = BURST_UNIFORM;
+   settings.custom.runBurst.first = 5;
+   settings.custom.runBurst.second = 15;
+   settings.custom.runBurst.chance = 0;
+   settings.custom.ioBurst = settings.custom.runBurst;
+   settings.classMix = false;
+   settings.phaseLength = 0;
+   settings.arrivalGap = 0;
+   setClasses( settings );
+   settings.threadCount = (int) sysconf( _SC_NPROCESSORS_ONLN );
+
+   if( settings.threadCount < 1 || settings.threadCount > MAX_THREADS )
+   {
+      settings.threadCount = settings.threadCount < 1 ? 1 : MAX_THREADS;
+   }
+
+   for( deviceID = 0; deviceID < DEVICE_COUNT; deviceID++ )
+   {
+      settings.custom.deviceWeights[ deviceID ] = 1;
+   }
+
+   // read in each flag and its value
+   for( argIndex = 1; argIndex < argc; argIndex += 2 )
+   {
+      flag = argv[ argIndex ];
+
+      // check for flag without value
+      if( argIndex + 1 >= argc )
+      {
+         cerr << "Error: " << flag << " needs a value." << endl;
+         return false;
+      }
+
+      if( flag == "--output" )
+      {
+         settings.outputPath = argv[ argIndex + 1 ];
+      }
+
+      else if( flag == "--seed" && readNumber( argv[ argIndex + 1 ], 0, value ) )
+      {
+         settings.seed = (uint64_t) value;
+      }
+
+      else if( flag == "--processes" && readNumber( argv[ argIndex + 1 ], 1, value ) )
+      {
+         settings.processCount = value;
+      }
+
+      else if( flag == "--ops" && readNumber( argv[ argIndex + 1 ], 1, value ) && value <= INT_MAX )
+      {
+         settings.opCount = (int) value;
+      }
+
+      else if( flag == "--run-percent" && readNumber( argv[ argIndex + 1 ], 0, value ) && value <= PERCENT )
+      {
+         settings.custom.runPercent = (int) value;
+      }
+
+      else if( flag == "--devices" && readWeights( argv[ argIndex + 1 ], settings.custom.deviceWeights, DEVICE_COUNT ) )
+      {
+      }
+
+      else if( flag == "--run-burst" && readBurst( argv[ argIndex + 1 ], settings.custom.runBurst ) )
+      {
+      }
+
+      else if( flag == "--io-burst" && readBurst( argv[ argIndex + 1 ], settings.custom.ioBurst ) )
+      {
+      }
+
+      else if( flag == "--class-mix" && readWeights( argv[ argIndex + 1 ], settings.classWeights, CLASS_COUNT ) )
+      {
+         settings.classMix = true;
+      }
+
+      else if( flag == "--phase-length" && readNumber( argv[ argIndex + 1 ], 0, value ) && value <= INT_MAX )
+      {
+         settings.phaseLength = (int) value;
+      }
+
+      else if( flag == "--arrival-gap" && readNumber( argv[ argIndex + 1 ], 0, value ) && value <= MAX_ARRIVAL )
+      {
+         settings.arrivalGap = value;
+      }
+
+      else if( flag == "--threads" && readNumber( argv[ argIndex + 1 ], 1, value ) && value <= MAX_THREADS )
+      {
+         settings.threadCount = (int) value;
+      }
+
+      // unrecognized flag or invalid value
+      else
+      {
+         cerr << "Error: invalid setting " << flag << " " << argv[ argIndex + 1 ] << "." << endl;
+         return false;
+      }
+   }
+
+   // check for missing output file, or for I/O without a device
+   if( settings.outputPath.empty() )
+   {
+      cerr << "Error: --output is required." << endl;
+      return false;
+   }
+
+   if( !settings.classMix && settings.custom.runPercent < PERCENT &&
+       ( ( settings.custom.deviceWeights[ DEVICE_HARD_DRIVE ] + settings.custom.deviceWeights[ DEVICE_KEYBOARD ] ) <= 0 ||
+         ( settings.custom.deviceWeights[ DEVICE_HARD_DRIVE ] + settings.custom.deviceWeights[ DEVICE_MONITOR ] +
+           settings.custom.deviceWeights[ DEVICE_PRINTER ] ) <= 0 ) )
+   {
+      cerr << "Error: --devices needs an input device (hard drive or keyboard) and an output device." << endl;
+      return false;
+   }
+
+   // check last arrival can be read by the simulator
+   if( settings.arrivalGap > 0 && settings.processCount - 1 > MAX_ARRIVAL / settings.arrivalGap )
+   {
+      cerr << "Error: the last arrival (--arrival-gap times one less than --processes) must be at most " << MAX_ARRIVAL << " msec." << endl;
+      return false;
+   }
+
+   if( settings.classMix && settings.classWeights[ CLASS_BATCH ] + settings.classWeights[ CLASS_INTERACTIVE ] +
+                            settings.classWeights[ CLASS_IO_BOUND ] <= 0 )
+   {
+      cerr << "Error: --class-mix needs a class with a positive share." << endl;
+      return false;
+   }
+
+   return true;
+}
+
+/**
+setClasses
+
+Sets the actions made by each class of a class mix.
+
+@param settings settings to save classes to
+@pre none
+@post classes were set
+@return void
+*/
+void setClasses( GeneratorSettings& settings )
+{
+   // initialize variables
+   ProcessClass& batch = settings.classes[ CLASS_BATCH ];
+   ProcessClass& interactive = settings.classes[ CLASS_INTERACTIVE ];
+   ProcessClass& ioBound = settings.classes[ CLASS_IO_BOUND ];
+   BurstModel burst;
+
+   // batch: processing in heavy tailed bursts (Pareto, mean 30 cycles),
+   // reading and writing the hard drive between them
+   batch.runPercent = 90;
+   burst.kind = BURST_PARETO;
+   burst.first = 10;
+   burst.second = 1.5;
+   burst.chance = 0;
+   batch.runBurst = burst;
+   burst.kind = BURST_UNIFORM;
+   burst.first = 5;
+   burst.second = 15;
+   batch.ioBurst = burst;
+   batch.deviceWeights[ DEVICE_HARD_DRIVE ] = 4;
+   batch.deviceWeights[ DEVICE_KEYBOARD ] = 0;
+   batch.deviceWeights[ DEVICE_MONITOR ] = 1;
+   batch.deviceWeights[ DEVICE_PRINTER ] = 1;
+
+   // interactive: short processing bursts, waiting on keyboard and monitor
+   interactive.runPercent = 40;
+   burst.kind = BURST_EXPONENTIAL;
+   burst.first = 3;
+   interactive.runBurst = burst;
+   burst.first = 10;
+   interactive.ioBurst = burst;
+   interactive.deviceWeights[ DEVICE_HARD_DRIVE ] = 1;
+   interactive.deviceWeights[ DEVICE_KEYBOARD ] = 4;
+   interactive.deviceWeights[ DEVICE_MONITOR ] = 4;
+   interactive.deviceWeights[ DEVICE_PRINTER ] = 0;
+
+   // I/O-bound: mostly hard drive actions, usually short but sometimes long
+   ioBound.runPercent = 20;
+   burst.kind = BURST_EXPONENTIAL;
+   burst.first = 4;
+   ioBound.runBurst = burst;
+   burst.kind = BURST_BIMODAL;
+   burst.first = 8;
+   burst.second = 40;
+   burst.chance = 0.2;
+   ioBound.ioBurst = burst;
+   ioBound.deviceWeights[ DEVICE_HARD_DRIVE ] = 6;
+   ioBound.deviceWeights[ DEVICE_KEYBOARD ] = 0;
+   ioBound.deviceWeights[ DEVICE_MONITOR ] = 1;
+   ioBound.deviceWeights[ DEVICE_PRINTER ] = 2;
+}
+
+/**
+readBurst
+
+Reads a burst length distribution, given as its name and parameters
+separated by colons: "fixed:N", "uniform:LOW:HIGH" (whole cycles),
+"exponential:MEAN", "pareto:MIN:SHAPE" or "bimodal:SHORT:LONG:CHANCE"
+(exponential with mean SHORT, or mean LONG with the given chance).
+
+@param text distribution text
+@param burst reference to save distribution to
+@pre none
+@post burst was saved if text was valid
+@return bool representing text was valid
+*/
+bool readBurst( const char* text, BurstModel& burst )
+{
+   // initialize variables
+   BurstModel tempBurst;
+   double parameters[ 3 ] = { 0, 0, 0 };
+   const char* position = strchr( text, ':' );
+   char* end;
+   int parameterIndex;
+   bool valid;
+
+   if( position == NULL )
+   {
+      return false;
+   }
+
+   // find distribution
+   for( tempBurst.kind = 0; tempBurst.kind < BURST_KIND_COUNT; tempBurst.kind++ )
+   {
+      if( strlen( BURST_NAMES[ tempBurst.kind ] ) == (size_t)( position - text ) &&
+          strncmp( text, BURST_NAMES[ tempBurst.kind ], position - text ) == 0 )
+      {
+         break;
+      }
+   }
+
+   if( tempBurst.kind == BURST_KIND_COUNT )
+   {
+      return false;
+   }
+
+   // read in parameters
+   for( parameterIndex = 0; parameterIndex < BURST_PARAMETERS[ tempBurst.kind ]; parameterIndex++ )
+   {
+      parameters[ parameterIndex ] = strtod( position + 1, &end );
+
+      if( end == position + 1 || *end != ( parameterIndex + 1 < BURST_PARAMETERS[ tempBurst.kind ] ? ':' : '\0' ) )
+      {
+         return false;
+      }
+
+      position = end;
+   }
+
+   tempBurst.first = parameters[ 0 ];
+   tempBurst.second = parameters[ 1 ];
+   tempBurst.chance = parameters[ 2 ];
+
+   // check for invalid parameters
+   switch( tempBurst.kind )
+   {
+      case BURST_FIXED:
+         valid = tempBurst.first >= 1 && tempBurst.first <= MAX_BURST_CYCLES && tempBurst.first == floor( tempBurst.first );
+         break;
+
+      case BURST_UNIFORM:
+         valid = tempBurst.first >= 1 && tempBurst.second >= tempBurst.first && tempBurst.second <= MAX_BURST_CYCLES &&
+                 tempBurst.first == floor( tempBurst.first ) && tempBurst.second == floor( tempBurst.second );
+         break;
+
+      case BURST_BIMODAL:
+         valid = tempBurst.first > 0 && tempBurst.second > 0 && tempBurst.chance >= 0 && tempBurst.chance <= 1;
+         break;
+
+      default:
+         valid = tempBurst.first > 0 && ( tempBurst.kind != BURST_PARETO || tempBurst.second > 0 );
+         break;
+   }
+
+   if( valid )
+   {
+      burst = tempBurst;
+   }
+
+   return valid;
+}
+
+/**
+readWeights
+
+Reads relative weights, given as numbers separated by commas (devices in
+the order hard drive, keyboard, monitor, printer; classes in the order
+batch, interactive, I/O-bound).
+
+@param text weights text
+@param weights array of count weights to save to
+@param count number of weights
+@pre count is at most DEVICE_COUNT
+@post weights were saved if text was valid
+@return bool representing text was valid
+*/
+bool readWeights( const char* text, double* weights, int count )
+{
+   // initialize variables
+   double tempWeights[ DEVICE_COUNT ];
+   const char* position = text;
+   char* end;
+   int index;
+
+   for( index = 0; index < count; index++ )
+   {
+      tempWeights[ index ] = strtod( position, &end );
+
+      // check for missing or negative weight, or missing separator
+      if( end == position || tempWeights[ index ] < 0 ||
+          *end != ( index + 1 < count ? ',' : '\0' ) )
+      {
+         return false;
+      }
+
+      position = end + 1;
+   }
+
+   memcpy( weights, tempWeights, count * sizeof( double ) );
+
+   return true;
+}
+
+/**
+readNumber
+
+Reads a whole number that is at least a minimum.
+
+@param text number text
+@param minimum lowest value allowed
+@param value reference to save number to
+@pre none
+@post value was saved if text was valid
+@return bool representing text was valid
+*/
+bool readNumber( const char* text, long long minimum, long long& value )
+{
+   // initialize variables
+   char* end;
+   long long tempValue;
+
+   errno = 0;
+   tempValue = strtoll( text, &end, 10 );
+
+   if( end == text || *end != '\0' || errno != 0 || tempValue < minimum )
+   {
+      return false;
+   }
+
+   value = tempValue;
+
+   return true;
+}
+
+/**
+printUsage
+
+Prints the command line settings.
+
+@pre none
+@post usage was printed
+@return void
+*/
+void printUsage()
+{
+   cerr << "Usage: workloadgenerator --output FILE [settings]" << endl
+        << "   --output FILE         meta-data file to write (- for the monitor)" << endl
+        << "   --seed N              random seed (default 1)" << endl
+        << "   --processes N         number of processes (default 10)" << endl
+        << "   --ops N               actions per process (default 10)" << endl
+        << "   --run-percent P       percent of actions that are processing (default 50)" << endl
+        << "   --devices H,K,M,P     relative use of hard drive, keyboard, monitor, printer (default 1,1,1,1)" << endl
+        << "   --run-burst MODEL     processing cycles (default uniform:5:15), one of" << endl
+        << "                            fixed:N, uniform:LOW:HIGH, exponential:MEAN, pareto:MIN:SHAPE," << endl
+        << "                            bimodal:SHORT:LONG:CHANCE" << endl
+        << "   --io-burst MODEL      I/O cycles, as for --run-burst (default uniform:5:15)" << endl
+        << "   --class-mix B,I,O     share of batch, interactive and I/O-bound processes" << endl
+        << "                            (replaces the four settings above)" << endl
+        << "   --phase-length N      mean actions per CPU or I/O phase (default 0, no phases)" << endl
+        << "   --arrival-gap MSEC    time between process arrivals (default 0)" << endl
+        << "   --threads N           threads making processes (default number of processors)" << endl;
+}
+
+/**
+makeBlocks
+
+Runs on each making thread. Takes the next block to make, waits for its
+slot to be written, and makes the block into the slot.
+
+@param queueVoidPtr void pointer to the BlockQueue
+@pre queue was prepared
+@post every block was taken by a thread
+@return void
+*/
+void *makeBlocks( void* queueVoidPtr )
+{
+   // initialize variables
+   BlockQueue* queuePtr = static_cast<BlockQueue*>( queueVoidPtr );
+   long long slotCount = queuePtr->slots.size();
+   long long block;
+   size_t slotIndex;
+
+   while( true )
+   {
+      // take next block
+      pthread_mutex_lock( &queuePtr->lock );
+
+      if( queuePtr->nextBlock >= queuePtr->blockCount )
+      {
+         pthread_mutex_unlock( &queuePtr->lock );
+         break;
+      }
+
+      block = queuePtr->nextBlock++;
+
+      // wait for block one lap earlier to be written
+      while( block >= queuePtr->writtenBlocks + slotCount )
+      {
+         pthread_cond_wait( &queuePtr->slotFreed, &queuePtr->lock );
+      }
+
+      pthread_mutex_unlock( &queuePtr->lock );
+
+      // make block (without lock, no other thread uses its slot)
+      slotIndex = block % slotCount;
+      makeBlock( *queuePtr->settings, block, queuePtr->slots[ slotIndex ] );
+
+      pthread_mutex_lock( &queuePtr->lock );
+      queuePtr->ready[ slotIndex ] = true;
+      pthread_cond_signal( &queuePtr->blockMade );
+      pthread_mutex_unlock( &queuePtr->lock );
+   }
+
+   return NULL;
+}
+
+/**
+makeBlock
+
+Makes the text of the processes of one block. The block's random numbers
+only depend on the seed and block number, and it starts on a new line, so
+its text is the same whichever thread makes it.
+
+@param settings generator settings
+@param block block number
+@param text reference to save text to (old text is replaced)
+@pre none
+@post text holds processes of block, ending with a line end
+@return void
+*/
+void makeBlock( const GeneratorSettings& settings, long long block, string& text )
+{
+   // initialize variables
+   RandomState random;
+   long long process = block * BLOCK_PROCESSES;
+   long long lastProcess = min( process + BLOCK_PROCESSES, settings.processCount );
+   const bool allClasses[ CLASS_COUNT ] = { true, true, true };
+   int lineLength = 0;
+   int classID;
+
+   text.clear();
+   seedRandom( random, settings.seed, block );
+
+   for( ; process < lastProcess; process++ )
+   {
+      if( settings.classMix )
+      {
+         classID = chooseWeighted( random, settings.classWeights, allClasses, CLASS_COUNT );
+         makeProcess( settings, settings.classes[ classID ], process, random, text, lineLength );
+      }
+
+      else
+      {
+         makeProcess( settings, settings.custom, process, random, text, lineLength );
+      }
+   }
+
+   if( lineLength > 0 )
+   {
+      text += '\n';
+   }
+}
+
+/**
+makeProcess
+
+Adds the actions of one process to block text. I/O actions alternate
+between input and output. With phases, the process switches between a
+CPU phase and an I/O phase, each lasting phaseLength actions on average
+(longer for the phase the class spends more time in). A CPU phase
+processes more often than the class's processing percent and an I/O
+phase less often, by PHASE_CONTRAST of the difference, and the share of
+time in each phase keeps the class's processing percent overall.
+
+@param settings generator settings
+@param processClass actions made by the process
+@param process process number (from 0)
+@param random random number state of block
+@param text block text
+@param lineLength length of last line of text
+@pre none
+@post process was added to text
+@return void
+*/
+void makeProcess( const GeneratorSettings& settings, const ProcessClass& processClass, long long process,
+                  RandomState& random, string& text, int& lineLength )
+{
+   // initialize variables
+   double cpuShare = processClass.runPercent / (double) PERCENT;
+   double cpuRunChance = processClass.runPercent + ( PERCENT - processClass.runPercent ) * PHASE_CONTRAST;
+   double ioRunChance = processClass.runPercent * ( 1 - PHASE_CONTRAST );
+   bool phased = settings.phaseLength > 0 && processClass.runPercent > 0 && processClass.runPercent < PERCENT;
+   bool cpuPhase = phased && nextUniform( random ) < cpuShare;
+   bool input = true;
+   bool runs;
+   int opIndex;
+   int deviceID;
+
+   appendAction( text, lineLength, "A(start)", process * settings.arrivalGap );
+
+   for( opIndex = 0; opIndex < settings.opCount; opIndex++ )
+   {
+      if( phased )
+      {
+         runs = nextUniform( random ) * PERCENT < ( cpuPhase ? cpuRunChance : ioRunChance );
+      }
+
+      else
+      {
+         runs = (int)( nextRandom( random ) % PERCENT ) < processClass.runPercent;
+      }
+
+      if( runs )
+      {
+         appendAction( text, lineLength, "P(run)", drawCycles( random, processClass.runBurst ) );
+      }
+
+      else
+      {
+         deviceID = chooseWeighted( random, processClass.deviceWeights, input ? DEVICE_INPUT : DEVICE_OUTPUT, DEVICE_COUNT );
+
+         appendAction( text, lineLength, input ? INPUT_ACTIONS[ deviceID ] : OUTPUT_ACTIONS[ deviceID ],
+                       drawCycles( random, processClass.ioBurst ) );
+         input = !input;
+      }
+
+      // end phase (a phase of mean length L ends with chance 1 / L)
+      if( phased && nextUniform( random ) * 2 * settings.phaseLength * ( cpuPhase ? cpuShare : 1 - cpuShare ) < 1 )
+      {
+         cpuPhase = !cpuPhase;
+      }
+   }
+
+   appendAction( text, lineLength, "A(end)", 0 );
+}
+
+/**
+chooseWeighted
+
+Chooses an index at random, in proportion to its weight, from the indexes
+allowed (devices or classes).
+
+@param random random number state
+@param weights weight of each index
+@param allowed true for each index that may be chosen
+@param count number of indexes
+@pre an allowed index has a positive weight
+@post random was advanced
+@return int with index chosen
+*/
+int chooseWeighted( RandomState& random, const double* weights, const bool* allowed, int count )
+{
+   // initialize variables
+   double total = 0;
+   double point;
+   int index;
+   int lastAllowed = 0;
+
+   for( index = 0; index < count; index++ )
+   {
+      if( allowed[ index ] && weights[ index ] > 0 )
+      {
+         total += weights[ index ];
+         lastAllowed = index;
+      }
+   }
+
+   point = nextUniform( random ) * total;
+
+   for( index = 0; index < lastAllowed; index++ )
+   {
+      if( allowed[ index ] && weights[ index ] > 0 )
+      {
+         if( point < weights[ index ] )
+         {
+            return index;
+         }
+
+         point -= weights[ index ];
+      }
+   }
+
+   return lastAllowed;
+}
+
+/**
+drawCycles
+
+Draws the cycles of an action from its burst length distribution.
+
+@param random random number state
+@param burst distribution of cycles
+@pre burst was read with readBurst
+@post random was advanced
+@return int with cycles (from 1 to MAX_BURST_CYCLES)
+*/
+int drawCycles( RandomState& random, const BurstModel& burst )
+{
+   // initialize variables
+   uint64_t range;
+   double cycles;
+   double mean;
+
+   switch( burst.kind )
+   {
+      case BURST_UNIFORM:
+         range = (uint64_t)( burst.second - burst.first ) + 1;
+         return (int)( burst.first + nextRandom( random ) % range );
+
+      case BURST_EXPONENTIAL:
+      case BURST_BIMODAL:
+         mean = burst.kind == BURST_BIMODAL && nextUniform( random ) < burst.chance ? burst.second : burst.first;
+         cycles = -mean * log( 1 - nextUniform( random ) );
+         break;
+
+      case BURST_PARETO:
+         cycles = burst.first / pow( 1 - nextUniform( random ), 1 / burst.second );
+         break;
+
+      default:
+         return (int) burst.first;
+   }
+
+   // round to whole cycles, at least 1 and at most MAX_BURST_CYCLES
+   return (int) max( 1.0, min( (double) MAX_BURST_CYCLES, floor( cycles + 0.5 ) ) );
+}
+
+/**
+appendAction
+
+Adds one action to block text, starting a new line first if the action
+would make the line longer than MAX_LINE_LENGTH.
+
+@param text block text
+@param lineLength length of last line of text
+@param action action code and descriptor, e.g. "P(run)"
+@param cycles cycles of action
+@pre none
+@post action was added to text
+@return void
+*/
+void appendAction( string& text, int& lineLength, const char* action, long long cycles )
+{
+   // initialize variables
+   char token[ TOKEN_LEN ];
+   char digits[ TOKEN_LEN ];
+   int tokenLength = 0;
+   int digitCount = 0;
+
+   // build "action cycles; "
+   while( *action != '\0' && tokenLength < TOKEN_LEN / 2 )
+   {
+      token[ tokenLength++ ] = *action++;
+   }
+
+   do
+   {
+      digits[ digitCount++ ] = (char)( '0' + cycles % 10 );
+      cycles /= 10;
+   } while( cycles > 0 );
+
+   while( digitCount > 0 )
+   {
+      token[ tokenLength++ ] = digits[ --digitCount ];
+   }
+
+   token[ tokenLength++ ] = ';';
+   token[ tokenLength++ ] = ' ';
+
+   // start new line if action does not fit
+   if( lineLength > 0 && lineLength + tokenLength - 1 > MAX_LINE_LENGTH )
+   {
+      text += '\n';
+      lineLength = 0;
+   }
+
+   text.append( token, tokenLength );
+   lineLength += tokenLength;
+}
+
+/**
+writeText
+
+Writes all of a text to a file, retrying writes that were interrupted or
+only partly written.
+
+@param fileDescriptor open output file
+@param text text to write
+@param length length of text
+@pre none
+@post text was written unless an error occurred
+@return bool representing text was written
+*/
+bool writeText( int fileDescriptor, const char* text, size_t length )
+{
+   // initialize variables
+   ssize_t written;
+
+   while( length > 0 )
+   {
+      written = write( fileDescriptor, text, length );
+
+      if( written < 0 )
+      {
+         if( errno == EINTR )
+         {
+            continue;
+         }
+
+         return false;
+      }
+
+      text += written;
+      length -= written;
+   }
+
+   return true;
+}
+
+/**
+seedRandom
+
+Seeds the random numbers of a block from the seed and block number.
+
+@param random random number state
+@param seed random seed
+@param block block number
+@pre none
+@post random was seeded
+@return void
+*/
+void seedRandom( RandomState& random, uint64_t seed, long long block )
+{
+   random.state = seed;
+   random.state = nextRandom( random ) ^ ( (uint64_t) block * 0xD1B54A32D192ED03ULL );
+}
+
+/**
+nextRandom
+
+Returns the next 64 random bits (splitmix64).
+
+@param random random number state
+@pre random was seeded
+@post random was advanced
+@return uint64_t with random bits
+*/
+uint64_t nextRandom( RandomState& random )
+{
+   // initialize variables
+   uint64_t mixed;
+
+   random.state += 0x9E3779B97F4A7C15ULL;
+   mixed = random.state;
+   mixed = ( mixed ^ ( mixed >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+   mixed = ( mixed ^ ( mixed >> 27 ) ) * 0x94D049BB133111EBULL;
+
+   return mixed ^ ( mixed >> 31 );
+}
+
+/**
+nextUniform
+
+Returns a random number from 0 up to (not including) 1.
+
+@param random random number state
+@pre random was seeded
+@post random was advanced
+@return double with random number
+*/
+double nextUniform( RandomState& random )
+{
+   return ( nextRandom( random ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
@@ -39,6 +39,8 @@
 
 // global variables
    clock_t timer; // keeps track of time
+   bool deterministic = false; // true to use simulated time instead of processor time
+   float simulatedTime = 0.0; // current simulated time (seconds)
    map<string, float> cycleData; // cycles per action
    char logLocation; // location to log to
    ofstream outputFile; // output file stream
@@ -52,6 +54,8 @@
    void threadActions( PCB& process );
    void *runner( void *actVoidPtr ); 
    void printAction( stringstream& actionOutput ); 
+   float currentTime();
+   void waitUntil( float endTime );
 
 // main program
 int main( int argc, char* argv[] )
@@ -68,8 +72,14 @@ int main( int argc, char* argv[] )
 
       // read in configuration file
 
+         // check for deterministic option
+         if( argc == 3 && strcmp( argv[ 1 ], "--deterministic" ) == 0 )
+         {
+            deterministic = true;
+         }
+
          // check for incorrect arguments 
-         if( argc != 2 )
+         else if( argc != 2 )
          {
             // print failure 
             cout << "Incorrect arguments given. Please try again." << endl;
@@ -79,7 +89,7 @@ int main( int argc, char* argv[] )
          }
 
          // save configuration information
-         saveSucess = saveConfig( argv[1], phase, metaPath, logPath );
+         saveSucess = saveConfig( argv[ argc - 1 ], phase, metaPath, logPath );
 
          // check for failed save
          if( !saveSucess )
@@ -454,7 +464,7 @@ int saveMetaData( char* metaPath, list<PCB>& processes )
 
                   // delete temporary process
                   delete tempProcess;
-                  tempProcess = '\0';               
+                  tempProcess = NULL;               
 
                // move to next action
                metaFile.ignore( STD_LINE_LEN, ';' );
@@ -513,14 +523,15 @@ void runProcesses( list<PCB>& processes )
 
       // set time output      
       timer = clock(); 
+      simulatedTime = 0.0;
 
    // start simulator
-   actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+   actionOutput << currentTime();
    actionOutput << " - " << "Simulator program starting \n";
    printAction( actionOutput ); 
 
    // output preparing processes
-   actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+   actionOutput << currentTime();
    actionOutput << " - " << "OS: preparing all processes \n";
    printAction( actionOutput );      
 
@@ -533,7 +544,7 @@ void runProcesses( list<PCB>& processes )
          while( !processes.empty() )
          {
             // output preparing processes
-            actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+            actionOutput << currentTime();
             actionOutput << " - " << "OS: selecting next process \n";
             printAction( actionOutput );    
 
@@ -555,7 +566,7 @@ void runProcesses( list<PCB>& processes )
          while( !processes.empty() )
          {
             // output preparing processes
-            actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+            actionOutput << currentTime();
             actionOutput << " - " << "OS: selecting next process \n";
             printAction( actionOutput ); 
 
@@ -574,7 +585,7 @@ void runProcesses( list<PCB>& processes )
          while( !processes.empty() )
          {
             // output preparing processes
-            actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+            actionOutput << currentTime();
             actionOutput << " - " << "OS: selecting next process \n";
             printAction( actionOutput ); 
 
@@ -590,7 +601,7 @@ void runProcesses( list<PCB>& processes )
       }   
 
    // end simulator
-   actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+   actionOutput << currentTime();
    actionOutput << " - " << "Simulator program ending \n";
    printAction( actionOutput );
 }
@@ -685,7 +696,7 @@ void *runner( void* actVoidPtr )
       // start application descriptor
       if( actPtr->actionDescriptor == "start")
       {
-         actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+         actionOutput << currentTime();
          actionOutput << " - " << "OS: starting process " << actPtr -> pcbID << endl;   
          printAction( actionOutput );
       }      
@@ -693,7 +704,7 @@ void *runner( void* actVoidPtr )
       // end application descriptor
       else
       {
-         actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+         actionOutput << currentTime();
          actionOutput << " - " << "OS: removing process " << actPtr -> pcbID << endl; 
          printAction( actionOutput );     
       }
@@ -704,18 +715,18 @@ void *runner( void* actVoidPtr )
    else if( actPtr->actionType == 'P' )
    {
       // set current time
-      floatTime = ((float)(clock() - timer)/CLOCKS_PER_SEC);
+      floatTime = currentTime();
 
       // run application descriptor start
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process " << actPtr -> pcbID << ": start processing action \n"; 
       printAction( actionOutput );
 
       // run for specified time
-      while( ((float)(clock()-timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+      waitUntil( floatTime + runTime );
 
       // run application desciptor end 
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process " << actPtr -> pcbID << ": end processing action \n";
       printAction( actionOutput );      
    }
@@ -724,18 +735,18 @@ void *runner( void* actVoidPtr )
    else if( actPtr->actionType == 'I' )
    {
       // set current time
-      floatTime = ((float)(clock() - timer)/CLOCKS_PER_SEC);
+      floatTime = currentTime();
 
       // input descriptor start
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process " << actPtr -> pcbID << ": start " << actPtr->actionDescriptor << " input \n"; 
       printAction( actionOutput );
 
       // run for specified time
-      while( ((float)(clock()-timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+      waitUntil( floatTime + runTime );
 
       // input desciptor end 
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process " << actPtr -> pcbID << ": end " << actPtr->actionDescriptor << " input \n";
       printAction( actionOutput );
    }
@@ -744,18 +755,18 @@ void *runner( void* actVoidPtr )
    else if( actPtr->actionType == 'O' )
    {
       // set current time
-      floatTime = ((float)(clock() - timer)/CLOCKS_PER_SEC);
+      floatTime = currentTime();
 
       // output descriptor start
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process " << actPtr -> pcbID << ": start " << actPtr->actionDescriptor << " output \n"; 
       printAction( actionOutput );
       
       // run for specified time
-      while( ((float)(clock()-timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+      waitUntil( floatTime + runTime );
 
       // output desciptor end 
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process " << actPtr -> pcbID << ": end " << actPtr->actionDescriptor << " output \n";
       printAction( actionOutput );
    }   
@@ -763,7 +774,7 @@ void *runner( void* actVoidPtr )
    // unrecognized action type
    else 
    {
-      actionOutput << ((float)(clock()-timer)/CLOCKS_PER_SEC);
+      actionOutput << currentTime();
       actionOutput << " - " << "Process " << actPtr -> pcbID << ": unrecognized action \n";
       printAction( actionOutput );
    }   
@@ -803,3 +814,50 @@ void printAction( stringstream& actionOutput )
    actionOutput.clear();
 }
 
+/**
+currentTime
+
+Returns the time since the simulation started. In deterministic mode
+this is the simulated time, so the log is the same on every run.
+
+@pre timer was set
+@post none
+@return float with time in seconds
+*/
+float currentTime()
+{
+   // for simulated time
+   if( deterministic )
+   {
+      return simulatedTime;
+   }
+
+   return ((float)(clock()-timer)/CLOCKS_PER_SEC);
+}
+
+/**
+waitUntil
+
+Waits until the given time. In deterministic mode the simulated time
+is moved forward instead.
+
+@param endTime time (in seconds) to wait until
+@pre timer was set
+@post current time is at or past endTime
+@return void
+*/
+void waitUntil( float endTime )
+{
+   // for simulated time
+   if( deterministic )
+   {
+      if( endTime > simulatedTime )
+      {
+         simulatedTime = endTime;
+      }
+
+      return;
+   }
+
+   while( currentTime() < endTime ); // busy wait
+}
@@ -0,0 +1,182 @@
+/**
+ * @file   Alloc_Bench.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Quantum switch allocation benchmark for Operating System simulator
+ *
+ * Counts the heap allocations made while each preemptive policy switches
+ * between Ready processes, the way the simulator's dispatch loop does.
+ * Built as its own program ("make Alloc_Bench") because it links the
+ * counting operator new of Alloc_Count.cpp, which the simulator does not.
+ *
+ * usage: Alloc_Bench [processes]
+ */
+
+// header files
+   #include "Process_Control_Block.h"
+   #include "Scheduling_Policy.h"
+   #include "Meta_Reader.h"
+   #include "Alloc_Count.h"
+   #include <iostream> // used for I/O
+   #include <list> // used to store processes
+   #include <algorithm> // used for finding min
+   #include <cstdlib> // used for string conversions
+
+   using namespace std;
+
+// global constants
+   const int ALLOC_PROCESSES = 1000;
+   const long ALLOC_PASSES = 100000;
+   const float ALLOC_QUANTUM = 5;
+
+// global variables
+
+// function prototypes
+   void setDefaultSettings( PolicySettings& settings, float quantum );
+   template <class Policy> long countSwitchAllocations( const PolicySettings& settings, int processCount, long passCount );
+
+// main program
+int main( int argc, char* argv[] )
+{
+   // initialize variables
+   PolicySettings settings;
+   long allocations[ POLICY_COUNT ];
+   int processCount = ALLOC_PROCESSES;
+   int policyID;
+
+   // read in arguments
+   if( argc == 2 )
+   {
+      processCount = atoi( argv[ 1 ] );
+   }
+
+   // check for invalid arguments
+   if( argc > 2 || processCount < 1 )
+   {
+      cout << "Incorrect arguments given. Please try again." << endl;
+
+      return 1;
+   }
+
+   setDefaultSettings( settings, ALLOC_QUANTUM );
+
+   allocations[ POLICY_FIFO_P ] = countSwitchAllocations<FifoPreemptivePolicy>( settings, processCount, ALLOC_PASSES );
+   allocations[ POLICY_RR ] = countSwitchAllocations<RoundRobinPolicy>( settings, processCount, ALLOC_PASSES );
+   allocations[ POLICY_SRTF_P ] = countSwitchAllocations<ShortestRemainingPreemptivePolicy>( settings, processCount, ALLOC_PASSES );
+   allocations[ POLICY_MLFQ ] = countSwitchAllocations<FeedbackQueuePolicy>( settings, processCount, ALLOC_PASSES );
+   allocations[ POLICY_CFS ] = countSwitchAllocations<FairSharePolicy>( settings, processCount, ALLOC_PASSES );
+
+   cout.precision( 2 );
+   cout << fixed;
+
+   cout << "policy\tswitches\tallocations\tper switch" << endl;
+
+   for( policyID = 0; policyID < POLICY_COUNT; policyID++ )
+   {
+      if( policyID == POLICY_FIFO_P || policyID == POLICY_RR || policyID == POLICY_SRTF_P ||
+          policyID == POLICY_MLFQ || policyID == POLICY_CFS )
+      {
+         cout << POLICY_NAMES[ policyID ] << "\t" << ALLOC_PASSES << "\t" << allocations[ policyID ] << "\t";
+         cout << (double) allocations[ policyID ] / ALLOC_PASSES << endl;
+      }
+   }
+
+   // fail if a policy moved by handle allocated
+   return allocations[ POLICY_FIFO_P ] == 0 && allocations[ POLICY_RR ] == 0 && allocations[ POLICY_SRTF_P ] == 0 ? 0 : 1;
+}
+
+// function implementation
+
+/**
+setDefaultSettings
+
+Sets the MLFQ and CFS settings a configuration file gets when it gives
+none: MLFQ_DEFAULT_LEVELS levels, each with double the quantum of the one
+above, and a CFS target latency of CFS_LATENCY_QUANTA time quanta with a
+minimum granularity of one.
+
+@param settings settings to set
+@param quantum time quantum (cycles)
+@pre none
+@post every level has a quantum, CFS times are set
+@return void
+*/
+void setDefaultSettings( PolicySettings& settings, float quantum )
+{
+   // initialize variables
+   float levelQuantum = quantum;
+   int level;
+
+   settings.levelCount = MLFQ_DEFAULT_LEVELS;
+
+   for( level = 0; level < settings.levelCount; level++ )
+   {
+      settings.levelQuanta.push_back( levelQuantum );
+      levelQuantum *= 2;
+   }
+
+   settings.targetLatency = quantum * CFS_LATENCY_QUANTA;
+   settings.minGranularity = quantum;
+}
+
+/**
+countSwitchAllocations
+
+Admits Ready processes to a policy and runs quantum switches between
+them, counting the heap allocations made by the switches. One switch of
+each process is run first, so containers have grown to their working
+size before counting starts.
+
+@param settings MLFQ and CFS settings
+@param processCount number of Ready processes
+@param passCount quantum switches to count
+@pre settings were set
+@post none
+@return long with allocations made by the counted switches
+*/
+template <class Policy>
+long countSwitchAllocations( const PolicySettings& settings, int processCount, long passCount )
+{
+   // initialize variables
+   Policy policy( ALLOC_QUANTUM, settings );
+   list<PCB> readyQueue;
+   list<PCB> runningQueue;
+   list<PCB> newProcesses;
+   double eventTime = 0;
+   float runCycles;
+   long startCount = 0;
+   long pass;
+   int index;
+
+   for( index = 1; index <= processCount; index++ )
+   {
+      newProcesses.push_back( PCB( index ) );
+      // enough work that no process completes during the passes
+      newProcesses.back().estimatedRuntime = index + ( processCount + passCount ) * ALLOC_QUANTUM;
+   }
+
+   policy.admit( readyQueue, newProcesses, eventTime );
+
+   for( pass = -processCount; pass < passCount; pass++ )
+   {
+      // start counting after warm up
+      if( pass == 0 )
+      {
+         startCount = allocationCount();
+      }
+
+      // select and dispatch next process
+      runningQueue.splice( runningQueue.begin(), readyQueue, policy.selectNext( readyQueue, eventTime ) );
+      runningQueue.front().dispatch( eventTime );
+
+      // run for its quantum, or what is left of its work (one msec per
+      // cycle), and preempt it
+      runCycles = min( policy.findQuantum( runningQueue.front() ), runningQueue.front().estimatedRuntime );
+      eventTime += runCycles / MSEC_PER_SEC;
+      runningQueue.front().estimatedRuntime -= runCycles;
+      runningQueue.front().preempt( eventTime );
+      policy.onPreempt( readyQueue, runningQueue, true, eventTime );
+   }
+
+   return allocationCount() - startCount;
+}
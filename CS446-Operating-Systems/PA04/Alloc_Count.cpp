@@ -0,0 +1,95 @@
+/**
+ * @file   Alloc_Count.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Heap allocation counter for Operating System simulator
+ *
+ * Replaces the global operator new and delete so every heap allocation
+ * made with new (including those of standard containers and strings) is
+ * counted. Memory still comes from malloc; counting costs one relaxed
+ * atomic add per allocation, so it is linked only into Alloc_Bench (not
+ * the simulator), which uses it to check that moving a process between
+ * queues allocates nothing.
+ */
+
+// header files
+   #include "Alloc_Count.h"
+   #include <new> // used for bad_alloc
+   #include <cstdlib> // used for malloc and free
+   #include <atomic> // used for count shared by threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+   static atomic<long> allocations( 0 ); // allocations made with new
+
+// function implementation
+
+/**
+allocationCount
+
+Returns the number of heap allocations made with new since the program
+started.
+
+@pre none
+@post none
+@return long with number of allocations
+*/
+long allocationCount()
+{
+   return allocations.load( memory_order_relaxed );
+}
+
+/**
+operator new
+
+Counts and makes a heap allocation.
+
+@param size bytes to allocate
+@pre none
+@post allocation was counted
+@return void pointer to allocated memory (throws bad_alloc on failure)
+*/
+void* operator new( size_t size )
+{
+   // initialize variables
+   void* memory;
+
+   allocations.fetch_add( 1, memory_order_relaxed );
+
+   memory = malloc( size > 0 ? size : 1 );
+
+   if( memory == NULL )
+   {
+      throw bad_alloc();
+   }
+
+   return memory;
+}
+
+void* operator new[]( size_t size )
+{
+   return operator new( size );
+}
+
+/**
+operator delete
+
+Frees memory allocated by operator new.
+
+@param memory memory to free (may be NULL)
+@pre memory was allocated by operator new
+@post memory was freed
+@return void
+*/
+void operator delete( void* memory ) noexcept
+{
+   free( memory );
+}
+
+void operator delete[]( void* memory ) noexcept
+{
+   free( memory );
+}
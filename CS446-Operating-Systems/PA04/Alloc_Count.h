@@ -0,0 +1,21 @@
+/**
+ * @file   Alloc_Count.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Heap allocation counter header for Operating System simulator
+ */
+
+// definition
+   #ifndef __ALLOCCOUNT_H_
+   #define __ALLOCCOUNT_H_
+
+// header files
+
+// global constants
+
+// global variables
+
+// function prototypes
+   long allocationCount();
+
+#endif
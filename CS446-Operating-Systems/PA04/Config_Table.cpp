@@ -0,0 +1,660 @@
+/**
+ * @file   Config_Table.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Configuration table for Operating System simulator
+ *
+ * Each setting of the configuration file is a field with a key, a type,
+ * the range or names it allows, and the variable its value is saved to.
+ * Lines are found by key in a hash table, so settings can be given in any
+ * order, and each value is checked against its field before it is saved.
+ * Fields marked reloadable can be read again from a changed file while the
+ * simulator runs; the others keep the values read at start.
+ */
+
+// header files
+   #include "Config_Table.h"
+   #include <string> // used for string operations
+   #include <vector> // used to store fields
+   #include <unordered_map> // used to find fields by key
+   #include <istream> // used to read configuration
+   #include <sstream> // used for string streams
+   #include <cstdlib> // used for number conversions
+   #include <climits> // used for whole number limit
+
+   using namespace std;
+
+// global constants
+   const int INT_DIGITS = 10; // digits of the largest int
+
+// global variables
+
+// class implementation
+ConfigTable::ConfigTable()
+{
+}
+
+/**
+clear
+
+Removes every field and error.
+
+@pre none
+@post table is empty
+@return void
+*/
+void ConfigTable::clear()
+{
+   fields.clear();
+   fieldIndex.clear();
+   error.clear();
+}
+
+/**
+addText
+
+Adds a field whose value is the rest of its line.
+
+@param key text before ':'
+@param target string to save value to
+@param required true if line must be given
+@pre key was not added before
+@post field was added
+@return void
+*/
+void ConfigTable::addText( const string& key, string* target, bool required )
+{
+   addField( key, FIELD_TEXT, target, required );
+}
+
+/**
+addInt
+
+Adds a field whose value is a whole number in a range.
+
+@param key text before ':'
+@param target int to save value to
+@param minimum lowest value allowed
+@param maximum highest value allowed
+@param required true if line must be given
+@pre key was not added before
+@post field was added
+@return void
+*/
+void ConfigTable::addInt( const string& key, int* target, int minimum, int maximum, bool required )
+{
+   // initialize variables
+   ConfigField* field = addField( key, FIELD_INT, target, required );
+
+   field->minimum = minimum;
+   field->maximum = maximum;
+}
+
+/**
+addFloat
+
+Adds a field whose value is a number no lower than (or, if aboveMinimum,
+greater than) a minimum.
+
+@param key text before ':'
+@param target float to save value to
+@param minimum lowest value allowed
+@param aboveMinimum true if value must be greater than minimum
+@param required true if line must be given
+@param reloadable true if reload may change value
+@pre key was not added before
+@post field was added
+@return void
+*/
+void ConfigTable::addFloat( const string& key, float* target, float minimum, bool aboveMinimum, bool required, bool reloadable )
+{
+   // initialize variables
+   ConfigField* field = addField( key, FIELD_FLOAT, target, required );
+
+   field->minimum = minimum;
+   field->aboveMinimum = aboveMinimum;
+   field->reloadable = reloadable;
+}
+
+/**
+addList
+
+Adds an optional field whose value is a list of numbers separated by
+spaces, each no lower than (or, if aboveMinimum, greater than) a minimum.
+
+@param key text before ':'
+@param target vector to save numbers to
+@param minimum lowest value allowed
+@param aboveMinimum true if each value must be greater than minimum
+@pre key was not added before
+@post field was added
+@return void
+*/
+void ConfigTable::addList( const string& key, vector<float>* target, float minimum, bool aboveMinimum )
+{
+   // initialize variables
+   ConfigField* field = addField( key, FIELD_LIST, target, false );
+
+   field->minimum = minimum;
+   field->aboveMinimum = aboveMinimum;
+}
+
+/**
+addChoice
+
+Adds a field whose value is one of a list of names. The index of the
+name is saved.
+
+@param key text before ':'
+@param target int to save index of name to
+@param choices names allowed
+@param choiceCount number of names allowed
+@param required true if line must be given
+@pre key was not added before
+@post field was added
+@return void
+*/
+void ConfigTable::addChoice( const string& key, int* target, const char* const* choices, int choiceCount, bool required )
+{
+   // initialize variables
+   ConfigField* field = addField( key, FIELD_CHOICE, target, required );
+
+   field->choices = choices;
+   field->choiceCount = choiceCount;
+}
+
+/**
+read
+
+Reads every line of a configuration and saves the value of each field
+given. Fields not given keep their values.
+
+@param configFile stream positioned at start of configuration
+@pre fields were added
+@post values were saved, or error was saved
+@return bool representing configuration was valid
+*/
+bool ConfigTable::read( istream& configFile )
+{
+   // initialize variables
+   vector<string> values;
+   unsigned int index;
+
+   if( !readLines( configFile, values ) )
+   {
+      return false;
+   }
+
+   for( index = 0; index < fields.size(); index++ )
+   {
+      // check for missing line
+      if( fields[ index ].line == 0 )
+      {
+         if( fields[ index ].required )
+         {
+            return reject( fields[ index ].key, "is missing" );
+         }
+
+         continue;
+      }
+
+      if( !parseValue( fields[ index ], values[ index ], fields[ index ].target ) )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+reload
+
+Reads a changed configuration and saves the values of reloadable fields
+only. Every required reloadable field must be given, and every value
+given must be valid, or none are saved. An optional reloadable field
+left out keeps its current value.
+
+@param configFile stream positioned at start of configuration
+@pre read was called
+@post reloadable values were saved, or error was saved
+@return bool representing configuration was valid
+*/
+bool ConfigTable::reload( istream& configFile )
+{
+   // initialize variables
+   vector<string> values;
+   vector<float> newValues( fields.size(), 0 );
+   unsigned int index;
+
+   if( !readLines( configFile, values ) )
+   {
+      return false;
+   }
+
+   // check every value before saving any
+   for( index = 0; index < fields.size(); index++ )
+   {
+      if( !fields[ index ].reloadable )
+      {
+         continue;
+      }
+
+      // keep current value of optional field left out
+      if( fields[ index ].line == 0 && !fields[ index ].required )
+      {
+         newValues[ index ] = *static_cast<float*>( fields[ index ].target );
+
+         continue;
+      }
+
+      if( fields[ index ].line == 0 )
+      {
+         return reject( fields[ index ].key, "is missing" );
+      }
+
+      if( !parseValue( fields[ index ], values[ index ], &( newValues[ index ] ) ) )
+      {
+         return false;
+      }
+   }
+
+   for( index = 0; index < fields.size(); index++ )
+   {
+      if( fields[ index ].reloadable )
+      {
+         *static_cast<float*>( fields[ index ].target ) = newValues[ index ];
+      }
+   }
+
+   return true;
+}
+
+/**
+hasField
+
+Returns true if a field was added for the key.
+
+@param key text before ':'
+@pre none
+@post none
+@return bool representing key is a setting
+*/
+bool ConfigTable::hasField( const string& key )
+{
+   return fieldIndex.find( key ) != fieldIndex.end();
+}
+
+/**
+isGiven
+
+Returns true if the line of a field was in the configuration read.
+
+@param key text before ':'
+@pre read was called
+@post none
+@return bool representing line was given
+*/
+bool ConfigTable::isGiven( const string& key )
+{
+   // initialize variables
+   unordered_map<string, int>::iterator entry = fieldIndex.find( key );
+
+   return entry != fieldIndex.end() && fields[ entry->second ].line > 0;
+}
+
+/**
+reject
+
+Saves an error about a field, with the line it was read from. Used for
+values that are invalid together with other fields.
+
+@param key text before ':'
+@param reason what is wrong, e.g. "is missing"
+@pre none
+@post error was saved
+@return bool with false (invalid configuration)
+*/
+bool ConfigTable::reject( const string& key, const string& reason )
+{
+   // initialize variables
+   unordered_map<string, int>::iterator entry = fieldIndex.find( key );
+   stringstream message;
+
+   message << key << " " << reason;
+
+   if( entry != fieldIndex.end() && fields[ entry->second ].line > 0 )
+   {
+      message << " (line " << fields[ entry->second ].line << ")";
+   }
+
+   error = message.str();
+
+   return false;
+}
+
+/**
+errorMessage
+
+Returns the first error found by read, reload or reject.
+
+@pre none
+@post none
+@return const string& with error (empty if none)
+*/
+const string& ConfigTable::errorMessage()
+{
+   return error;
+}
+
+/**
+addField
+
+Adds a field with no range, choices or reload.
+
+@param key text before ':'
+@param type FieldType of value
+@param target variable to save value to
+@param required true if line must be given
+@pre key was not added before
+@post field was added
+@return ConfigField* pointer to new field (valid until next field is added)
+*/
+ConfigField* ConfigTable::addField( const string& key, int type, void* target, bool required )
+{
+   // initialize variables
+   ConfigField newField;
+
+   newField.key = key;
+   newField.type = type;
+   newField.target = target;
+   newField.minimum = -NO_MAXIMUM;
+   newField.maximum = NO_MAXIMUM;
+   newField.aboveMinimum = false;
+   newField.choices = NULL;
+   newField.choiceCount = 0;
+   newField.required = required;
+   newField.reloadable = false;
+   newField.line = 0;
+
+   fieldIndex[ key ] = fields.size();
+   fields.push_back( newField );
+
+   return &( fields.back() );
+}
+
+/**
+readLines
+
+Reads the lines between the start and end lines of a configuration, and
+finds the value text of each field. Blank lines are skipped.
+
+@param configFile stream positioned at start of configuration
+@param values vector to save value text of each field to (by field index)
+@pre fields were added
+@post line of each field given was saved, or error was saved
+@return bool representing every line was recognized
+*/
+bool ConfigTable::readLines( istream& configFile, vector<string>& values )
+{
+   // initialize variables
+   unordered_map<string, int>::iterator entry;
+   stringstream message;
+   string tempLine;
+   string key;
+   int lineNumber = 0;
+   bool started = false;
+   size_t colon;
+   unsigned int index;
+
+   values.assign( fields.size(), string() );
+   error.clear();
+
+   for( index = 0; index < fields.size(); index++ )
+   {
+      fields[ index ].line = 0;
+   }
+
+   while( getline( configFile, tempLine ) )
+   {
+      lineNumber++;
+      tempLine = trimText( tempLine );
+
+      // skip blank lines
+      if( tempLine.empty() )
+      {
+         continue;
+      }
+
+      // check for start line
+      if( !started )
+      {
+         if( tempLine.find( "Start Simulator" ) != 0 )
+         {
+            error = "Start Simulator Configuration File line is missing";
+            return false;
+         }
+
+         started = true;
+         continue;
+      }
+
+      // check for end line
+      if( tempLine.find( "End Simulator" ) == 0 )
+      {
+         return true;
+      }
+
+      // find field of key
+      colon = tempLine.find( ':' );
+      key = trimText( tempLine.substr( 0, colon ) );
+      entry = fieldIndex.find( key );
+
+      if( colon == string::npos || entry == fieldIndex.end() )
+      {
+         message << "Unrecognized setting \"" << key << "\" (line " << lineNumber << ")";
+         error = message.str();
+         return false;
+      }
+
+      // check for line given twice
+      if( fields[ entry->second ].line > 0 )
+      {
+         message << key << " is given twice (lines " << fields[ entry->second ].line << " and " << lineNumber << ")";
+         error = message.str();
+         return false;
+      }
+
+      fields[ entry->second ].line = lineNumber;
+      values[ entry->second ] = trimText( tempLine.substr( colon + 1 ) );
+   }
+
+   error = started ? "End Simulator Configuration File line is missing" : "Configuration is empty";
+
+   return false;
+}
+
+/**
+parseValue
+
+Converts the value text of a field to its type, checks it, and saves it.
+
+@param field field of value
+@param text value text (without surrounding spaces)
+@param target variable to save value to (type given by field)
+@pre none
+@post value was saved, or error was saved
+@return bool representing value was valid
+*/
+bool ConfigTable::parseValue( ConfigField& field, const string& text, void* target )
+{
+   // initialize variables
+   stringstream message;
+   stringstream numberList( text );
+   vector<float> numbers;
+   string tempNumber;
+   char* numberEnd;
+   double value;
+   int index;
+
+   // check for empty value
+   if( text.empty() )
+   {
+      return reject( field.key, "is empty" );
+   }
+
+   switch( field.type )
+   {
+      case FIELD_TEXT:
+         *static_cast<string*>( target ) = text;
+         break;
+
+      case FIELD_INT:
+         value = strtol( text.c_str(), &numberEnd, 10 );
+
+         if( *numberEnd != '\0' )
+         {
+            return reject( field.key, "must be a whole number" );
+         }
+
+         if( !checkRange( field, value ) )
+         {
+            return false;
+         }
+
+         *static_cast<int*>( target ) = (int) value;
+         break;
+
+      case FIELD_FLOAT:
+         value = strtod( text.c_str(), &numberEnd );
+
+         if( *numberEnd != '\0' )
+         {
+            return reject( field.key, "must be a number" );
+         }
+
+         if( !checkRange( field, value ) )
+         {
+            return false;
+         }
+
+         *static_cast<float*>( target ) = (float) value;
+         break;
+
+      case FIELD_LIST:
+         while( numberList >> tempNumber )
+         {
+            value = strtod( tempNumber.c_str(), &numberEnd );
+
+            if( *numberEnd != '\0' )
+            {
+               return reject( field.key, "must be numbers separated by spaces" );
+            }
+
+            if( !checkRange( field, value ) )
+            {
+               return false;
+            }
+
+            numbers.push_back( (float) value );
+         }
+
+         *static_cast< vector<float>* >( target ) = numbers;
+         break;
+
+      case FIELD_CHOICE:
+         for( index = 0; index < field.choiceCount; index++ )
+         {
+            if( text == field.choices[ index ] )
+            {
+               *static_cast<int*>( target ) = index;
+               return true;
+            }
+         }
+
+         // list names allowed
+         message << "must be ";
+
+         for( index = 0; index < field.choiceCount; index++ )
+         {
+            message << ( index == 0 ? "" : ( index == field.choiceCount - 1 ? " or " : ", " ) ) << field.choices[ index ];
+         }
+
+         return reject( field.key, message.str() );
+   }
+
+   return true;
+}
+
+/**
+checkRange
+
+Checks a number is in the range allowed by its field.
+
+@param field field of value
+@param value number read
+@pre none
+@post error was saved if number is out of range
+@return bool representing number is in range
+*/
+bool ConfigTable::checkRange( ConfigField& field, double value )
+{
+   // initialize variables
+   stringstream message;
+   bool hasMaximum = field.maximum < NO_MAXIMUM;
+
+   // check for number in range
+   if( ( field.aboveMinimum ? value > field.minimum : value >= field.minimum ) && value <= field.maximum )
+   {
+      return true;
+   }
+
+   // show whole numbers in full, and INT_MAX as no upper limit
+   // (unless the number is above it)
+   if( field.type == FIELD_INT )
+   {
+      message.precision( INT_DIGITS );
+      hasMaximum = field.maximum < INT_MAX || value > field.maximum;
+   }
+
+   // describe range
+   if( hasMaximum )
+   {
+      message << "must be from " << field.minimum << " to " << field.maximum;
+   }
+   else if( field.aboveMinimum )
+   {
+      message << "must be greater than " << field.minimum;
+   }
+   else
+   {
+      message << "must be at least " << field.minimum;
+   }
+
+   return reject( field.key, message.str() );
+}
+
+// function implementation
+
+/**
+trimText
+
+Returns text without leading and trailing spaces, tabs and line ends.
+
+@param text text to trim
+@pre none
+@post none
+@return string with trimmed text
+*/
+string trimText( const string& text )
+{
+   // initialize variables
+   size_t first = text.find_first_not_of( " \t\r\n" );
+
+   if( first == string::npos )
+   {
+      return string();
+   }
+
+   return text.substr( first, text.find_last_not_of( " \t\r\n" ) - first + 1 );
+}
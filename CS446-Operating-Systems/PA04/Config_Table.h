@@ -0,0 +1,89 @@
+/**
+ * @file   Config_Table.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Configuration table header for Operating System simulator
+ */
+
+// definition
+   #ifndef __CONFIGTABLE_H_
+   #define __CONFIGTABLE_H_
+
+// header files
+   #include <string> // used for string operations
+   #include <vector> // used to store fields
+   #include <unordered_map> // used to find fields by key
+   #include <istream> // used to read configuration
+
+   using namespace std;
+
+// global constants
+
+   // types of configuration values, indexed by FieldType
+   enum FieldType
+   {
+      FIELD_TEXT, // rest of line (string)
+      FIELD_INT, // whole number (int)
+      FIELD_FLOAT, // number (float)
+      FIELD_LIST, // numbers separated by spaces (vector<float>)
+      FIELD_CHOICE, // one of a list of names (int index of name)
+      FIELD_TYPE_COUNT
+   };
+
+   const double NO_MAXIMUM = 1e30; // numeric field without an upper limit
+
+// global variables
+
+// function prototypes
+   string trimText( const string& text );
+
+// class declaration
+
+// one "Key: value" line of the configuration file, and where its value is saved
+class ConfigField
+{
+   public:
+      string key; // text before ':'
+      int type; // FieldType
+      void* target; // value to save to (type given by FieldType)
+      double minimum; // lowest value allowed (numbers)
+      double maximum; // highest value allowed (numbers)
+      bool aboveMinimum; // true if value must be greater than minimum
+      const char* const* choices; // names allowed (FIELD_CHOICE)
+      int choiceCount; // number of names allowed
+      bool required; // true if line must be given
+      bool reloadable; // true if reload may change value
+      int line; // line value was read from (0 if not given)
+};
+
+// reads a configuration file of "Key: value" lines, between its start and
+// end lines, into typed fields. Lines may be in any order. Fields that are
+// not given keep the value they had, so their default is whatever the owner
+// set before reading. The first error found is saved with its line number.
+class ConfigTable
+{
+   public:
+      ConfigTable();
+      void clear();
+      void addText( const string& key, string* target, bool required );
+      void addInt( const string& key, int* target, int minimum, int maximum, bool required );
+      void addFloat( const string& key, float* target, float minimum, bool aboveMinimum, bool required, bool reloadable );
+      void addList( const string& key, vector<float>* target, float minimum, bool aboveMinimum );
+      void addChoice( const string& key, int* target, const char* const* choices, int choiceCount, bool required );
+      bool read( istream& configFile );
+      bool reload( istream& configFile );
+      bool hasField( const string& key );
+      bool isGiven( const string& key );
+      bool reject( const string& key, const string& reason );
+      const string& errorMessage();
+   private:
+      ConfigField* addField( const string& key, int type, void* target, bool required );
+      bool readLines( istream& configFile, vector<string>& values );
+      bool parseValue( ConfigField& field, const string& text, void* target );
+      bool checkRange( ConfigField& field, double value );
+      vector<ConfigField> fields; // fields, in order added
+      unordered_map<string, int> fieldIndex; // index of field of each key
+      string error; // first error found (empty if none)
+};
+
+#endif
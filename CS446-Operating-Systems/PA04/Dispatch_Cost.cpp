@@ -0,0 +1,128 @@
+/**
+ * @file   Dispatch_Cost.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Dispatcher overhead for Operating System simulator
+ *
+ * Finds the time each dispatch costs a processor before the process can
+ * run, so short time quanta pay for the switches they cause. Costs are
+ * set in the configuration file (all zero by default, when dispatching
+ * is free) and may change on reload; totals are kept in nanoseconds.
+ */
+
+// header files
+   #include "Dispatch_Cost.h"
+   #include "Process_Control_Block.h"
+   #include "Sim_Clock.h"
+   #include <vector> // used to store last process of each processor
+   #include <stdint.h> // used for nanosecond times
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class implementation
+DispatchCost::DispatchCost()
+{
+   dispatchTime = 0;
+   switchTime = 0;
+   migrationPenalty = 0;
+   pthread_mutex_init( &lock, NULL );
+   configure( 1 );
+}
+
+DispatchCost::~DispatchCost()
+{
+   pthread_mutex_destroy( &lock );
+}
+
+/**
+configure
+
+Sets the number of processors and clears the totals. No processor has
+run a process yet.
+
+@param processors number of simulated processors
+@pre processors is positive, no process is running
+@post totals are cleared
+@return void
+*/
+void DispatchCost::configure( int processors )
+{
+   lastProcess.assign( processors, NO_PROCESS );
+
+   // clear statistics
+   dispatchCount = 0;
+   switchCount = 0;
+   migrationCount = 0;
+   dispatchNanos = 0;
+   switchNanos = 0;
+   migrationNanos = 0;
+}
+
+/**
+charge
+
+Finds the cost of dispatching a process on a processor and adds it to
+the totals. The processor is then counted as running the process.
+
+@param processor processor dispatching (from 0)
+@param process process being dispatched (not yet marked dispatched)
+@pre configure was called with more than processor processors
+@post dispatch was counted
+@return int64_t with time the processor spends before the process runs (nsec)
+*/
+int64_t DispatchCost::charge( int processor, const PCB& process )
+{
+   // initialize variables
+   int64_t cost;
+   int64_t partCost;
+
+   pthread_mutex_lock( &lock );
+
+   // every dispatch
+   cost = SimClock::fromMsec( dispatchTime );
+   dispatchCount++;
+   dispatchNanos += cost;
+
+   // switch from another process (or from idle)
+   if( lastProcess[ processor ] != process.processID )
+   {
+      partCost = SimClock::fromMsec( switchTime );
+      switchCount++;
+      switchNanos += partCost;
+      cost += partCost;
+
+      lastProcess[ processor ] = process.processID;
+   }
+
+   // move from the processor process last ran on
+   if( process.dispatchCount > 0 && process.lastProcessor != processor )
+   {
+      partCost = SimClock::fromMsec( migrationPenalty );
+      migrationCount++;
+      migrationNanos += partCost;
+      cost += partCost;
+   }
+
+   pthread_mutex_unlock( &lock );
+
+   return cost;
+}
+
+/**
+totalNanos
+
+Returns the total time lost to dispatching.
+
+@pre none
+@post none
+@return int64_t with time lost (nsec)
+*/
+int64_t DispatchCost::totalNanos()
+{
+   return dispatchNanos + switchNanos + migrationNanos;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file   Dispatch_Cost.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Dispatcher overhead header for Operating System simulator
+ */
+
+// definition
+   #ifndef __DISPATCHCOST_H_
+   #define __DISPATCHCOST_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include <vector> // used to store last process of each processor
+   #include <stdint.h> // used for nanosecond times
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+   const int NO_PROCESS = 0; // processor has not run a process yet
+
+// global variables
+
+// class declaration
+
+// time a processor spends dispatching processes instead of running them.
+// Each dispatch costs the dispatch time (the scheduler choosing and
+// starting a process). A dispatch of a process other than the one the
+// processor ran last also costs the context switch time (saving one
+// process and restoring the other), and a dispatch of a process on a
+// processor other than the one it last ran on also costs the migration
+// penalty (its cache is cold there). Time lost to each is totaled.
+class DispatchCost
+{
+   public:
+      DispatchCost();
+      ~DispatchCost();
+      void configure( int processors );
+      int64_t charge( int processor, const PCB& process );
+      int64_t totalNanos();
+      float dispatchTime; // time of each dispatch (msec)
+      float switchTime; // time of each context switch (msec)
+      float migrationPenalty; // time of each migration (msec)
+      long dispatchCount; // dispatches charged
+      long switchCount; // dispatches of a process other than the last one run
+      long migrationCount; // dispatches on a processor other than the last one used
+      int64_t dispatchNanos; // time lost to dispatches (nsec)
+      int64_t switchNanos; // time lost to context switches (nsec)
+      int64_t migrationNanos; // time lost to migrations (nsec)
+   private:
+      vector<int> lastProcess; // process each processor ran last (NO_PROCESS if none)
+      pthread_mutex_t lock; // guards totals when processors dispatch at once
+};
+
+#endif
@@ -0,0 +1,437 @@
+/**
+ * @file   IO_Device.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  I/O device for Operating System simulator
+ *
+ * Each I/O device has its own worker thread and FIFO request queue, so
+ * blocked processes wait on their device while the processor keeps
+ * running other processes. Completed requests are posted to the
+ * interrupt queue, which the scheduler checks at the end of each cycle.
+ */
+
+// header files
+   #include "IO_Device.h"
+   #include "OS_Control_Block.h"
+   #include "Process_Control_Block.h"
+   #include "Sim_Clock.h"
+   #include <string> // used for string operations
+   #include <list> // used to store processes
+   #include <queue> // used to store device requests
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class implementation
+IODevice::IODevice()
+{
+   simulatorPtr = NULL;
+   busyTime = 0;
+   requestCount = 0;
+   logProducer = 0;
+   running = false;
+   idle = false;
+   wakeTicket = NO_TICKET;
+   stopping = false;
+   pthread_mutex_init( &lock, NULL );
+   pthread_cond_init( &requestReady, NULL );
+}
+
+IODevice::~IODevice()
+{
+   stop();
+   pthread_mutex_destroy( &lock );
+   pthread_cond_destroy( &requestReady );
+}
+
+/**
+start
+
+Names the device and creates its worker thread. The worker thread is
+passed a pointer to this device.
+
+@param name name of device
+@param owner simulator that owns device
+@param runner function run by worker thread
+@pre device is not running
+@post worker thread is waiting for requests
+@return void
+*/
+void IODevice::start( string name, OSCB* owner, void *(*runner)( void* ) )
+{
+   // check for running device
+   if( running )
+   {
+      return;
+   }
+
+   deviceName = name;
+   simulatorPtr = owner;
+   busyTime = 0;
+   requestCount = 0;
+   stopping = false;
+
+   // worker starts idle (not counted as active by the clock, holds back
+   // no log lines)
+   idle = true;
+   logProducer = simulatorPtr->logWriter.addProducer();
+
+   pthread_create( &tid, NULL, runner, this );
+   running = true;
+}
+
+/**
+request
+
+Queues a request for the device and wakes the worker thread if idle.
+
+@param newRequest request to queue
+@pre device was started
+@post request was queued
+@return void
+*/
+void IODevice::request( const IORequest& newRequest )
+{
+   pthread_mutex_lock( &lock );
+
+   requests.push( newRequest );
+
+   // wake idle worker
+   if( idle )
+   {
+      idle = false;
+      wakeTicket = simulatorPtr->simClock.actorWake();
+      simulatorPtr->logWriter.wake( logProducer );
+      pthread_cond_signal( &requestReady );
+   }
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+nextRequest
+
+Called by the worker thread to take the next request, waiting while
+the queue is empty. Returns false once the device is stopped. A worker
+woken with a request waits for its turn on the clock before taking it.
+
+@param currentRequest reference to save next request to
+@pre called from worker thread
+@post next request removed from queue, if any
+@return bool representing request was taken
+*/
+bool IODevice::nextRequest( IORequest& currentRequest )
+{
+   // initialize variables
+   bool woken = false;
+
+   pthread_mutex_lock( &lock );
+
+   // wait for request
+   while( requests.empty() && !stopping )
+   {
+      // mark worker idle
+      if( !idle )
+      {
+         idle = true;
+         simulatorPtr->simClock.actorIdle();
+         simulatorPtr->logWriter.idle();
+      }
+
+      pthread_cond_wait( &requestReady, &lock );
+      woken = true;
+   }
+
+   // check for stop
+   if( requests.empty() )
+   {
+      pthread_mutex_unlock( &lock );
+
+      // worker posts no more lines
+      simulatorPtr->logWriter.idle();
+
+      return false;
+   }
+
+   // take next request
+   currentRequest = requests.front();
+   requests.pop();
+
+   pthread_mutex_unlock( &lock );
+
+   // wait for turn given when woken (request() holds the turn until it ends)
+   if( woken )
+   {
+      simulatorPtr->simClock.awaitTurn( wakeTicket );
+   }
+
+   return true;
+}
+
+/**
+stop
+
+Ends and joins the worker thread once its queue is empty.
+
+@pre none
+@post worker thread is not running
+@return void
+*/
+void IODevice::stop()
+{
+   // check for stopped device
+   if( !running )
+   {
+      return;
+   }
+
+   pthread_mutex_lock( &lock );
+   stopping = true;
+   pthread_cond_signal( &requestReady );
+   pthread_mutex_unlock( &lock );
+
+   pthread_join( tid, NULL );
+   running = false;
+}
+
+InterruptQueue::InterruptQueue()
+{
+   simClockPtr = NULL;
+   logWriterPtr = NULL;
+   changeCount = 0;
+   waitingCount = 0;
+   wakeTicket = NO_TICKET;
+   pthread_mutex_init( &lock, NULL );
+   pthread_cond_init( &interruptReady, NULL );
+}
+
+InterruptQueue::~InterruptQueue()
+{
+   pthread_mutex_destroy( &lock );
+   pthread_cond_destroy( &interruptReady );
+}
+
+/**
+setClock
+
+Sets clock used to mark processors idle while they wait for interrupts.
+
+@param clockPtr pointer to simulator clock
+@pre none
+@post clock was saved
+@return void
+*/
+void InterruptQueue::setClock( SimClock* clockPtr )
+{
+   simClockPtr = clockPtr;
+}
+
+/**
+setLog
+
+Sets log writer used to mark processors idle while they wait for
+interrupts, so their log producers hold back no lines.
+
+@param logPtr pointer to simulator log writer
+@pre none
+@post log writer was saved
+@return void
+*/
+void InterruptQueue::setLog( LogWriter* logPtr )
+{
+   logWriterPtr = logPtr;
+}
+
+/**
+post
+
+Posts an I/O completion interrupt for a blocked process, waking any
+waiting processors.
+
+@param process blocked process whose I/O has completed
+@pre clock was set
+@post interrupt was queued
+@return void
+*/
+void InterruptQueue::post( list<PCB>::iterator process )
+{
+   pthread_mutex_lock( &lock );
+
+   interrupts.push_back( process );
+   wakeWaiters();
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+notify
+
+Wakes any waiting processors without posting an interrupt. Used when a
+process is made ready by another processor.
+
+@pre clock was set
+@post waiting processors were woken
+@return void
+*/
+void InterruptQueue::notify()
+{
+   pthread_mutex_lock( &lock );
+
+   wakeWaiters();
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+generation
+
+Returns the number of interrupts and notifications so far. A processor
+reads this before deciding to wait, then passes it to wait(), so it
+cannot miss a change made in between.
+
+@pre none
+@post none
+@return int with current generation
+*/
+int InterruptQueue::generation()
+{
+   // initialize variables
+   int currentGeneration;
+
+   pthread_mutex_lock( &lock );
+   currentGeneration = changeCount;
+   pthread_mutex_unlock( &lock );
+
+   return currentGeneration;
+}
+
+/**
+wait
+
+Waits until an interrupt or notification happens after the given generation.
+
+@param lastGeneration generation read before deciding to wait
+@pre clock was set
+@post generation has changed
+@return void
+*/
+void InterruptQueue::wait( int lastGeneration )
+{
+   pthread_mutex_lock( &lock );
+
+   waitForChange( lastGeneration );
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+collect
+
+Moves every posted interrupt to the given list, in order of completion.
+If asked, waits until at least one interrupt has been posted.
+
+@param completed list to add processes with completed I/O to
+@param waitForOne true to wait for an interrupt if none are posted
+@pre clock was set
+@post posted interrupts were moved to completed
+@return void
+*/
+void InterruptQueue::collect( list< list<PCB>::iterator >& completed, bool waitForOne )
+{
+   pthread_mutex_lock( &lock );
+
+   // wait for interrupt
+   while( waitForOne && interrupts.empty() )
+   {
+      waitForChange( changeCount );
+   }
+
+   completed.splice( completed.end(), interrupts );
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+wakeWaiters
+
+Moves to the next generation and wakes every waiting processor. Each
+one is marked active on the clock and in the log before it is woken.
+
+@pre lock is held
+@post no processor is waiting
+@return void
+*/
+void InterruptQueue::wakeWaiters()
+{
+   // initialize variables
+   unsigned int index;
+
+   changeCount++;
+
+   // check for waiting processors
+   if( waitingCount == 0 )
+   {
+      return;
+   }
+
+   // mark each waiting processor active
+   while( waitingCount > 0 )
+   {
+      wakeTicket = simClockPtr->actorWake();
+      waitingCount--;
+   }
+
+   for( index = 0; index < waitingProducers.size(); index++ )
+   {
+      logWriterPtr->wake( waitingProducers[ index ] );
+   }
+
+   waitingProducers.clear();
+
+   pthread_cond_broadcast( &interruptReady );
+}
+
+/**
+waitForChange
+
+Waits until the generation moves past the given one. The waiting
+processor is marked idle on the clock and in the log until it is woken,
+then waits for its turn on the clock.
+
+@param lastGeneration generation to wait past
+@pre lock is held
+@post generation has changed
+@return void
+*/
+void InterruptQueue::waitForChange( int lastGeneration )
+{
+   // initialize variables
+   int64_t ticket;
+
+   // check for change already made
+   if( changeCount != lastGeneration )
+   {
+      return;
+   }
+
+   // mark processor idle
+   waitingCount++;
+   simClockPtr->actorIdle();
+   waitingProducers.push_back( logWriterPtr->producer() );
+   logWriterPtr->idle();
+
+   while( changeCount == lastGeneration )
+   {
+      pthread_cond_wait( &interruptReady, &lock );
+   }
+
+   // wait for turn without holding lock (waker may still need it)
+   ticket = wakeTicket;
+   pthread_mutex_unlock( &lock );
+   simClockPtr->awaitTurn( ticket );
+   pthread_mutex_lock( &lock );
+}
@@ -0,0 +1,89 @@
+/**
+ * @file   IO_Device.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  I/O device header for Operating System simulator
+ */
+
+// definition
+   #ifndef __IODEVICE_H_
+   #define __IODEVICE_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include "Sim_Clock.h"
+   #include "Log_Writer.h"
+   #include <string> // used for string operations
+   #include <list> // used to store processes
+   #include <queue> // used to store device requests
+   #include <vector> // used to store waiting log producers
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class declaration
+class OSCB;
+
+class IORequest
+{
+   public:
+      list<PCB>::iterator process; // blocked process waiting on request
+      int64_t runTime; // time to complete request (nsec)
+};
+
+class IODevice
+{
+   public:
+      IODevice();
+      ~IODevice();
+      void start( string name, OSCB* owner, void *(*runner)( void* ) );
+      void request( const IORequest& newRequest );
+      bool nextRequest( IORequest& currentRequest );
+      void stop();
+      string deviceName; // name of device (matches cycle data)
+      OSCB* simulatorPtr; // simulator that owns device
+      double busyTime; // total time spent on requests (seconds)
+      int requestCount; // number of completed requests
+      int logProducer; // log producer of worker thread
+   private:
+      queue<IORequest> requests; // requests waiting for device
+      bool running; // true while worker thread exists
+      bool idle; // true while worker thread waits for requests
+      int64_t wakeTicket; // clock turn of worker thread once woken
+      bool stopping; // true when worker thread should exit
+      pthread_t tid; // device worker thread
+      pthread_mutex_t lock; // guards request queue
+      pthread_cond_t requestReady; // signaled when request is queued
+};
+
+class InterruptQueue
+{
+   public:
+      InterruptQueue();
+      ~InterruptQueue();
+      void setClock( SimClock* clockPtr );
+      void setLog( LogWriter* logPtr );
+      void post( list<PCB>::iterator process );
+      void notify();
+      int generation();
+      void wait( int lastGeneration );
+      void collect( list< list<PCB>::iterator >& completed, bool waitForOne );
+   private:
+      void wakeWaiters();
+      void waitForChange( int lastGeneration );
+      SimClock* simClockPtr; // clock used to mark waiting processors idle
+      LogWriter* logWriterPtr; // log writer used to mark waiting processors idle
+      vector<int> waitingProducers; // log producers of waiting processors
+      list< list<PCB>::iterator > interrupts; // processes with completed I/O
+      int changeCount; // increases on each interrupt or notify
+      int waitingCount; // processors waiting for a change
+      int64_t wakeTicket; // clock turn of last processor woken
+      pthread_mutex_t lock; // guards interrupt list
+      pthread_cond_t interruptReady; // signaled when interrupt is posted
+};
+
+#endif
@@ -0,0 +1,689 @@
+/**
+ * @file   Log_Writer.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Asynchronous log writer for Operating System simulator
+ *
+ * Simulator threads post log lines into a fixed-size ring buffer without
+ * taking a lock: each line takes a ticket (one per slot it needs) and
+ * fills its slots in ticket order. A writer thread drains the ring in
+ * batches and writes them with one large write() per output. The writer
+ * is only woken once a full batch is waiting, and otherwise flushes every
+ * LOG_FLUSH_NS, so posting a line does not cost a thread switch. When the
+ * ring is full, posting threads wait for the writer to free a slot.
+ *
+ * Lines are written in timestamp order using a low watermark. Each
+ * posting thread (producer) publishes the earliest time it may still
+ * post: the time of its last line, the end of a wait it is in, or
+ * "never" while it is idle. Drained lines are held and ordered by time,
+ * and only lines at or before the smallest published time are written.
+ * A thread that wakes an idle producer lowers its time to its own, since
+ * the woken thread cannot post before the thread that woke it. Held lines
+ * are not bounded by the ring, so they can grow while one producer is
+ * slow to post.
+ */
+
+// header files
+   #include "Log_Writer.h"
+   #include <string> // used for string operations
+   #include <vector> // used for write buffers
+   #include <algorithm> // used for sorting batches
+   #include <cstring> // used for c string operations
+   #include <cerrno> // used for write errors
+   #include <atomic> // used for lock-free ring buffer
+   #include <pthread.h> // used for threads
+   #include <sched.h> // used to yield while ring is full
+   #include <fcntl.h> // used to open log file
+   #include <unistd.h> // used for write and close
+   #include <ctime> // used for flush time
+   #include <cmath> // used for unbounded watermark times
+
+   using namespace std;
+
+// global constants
+   const long NSEC_PER_SEC = 1000000000;
+
+// global variables
+
+   // producer of lines posted by this thread (the dispatcher unless attached)
+   thread_local int currentProducer = 0;
+
+   // log destinations in configuration file, indexed by LogModeID
+   const char* const LOG_MODE_NAMES[ LOG_MODE_COUNT ] =
+   {
+      "Log to Monitor", "Log to Both", "Log to File"
+   };
+
+// function prototypes
+   bool compareTimestamps( const LogRecord& first, const LogRecord& second );
+
+// class implementation
+LogWriter::LogWriter()
+{
+   // initialize variables
+   int index;
+
+   ring = new LogSlot[ LOG_RING_SIZE ];
+   published = new atomic<double>[ LOG_MAX_PRODUCERS ];
+
+   // each slot is first ready for its own ticket
+   for( index = 0; index < LOG_RING_SIZE; index++ )
+   {
+      ring[ index ].sequence.store( index );
+   }
+
+   // only the dispatcher posts until other producers are added
+   published[ 0 ].store( -HUGE_VAL );
+   producerCount.store( 1 );
+
+   head.store( 0 );
+   tail = 0;
+   writerWaiting.store( false );
+   stopping.store( false );
+   running = false;
+   consoleFile = -1;
+   logFile = -1;
+   pthread_mutex_init( &lock, NULL );
+   pthread_cond_init( &logReady, NULL );
+}
+
+LogWriter::~LogWriter()
+{
+   stop();
+   delete[] ring;
+   delete[] published;
+   pthread_mutex_destroy( &lock );
+   pthread_cond_destroy( &logReady );
+}
+
+/**
+start
+
+Opens the log outputs and creates the writer thread.
+
+@param toConsole true to write log lines to the console
+@param filePath path of log file (empty to not write a log file)
+@pre writer is not running
+@post writer thread is waiting for lines
+@return bool representing log file was opened
+*/
+bool LogWriter::start( bool toConsole, const string& filePath )
+{
+   // check for running writer
+   if( running )
+   {
+      return true;
+   }
+
+   // open log file
+   if( !filePath.empty() )
+   {
+      logFile = open( filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+      // check for open failure
+      if( logFile < 0 )
+      {
+         return false;
+      }
+   }
+
+   // use console
+   if( toConsole )
+   {
+      consoleFile = STDOUT_FILENO;
+   }
+
+   // only the dispatcher posts until other producers are added
+   published[ 0 ].store( -HUGE_VAL );
+   producerCount.store( 1 );
+
+   stopping.store( false );
+
+   pthread_create( &tid, NULL, writer, this );
+   running = true;
+
+   return true;
+}
+
+/**
+post
+
+Queues a log line for the writer thread. Lines longer than one slot
+take several slots in a row. Waits while the ring is full. The time is
+published for the posting producer before the line is queued, so the
+writer never passes it while the line is still in the ring.
+
+@param timestamp time at start of line
+@param text characters of line
+@param length number of characters in line
+@pre none
+@post line was queued (or written, if writer is not running)
+@return void
+*/
+void LogWriter::post( double timestamp, const char* text, int length )
+{
+   // initialize variables
+   int slotCount = ( length + LOG_SLOT_LEN - 1 ) / LOG_SLOT_LEN;
+   unsigned long ticket;
+   unsigned long firstTicket;
+   LogSlot* slotPtr;
+   int partLength;
+
+   // check for empty line
+   if( length <= 0 )
+   {
+      return;
+   }
+
+   // check for no writer thread
+   if( !running )
+   {
+      writeAll( consoleFile, text, length );
+      writeAll( logFile, text, length );
+
+      return;
+   }
+
+   // no earlier line will be posted by this producer
+   published[ currentProducer ].store( timestamp );
+
+   // take one ticket for each slot
+   ticket = head.fetch_add( slotCount );
+   firstTicket = ticket;
+
+   // fill each slot in order
+   while( length > 0 )
+   {
+      slotPtr = &( ring[ ticket % LOG_RING_SIZE ] );
+
+      // wait for writer to free slot (ring is full)
+      while( slotPtr->sequence.load( memory_order_acquire ) != ticket )
+      {
+         if( writerWaiting.load() )
+         {
+            wakeWriter();
+         }
+
+         sched_yield();
+      }
+
+      // copy part of line
+      partLength = min( length, LOG_SLOT_LEN );
+      memcpy( slotPtr->text, text, partLength );
+      slotPtr->length = partLength;
+      slotPtr->timestamp = timestamp;
+      slotPtr->continues = ( length > partLength );
+
+      // hand slot to writer
+      slotPtr->sequence.store( ticket + 1 );
+
+      text += partLength;
+      length -= partLength;
+      ticket++;
+   }
+
+   // wake sleeping writer once a full batch is waiting
+   if( writerWaiting.load() && ticket / LOG_BATCH_SIZE != firstTicket / LOG_BATCH_SIZE )
+   {
+      wakeWriter();
+   }
+}
+
+/**
+addProducer
+
+Adds a producer for a thread that posts lines. It starts idle, so it
+holds back no lines until it is woken.
+
+@pre none
+@post producer was added (the dispatcher is shared once every one is used)
+@return int with producer number
+*/
+int LogWriter::addProducer()
+{
+   // initialize variables
+   int producer = producerCount.load();
+
+   // check for every producer in use
+   if( producer >= LOG_MAX_PRODUCERS )
+   {
+      return 0;
+   }
+
+   published[ producer ].store( HUGE_VAL );
+   producerCount.store( producer + 1 );
+
+   return producer;
+}
+
+/**
+attach
+
+Makes the calling thread post lines as the given producer.
+
+@param producer producer number from addProducer
+@pre none
+@post lines posted by this thread are published for producer
+@return void
+*/
+void LogWriter::attach( int producer )
+{
+   currentProducer = producer;
+}
+
+/**
+producer
+
+Returns the producer the calling thread posts lines as.
+
+@pre none
+@post none
+@return int with producer number
+*/
+int LogWriter::producer()
+{
+   return currentProducer;
+}
+
+/**
+advance
+
+Publishes that the calling thread will post no line earlier than the
+given time (e.g. while it waits until that time), so lines of other
+threads up to it can be written.
+
+@param timestamp earliest time of next line
+@pre no line earlier than timestamp will be posted by this thread
+@post time was published for producer
+@return void
+*/
+void LogWriter::advance( double timestamp )
+{
+   published[ currentProducer ].store( timestamp );
+}
+
+/**
+idle
+
+Publishes that the calling thread will post no line until it is woken.
+
+@pre thread will be woken with wake (or call resume) before posting
+@post producer holds back no lines
+@return void
+*/
+void LogWriter::idle()
+{
+   published[ currentProducer ].store( HUGE_VAL );
+}
+
+/**
+resume
+
+Marks the calling thread active again without a waker. Lines are held
+back until it posts or advances.
+
+@pre none
+@post producer holds back every line not yet written
+@return void
+*/
+void LogWriter::resume()
+{
+   published[ currentProducer ].store( -HUGE_VAL );
+}
+
+/**
+wake
+
+Called by the thread that wakes an idle producer. Lowers the time of the
+woken producer to the time of the calling thread, which is the earliest
+it may post once woken.
+
+@param producer producer number being woken
+@pre none
+@post producer holds back lines after the time of the calling thread
+@return void
+*/
+void LogWriter::wake( int producer )
+{
+   // initialize variables
+   double wakeTime = published[ currentProducer ].load();
+   double producerTime = published[ producer ].load();
+
+   // lower time (never raise it, the producer may already be active)
+   while( wakeTime < producerTime && !published[ producer ].compare_exchange_weak( producerTime, wakeTime ) )
+   {
+   }
+}
+
+/**
+stop
+
+Writes every queued line, ends the writer thread and closes the log file.
+
+@pre none
+@post writer thread is not running and all lines were written
+@return void
+*/
+void LogWriter::stop()
+{
+   // check for stopped writer
+   if( !running )
+   {
+      return;
+   }
+
+   stopping.store( true );
+   wakeWriter();
+
+   pthread_join( tid, NULL );
+   running = false;
+
+   // close log file
+   if( logFile >= 0 )
+   {
+      close( logFile );
+      logFile = -1;
+   }
+}
+
+/**
+writer
+
+Writer thread function. Writes batches of lines until stopped. After
+a partial batch, sleeps until a full batch is waiting or LOG_FLUSH_NS
+has passed. Once stopped, every held line is written.
+
+@param writerVoidPtr void pointer to LogWriter
+@pre writer was started
+@post every line posted before stop was written
+@return void
+*/
+void *LogWriter::writer( void* writerVoidPtr )
+{
+   // initialize variables
+   LogWriter* writerPtr = static_cast<LogWriter*>( writerVoidPtr );
+   bool stopRequested;
+   int slotCount;
+   timespec wakeTime;
+
+   while( true )
+   {
+      // check for stop before draining, so no line is left behind
+      stopRequested = writerPtr->stopping.load();
+
+      // write next batch
+      slotCount = writerPtr->writeBatch( stopRequested );
+
+      // check for more waiting lines
+      if( slotCount >= LOG_BATCH_SIZE )
+      {
+         continue;
+      }
+
+      // check for stop
+      if( stopRequested )
+      {
+         if( slotCount == 0 )
+         {
+            break;
+         }
+
+         continue;
+      }
+
+      // find flush time
+      clock_gettime( CLOCK_REALTIME, &wakeTime );
+      wakeTime.tv_nsec += LOG_FLUSH_NS;
+
+      if( wakeTime.tv_nsec >= NSEC_PER_SEC )
+      {
+         wakeTime.tv_sec++;
+         wakeTime.tv_nsec -= NSEC_PER_SEC;
+      }
+
+      // sleep until a batch is waiting or flush time
+      pthread_mutex_lock( &writerPtr->lock );
+
+      writerPtr->writerWaiting.store( true );
+
+      if( !writerPtr->stopping.load() )
+      {
+         pthread_cond_timedwait( &writerPtr->logReady, &writerPtr->lock, &wakeTime );
+      }
+
+      writerPtr->writerWaiting.store( false );
+
+      pthread_mutex_unlock( &writerPtr->lock );
+   }
+
+   return NULL;
+}
+
+/**
+watermark
+
+Returns the smallest time published by any producer. No line earlier
+than it can still be posted.
+
+@pre none
+@post none
+@return double with low watermark (seconds)
+*/
+double LogWriter::watermark()
+{
+   // initialize variables
+   int count = producerCount.load();
+   int producer;
+   double lowest = HUGE_VAL;
+
+   for( producer = 0; producer < count; producer++ )
+   {
+      lowest = min( lowest, published[ producer ].load() );
+   }
+
+   return lowest;
+}
+
+/**
+writeBatch
+
+Reads the low watermark, then takes every line posted before it was read
+out of the ring, freeing their slots. Held lines are ordered by
+timestamp (lines with the same time keep the order they were posted in)
+and those at or before the watermark are written; the rest stay held.
+
+@param flushAll true to write every held line (writer is stopping)
+@pre called from writer thread
+@post held lines up to watermark were written to each log output
+@return int with number of slots taken from ring
+*/
+int LogWriter::writeBatch( bool flushAll )
+{
+   // initialize variables
+   int slotCount = 0;
+   unsigned int index;
+   unsigned int writeCount = 0;
+   unsigned long lastTicket;
+   double lowWatermark = HUGE_VAL;
+   bool continues;
+   bool inOrder = true;
+   LogSlot* slotPtr;
+   LogRecord currentLine;
+
+   // read watermark before ring, so every line posted before any producer
+   // passed it is taken below
+   if( !flushAll )
+   {
+      lowWatermark = watermark();
+   }
+
+   lastTicket = head.load();
+
+   // copy posted lines out of ring
+   while( tail != lastTicket )
+   {
+      currentLine.offset = heldText.size();
+
+      // copy each part of line
+      do
+      {
+         slotPtr = &( ring[ tail % LOG_RING_SIZE ] );
+
+         // wait for part of line to be posted
+         while( slotPtr->sequence.load( memory_order_acquire ) != tail + 1 )
+         {
+            sched_yield();
+         }
+
+         // line time is kept in its first part
+         if( currentLine.offset == (int) heldText.size() )
+         {
+            currentLine.timestamp = slotPtr->timestamp;
+         }
+
+         heldText.insert( heldText.end(), slotPtr->text, slotPtr->text + slotPtr->length );
+         continues = slotPtr->continues;
+
+         // free slot for ticket one lap ahead
+         slotPtr->sequence.store( tail + LOG_RING_SIZE, memory_order_release );
+
+         tail++;
+         slotCount++;
+      }
+      while( continues );
+
+      currentLine.length = heldText.size() - currentLine.offset;
+
+      // check for line posted out of time order
+      if( !heldLines.empty() && currentLine.timestamp < heldLines.back().timestamp )
+      {
+         inOrder = false;
+      }
+
+      heldLines.push_back( currentLine );
+   }
+
+   // order held lines by time
+   if( !inOrder )
+   {
+      stable_sort( heldLines.begin(), heldLines.end(), compareTimestamps );
+   }
+
+   // count lines no producer can post before
+   while( writeCount < heldLines.size() && heldLines[ writeCount ].timestamp <= lowWatermark )
+   {
+      writeCount++;
+   }
+
+   // check for no line to write
+   if( writeCount == 0 )
+   {
+      return slotCount;
+   }
+
+   // split written lines from lines kept back
+   outputText.clear();
+   keptText.clear();
+
+   for( index = 0; index < heldLines.size(); index++ )
+   {
+      if( index < writeCount )
+      {
+         outputText.insert( outputText.end(), heldText.begin() + heldLines[ index ].offset,
+                            heldText.begin() + heldLines[ index ].offset + heldLines[ index ].length );
+      }
+
+      else
+      {
+         keptText.insert( keptText.end(), heldText.begin() + heldLines[ index ].offset,
+                          heldText.begin() + heldLines[ index ].offset + heldLines[ index ].length );
+         heldLines[ index ].offset = keptText.size() - heldLines[ index ].length;
+      }
+   }
+
+   heldLines.erase( heldLines.begin(), heldLines.begin() + writeCount );
+   heldText.swap( keptText );
+
+   // write lines
+   writeAll( consoleFile, &outputText[ 0 ], outputText.size() );
+   writeAll( logFile, &outputText[ 0 ], outputText.size() );
+
+   return slotCount;
+}
+
+/**
+writeAll
+
+Writes text to a file descriptor, retrying partial and interrupted writes.
+
+@param fileDescriptor file to write to (-1 to skip)
+@param text characters to write
+@param length number of characters to write
+@pre none
+@post text was written, or a write error occurred
+@return void
+*/
+void LogWriter::writeAll( int fileDescriptor, const char* text, int length )
+{
+   // initialize variables
+   ssize_t written;
+
+   // check for unused output
+   if( fileDescriptor < 0 )
+   {
+      return;
+   }
+
+   while( length > 0 )
+   {
+      written = write( fileDescriptor, text, length );
+
+      // check for error
+      if( written < 0 )
+      {
+         if( errno == EINTR )
+         {
+            continue;
+         }
+
+         return;
+      }
+
+      text += written;
+      length -= written;
+   }
+}
+
+/**
+wakeWriter
+
+Wakes the writer thread if it is sleeping.
+
+@pre none
+@post writer thread was signaled
+@return void
+*/
+void LogWriter::wakeWriter()
+{
+   pthread_mutex_lock( &lock );
+   pthread_cond_signal( &logReady );
+   pthread_mutex_unlock( &lock );
+}
+
+// function implementation
+
+/**
+compareTimestamps
+
+Returns true if the first log line has an earlier time than the second.
+
+@param first line to compare
+@param second line to compare
+@pre none
+@post none
+@return bool representing first line is earlier
+*/
+bool compareTimestamps( const LogRecord& first, const LogRecord& second )
+{
+   return first.timestamp < second.timestamp;
+}
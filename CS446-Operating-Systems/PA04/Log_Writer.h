@@ -0,0 +1,102 @@
+/**
+ * @file   Log_Writer.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Asynchronous log writer header for Operating System simulator
+ */
+
+// definition
+   #ifndef __LOGWRITER_H_
+   #define __LOGWRITER_H_
+
+// header files
+   #include <string> // used for string operations
+   #include <vector> // used for write buffers
+   #include <atomic> // used for lock-free ring buffer
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+   const int LOG_SLOT_LEN = 120; // characters held by one ring slot
+   const int LOG_RING_SIZE = 8192; // ring slots (bounds memory use)
+   const int LOG_BATCH_SIZE = 1024; // most slots written per batch
+   const long LOG_FLUSH_NS = 10000000; // longest writer sleep (nanoseconds)
+   const int LOG_MAX_PRODUCERS = 2048; // most threads that post lines (one each)
+
+   // log destinations, indexed by LogModeID
+   enum LogModeID
+   {
+      LOG_MONITOR,
+      LOG_BOTH,
+      LOG_FILE,
+      LOG_MODE_COUNT
+   };
+
+// global variables
+   extern const char* const LOG_MODE_NAMES[ LOG_MODE_COUNT ];
+
+// class declaration
+class LogSlot
+{
+   public:
+      atomic<unsigned long> sequence; // ticket slot is ready for
+      double timestamp; // time at start of line
+      short length; // characters used in text
+      bool continues; // true if line continues in next slot
+      char text[ LOG_SLOT_LEN ]; // part of log line
+};
+
+class LogRecord
+{
+   public:
+      double timestamp; // time at start of line
+      int offset; // position of line in held text
+      int length; // length of line
+};
+
+// writes log lines posted by simulator threads on its own thread, in
+// timestamp order. Each posting thread (producer) publishes the earliest
+// time it may still post; a line is only written once no producer can
+// post an earlier one.
+class LogWriter
+{
+   public:
+      LogWriter();
+      ~LogWriter();
+      bool start( bool toConsole, const string& filePath );
+      void post( double timestamp, const char* text, int length );
+      int addProducer();
+      void attach( int producer );
+      int producer();
+      void advance( double timestamp );
+      void idle();
+      void resume();
+      void wake( int producer );
+      void stop();
+   private:
+      static void *writer( void* writerVoidPtr );
+      double watermark();
+      int writeBatch( bool flushAll );
+      void writeAll( int fileDescriptor, const char* text, int length );
+      void wakeWriter();
+      LogSlot* ring; // lines waiting to be written
+      atomic<unsigned long> head; // next ticket given to a producer
+      unsigned long tail; // next ticket read by writer thread
+      atomic<bool> writerWaiting; // true while writer thread may be asleep
+      atomic<bool> stopping; // true when writer thread should exit
+      bool running; // true while writer thread exists
+      int consoleFile; // console file descriptor (-1 if not logging to console)
+      int logFile; // log file descriptor (-1 if not logging to file)
+      atomic<double>* published; // earliest time each producer may still post
+      atomic<int> producerCount; // producers in use (the first is the dispatcher)
+      vector<char> heldText; // text of lines drained but not yet written
+      vector<LogRecord> heldLines; // lines drained but not yet written
+      vector<char> outputText; // text of lines being written, in time order
+      vector<char> keptText; // text of lines held back from this write
+      pthread_t tid; // writer thread
+      pthread_mutex_t lock; // used with logReady to sleep the writer thread
+      pthread_cond_t logReady; // signaled when a line is posted
+};
+
+#endif
@@ -0,0 +1,326 @@
+/**
+ * @file   Memory_Unit.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Memory management unit for Operating System simulator
+ *
+ * Processes declare their memory with M(allocate) actions and use it with
+ * M(access) actions, which give an address (kB) in the process's memory.
+ * An access to a page that is not in a physical frame is a page fault:
+ * the page is given a frame (replacing another page if every frame is in
+ * use), and the process waits for the page to be read from the hard drive.
+ * Frames of a process are freed when it exits.
+ */
+
+// header files
+   #include "Memory_Unit.h"
+   #include <string> // used for string operations
+   #include <vector> // used to store frames
+   #include <list> // used for replacement order
+   #include <unordered_map> // used for page table
+   #include <stdint.h> // used for page table keys
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+   const int FREE_FRAME = 0;
+
+// global variables
+
+   // replacement policy names, indexed by ReplacementID
+   const char* const REPLACEMENT_NAMES[ REPLACE_COUNT ] =
+   {
+      "FIFO", "LRU", "CLOCK"
+   };
+
+// function prototypes
+   uint64_t findPageKey( int pcbID, int page );
+
+// class implementation
+MemoryUnit::MemoryUnit()
+{
+   pthread_mutex_init( &lock, NULL );
+   configure( DEFAULT_FRAME_COUNT, DEFAULT_PAGE_SIZE, REPLACE_LRU );
+}
+
+MemoryUnit::~MemoryUnit()
+{
+   pthread_mutex_destroy( &lock );
+}
+
+/**
+configure
+
+Sets the size of physical memory and the replacement policy, and frees
+every frame.
+
+@param frames number of physical frames
+@param pageKB page size (kB)
+@param policy page replacement policy (ReplacementID)
+@pre frames and pageKB are positive, no process is running
+@post every frame is free and statistics are cleared
+@return void
+*/
+void MemoryUnit::configure( int frames, int pageKB, int policy )
+{
+   // initialize variables
+   int index;
+
+   frameCount = frames;
+   pageSize = pageKB;
+   replacement = policy;
+
+   // free every frame
+   this->frames.assign( frameCount, PageFrame() );
+   freeFrames.clear();
+
+   for( index = frameCount - 1; index >= 0; index-- )
+   {
+      this->frames[ index ].pcbID = FREE_FRAME;
+      this->frames[ index ].page = NO_PAGE;
+      this->frames[ index ].referenced = false;
+      freeFrames.push_back( index );
+   }
+
+   pageTable.clear();
+   pageTable.reserve( frameCount );
+   residentPages.clear();
+   frameOrder.clear();
+   clockHand = 0;
+
+   // clear statistics
+   accessCount = 0;
+   faultCount = 0;
+   evictionCount = 0;
+}
+
+/**
+findPage
+
+Returns the page holding a memory address.
+
+@param address address in process memory (kB)
+@pre address is not negative
+@post none
+@return int with page number
+*/
+int MemoryUnit::findPage( int address )
+{
+   return address / pageSize;
+}
+
+/**
+isResident
+
+Checks whether a page of a process is in a physical frame, without
+counting an access.
+
+@param pcbID process owning page
+@param page page number
+@pre none
+@post none
+@return bool representing page is resident
+*/
+bool MemoryUnit::isResident( int pcbID, int page )
+{
+   // initialize variables
+   bool resident;
+
+   pthread_mutex_lock( &lock );
+
+   resident = pageTable.find( findPageKey( pcbID, page ) ) != pageTable.end();
+
+   pthread_mutex_unlock( &lock );
+
+   return resident;
+}
+
+/**
+access
+
+Accesses a page of a process. If the page is not resident (a page fault)
+it is loaded into a free frame, or into the frame of the page chosen by
+the replacement policy.
+
+@param pcbID process owning page
+@param page page number
+@pre memory was configured
+@post page is resident and statistics were updated
+@return bool representing page was already resident (false for page fault)
+*/
+bool MemoryUnit::access( int pcbID, int page )
+{
+   // initialize variables
+   unordered_map<uint64_t, int>::iterator entry;
+   uint64_t key = findPageKey( pcbID, page );
+   PageFrame* framePtr;
+   int frameIndex;
+
+   pthread_mutex_lock( &lock );
+
+   accessCount++;
+
+   entry = pageTable.find( key );
+
+   // page hit
+   if( entry != pageTable.end() )
+   {
+      framePtr = &( frames[ entry->second ] );
+      framePtr->referenced = true;
+
+      // move to most recently used
+      if( replacement == REPLACE_LRU )
+      {
+         frameOrder.splice( frameOrder.end(), frameOrder, framePtr->position );
+      }
+
+      pthread_mutex_unlock( &lock );
+
+      return true;
+   }
+
+   // page fault
+   faultCount++;
+
+   // use free frame
+   if( !freeFrames.empty() )
+   {
+      frameIndex = freeFrames.back();
+      freeFrames.pop_back();
+   }
+
+   // replace a page
+   else
+   {
+      frameIndex = findVictim();
+      framePtr = &( frames[ frameIndex ] );
+
+      pageTable.erase( findPageKey( framePtr->pcbID, framePtr->page ) );
+      residentPages[ framePtr->pcbID ]--;
+      evictionCount++;
+
+      if( replacement != REPLACE_CLOCK )
+      {
+         frameOrder.erase( framePtr->position );
+      }
+   }
+
+   // load page into frame
+   framePtr = &( frames[ frameIndex ] );
+   framePtr->pcbID = pcbID;
+   framePtr->page = page;
+   framePtr->referenced = true;
+
+   if( replacement != REPLACE_CLOCK )
+   {
+      framePtr->position = frameOrder.insert( frameOrder.end(), frameIndex );
+   }
+
+   pageTable[ key ] = frameIndex;
+   residentPages[ pcbID ]++;
+
+   pthread_mutex_unlock( &lock );
+
+   return false;
+}
+
+/**
+release
+
+Frees every frame holding a page of a process.
+
+@param pcbID process that exited
+@pre none
+@post process has no resident pages
+@return void
+*/
+void MemoryUnit::release( int pcbID )
+{
+   // initialize variables
+   unordered_map<int, int>::iterator resident;
+   int frameIndex;
+
+   pthread_mutex_lock( &lock );
+
+   resident = residentPages.find( pcbID );
+
+   // check for process with resident pages
+   if( resident != residentPages.end() )
+   {
+      for( frameIndex = 0; frameIndex < frameCount && resident->second > 0; frameIndex++ )
+      {
+         if( frames[ frameIndex ].pcbID == pcbID )
+         {
+            pageTable.erase( findPageKey( pcbID, frames[ frameIndex ].page ) );
+
+            if( replacement != REPLACE_CLOCK )
+            {
+               frameOrder.erase( frames[ frameIndex ].position );
+            }
+
+            frames[ frameIndex ].pcbID = FREE_FRAME;
+            frames[ frameIndex ].page = NO_PAGE;
+            frames[ frameIndex ].referenced = false;
+            freeFrames.push_back( frameIndex );
+
+            resident->second--;
+         }
+      }
+
+      residentPages.erase( resident );
+   }
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+findVictim
+
+Chooses the frame whose page is replaced.
+
+@pre lock is held, every frame is in use
+@post clock hand moved past victim (CLOCK)
+@return int with frame index
+*/
+int MemoryUnit::findVictim()
+{
+   // initialize variables
+   int frameIndex;
+
+   // oldest or least recently used page is first in order
+   if( replacement != REPLACE_CLOCK )
+   {
+      return frameOrder.front();
+   }
+
+   // give each referenced page a second chance
+   while( frames[ clockHand ].referenced )
+   {
+      frames[ clockHand ].referenced = false;
+      clockHand = ( clockHand + 1 ) % frameCount;
+   }
+
+   frameIndex = clockHand;
+   clockHand = ( clockHand + 1 ) % frameCount;
+
+   return frameIndex;
+}
+
+// function implementation
+
+/**
+findPageKey
+
+Returns the page table key of a page of a process.
+
+@param pcbID process owning page
+@param page page number
+@pre none
+@post none
+@return uint64_t with page table key
+*/
+uint64_t findPageKey( int pcbID, int page )
+{
+   return ( (uint64_t)(uint32_t) pcbID << 32 ) | (uint32_t) page;
+}
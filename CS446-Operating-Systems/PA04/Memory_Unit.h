@@ -0,0 +1,89 @@
+/**
+ * @file   Memory_Unit.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Memory management unit header for Operating System simulator
+ */
+
+// definition
+   #ifndef __MEMORYUNIT_H_
+   #define __MEMORYUNIT_H_
+
+// header files
+   #include <string> // used for string operations
+   #include <vector> // used to store frames
+   #include <list> // used for replacement order
+   #include <unordered_map> // used for page table
+   #include <stdint.h> // used for page table keys
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+   // page replacement policies
+   enum ReplacementID
+   {
+      REPLACE_FIFO,
+      REPLACE_LRU,
+      REPLACE_CLOCK,
+      REPLACE_COUNT
+   };
+
+   const int DEFAULT_FRAME_COUNT = 64;
+   const int DEFAULT_PAGE_SIZE = 4; // kB
+   const int NO_PAGE = -1;
+
+// global variables
+   extern const char* const REPLACEMENT_NAMES[ REPLACE_COUNT ];
+
+// function prototypes
+
+// class declaration
+
+// physical frame and the page loaded in it
+class PageFrame
+{
+   public:
+      int pcbID; // process owning page (0 if frame is free)
+      int page; // page number within process
+      bool referenced; // page was accessed since clock hand last passed
+      list<int>::iterator position; // place in replacement order (FIFO and LRU)
+};
+
+// physical memory shared by every process, with one page table entry for
+// each resident page. Pages are loaded on demand, and when every frame is
+// in use a page is chosen to replace:
+//    FIFO   the page loaded first
+//    LRU    the page used least recently (frames kept in order of use in a
+//           linked list, found through the page table hash in O(1))
+//    CLOCK  the first page after the clock hand not referenced since the
+//           hand last passed it (second chance)
+class MemoryUnit
+{
+   public:
+      MemoryUnit();
+      ~MemoryUnit();
+      void configure( int frames, int pageKB, int policy );
+      int findPage( int address );
+      bool isResident( int pcbID, int page );
+      bool access( int pcbID, int page );
+      void release( int pcbID );
+      int frameCount; // physical frames
+      int pageSize; // page (and frame) size (kB)
+      int replacement; // page replacement policy (ReplacementID)
+      long accessCount; // page accesses
+      long faultCount; // accesses to pages that were not resident
+      long evictionCount; // pages replaced to load another
+   private:
+      int findVictim();
+      vector<PageFrame> frames; // physical frames
+      unordered_map<uint64_t, int> pageTable; // frame of each resident page, by process and page
+      unordered_map<int, int> residentPages; // resident page count of each process
+      list<int> frameOrder; // used frames, next to replace first (FIFO and LRU)
+      vector<int> freeFrames; // frames not in use
+      int clockHand; // next frame to check (CLOCK)
+      pthread_mutex_t lock; // guards frames when processors access memory at once
+};
+
+#endif
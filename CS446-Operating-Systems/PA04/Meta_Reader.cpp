@@ -0,0 +1,1162 @@
+/**
+ * @file   Meta_Reader.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Streaming meta-data reader for Operating System simulator
+ *
+ * Maps the meta-data file into memory and parses it in place, a batch of
+ * processes at a time, so the scheduler can start running processes
+ * before the whole file has been read. Pages that have been parsed are
+ * released back to the operating system, so memory use stays bounded
+ * by the processes held in the Ready queue, not by the size of the file.
+ * Files compiled with --compile-meta are recognized by their first bytes
+ * and read directly from fixed-width action records instead.
+ * Files ending in .csv are recorded traces of processor and I/O bursts,
+ * converted to actions (burst durations rounded to whole cycles) with the
+ * arrival time of each process kept, so recorded workloads can be replayed.
+ * In every format each process has an arrival time, and processes are
+ * checked to be in arrival order.
+ */
+
+// header files
+   #include "Meta_Reader.h"
+   #include "Process_Control_Block.h"
+   #include <iostream> // used for I/O
+   #include <string> // used for string operations
+   #include <list> // used to store processes
+   #include <vector> // used for descriptor table
+   #include <cstddef> // used for sizes
+   #include <cstring> // used for c string operations
+   #include <cstdlib> // used for number conversions
+   #include <climits> // used for cycle count limit
+   #include <stdint.h> // used for fixed-width binary fields
+   #include <sys/mman.h> // used to map meta-data file
+   #include <sys/stat.h> // used to find file size
+   #include <fcntl.h> // used to open meta-data file
+   #include <unistd.h> // used for close and page size
+
+   using namespace std;
+
+// global constants
+   const size_t RELEASE_SIZE = 16 * 1024 * 1024; // parsed bytes kept mapped before release
+   const int INVALID_CYCLE = -1;
+   const int TOO_LARGE_CYCLE = -2; // cycle count above INT_MAX (never valid)
+   const int MAX_NUMBER_LEN = 64; // characters in a trace number
+
+// global variables
+
+   // trace burst types, with the action each becomes
+   const TraceBurst TRACE_BURSTS[] =
+   {
+      { "cpu", 'P', DESC_RUN },
+      { "run", 'P', DESC_RUN },
+      { "disk", 'I', DESC_HARD_DRIVE },
+      { "disk read", 'I', DESC_HARD_DRIVE },
+      { "disk write", 'O', DESC_HARD_DRIVE },
+      { "hard drive", 'I', DESC_HARD_DRIVE },
+      { "keyboard", 'I', DESC_KEYBOARD },
+      { "monitor", 'O', DESC_MONITOR },
+      { "printer", 'O', DESC_PRINTER }
+   };
+
+   const int TRACE_BURST_COUNT = sizeof( TRACE_BURSTS ) / sizeof( TRACE_BURSTS[ 0 ] );
+
+// function prototypes
+   bool parseNumber( const char* field, size_t length, double& value );
+
+// class implementation
+MetaReader::MetaReader()
+{
+   data = NULL;
+   size = 0;
+   position = 0;
+   released = 0;
+   fileDescriptor = -1;
+   processCount = 0;
+   started = false;
+   ended = false;
+   error = false;
+   binary = false;
+   trace = false;
+   traceStart = NO_ARRIVAL;
+   lastArrival = 0;
+   records = NULL;
+   processIndex = NULL;
+   arrivals = NULL;
+}
+
+MetaReader::~MetaReader()
+{
+   close();
+}
+
+/**
+open
+
+Opens and maps the meta-data file for reading.
+
+@param metaPath path of meta-data file
+@pre none
+@post file is mapped and ready to read from the start
+@return bool representing file was opened
+*/
+bool MetaReader::open( const string& metaPath )
+{
+   // initialize variables
+   struct stat fileInfo;
+   void* mapped;
+
+   close();
+
+   // open file
+   fileDescriptor = ::open( metaPath.c_str(), O_RDONLY );
+
+      // check for open failure
+      if( fileDescriptor < 0 || fstat( fileDescriptor, &fileInfo ) != 0 )
+      {
+         close();
+         return false;
+      }
+
+   size = fileInfo.st_size;
+
+   // map file (an empty file has nothing to map)
+   if( size > 0 )
+   {
+      mapped = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+
+         // check for map failure
+         if( mapped == MAP_FAILED )
+         {
+            close();
+            return false;
+         }
+
+      data = static_cast<const char*>( mapped );
+
+      // file is read front to back
+      madvise( mapped, size, MADV_SEQUENTIAL );
+   }
+
+   position = 0;
+   released = 0;
+   processCount = 0;
+   started = false;
+   ended = false;
+   error = false;
+
+   // check for binary format
+   binary = ( size >= (size_t) META_MAGIC_LEN && ( memcmp( data, META_MAGIC, META_MAGIC_LEN ) == 0 ||
+                                                   memcmp( data, META_MAGIC_V1, META_MAGIC_LEN ) == 0 ) );
+
+   if( binary && !openBinary() )
+   {
+      close();
+      return false;
+   }
+
+   // check for trace
+   trace = !binary && metaPath.size() > strlen( TRACE_EXTENSION ) &&
+           metaPath.compare( metaPath.size() - strlen( TRACE_EXTENSION ), string::npos, TRACE_EXTENSION ) == 0;
+   traceStart = NO_ARRIVAL;
+   lastArrival = 0;
+
+   return true;
+}
+
+/**
+readProcesses
+
+Reads up to maxCount processes and adds them to the end of the process
+list in Ready state. Reads the OS start action first if it has not yet
+been read, and marks the reader finished once the OS end action is read.
+Errors are printed and end the reading.
+
+@param processes list to add processes to
+@param maxCount most processes to read (ALL_PROCESSES for no limit)
+@param cycleTimes cycle time of each descriptor, used for estimated run time
+@pre file was opened
+@post processes were added to list
+@return int with number of processes read, or -1 on error
+*/
+int MetaReader::readProcesses( list<PCB>& processes, int maxCount, const float* cycleTimes )
+{
+   // initialize variables
+   int readCount = 0;
+   char tempType;
+   int tempDescriptorID;
+   int tempCycle;
+
+   // check for finished file
+   if( ended || error )
+   {
+      return error ? -1 : 0;
+   }
+
+   // read binary file
+   if( binary )
+   {
+      return readBinaryProcesses( processes, maxCount, cycleTimes );
+   }
+
+   // read trace file
+   if( trace )
+   {
+      return readTraceProcesses( processes, maxCount, cycleTimes );
+   }
+
+   // read in OS start action
+   if( !started )
+   {
+      // skip first line
+      while( position < size && data[ position ] != '\n' )
+      {
+         position++;
+      }
+
+      // check for invalid OS start
+      if( !nextAction( tempType, tempDescriptorID, tempCycle ) || tempType != 'S' )
+      {
+         return fail( "Error in meta-data. OS start failure. Please try again." );
+      }
+
+      started = true;
+   }
+
+   // add processes until limit or end simulation action
+   while( maxCount == ALL_PROCESSES || readCount < maxCount )
+   {
+      // get process start action
+      if( !nextAction( tempType, tempDescriptorID, tempCycle ) )
+      {
+         return fail( "Error in meta-data. OS end failure. Please try again." );
+      }
+
+      // check for end simulation action
+      if( tempType == 'S' )
+      {
+         ended = true;
+         break;
+      }
+
+      // unrecognized start action
+      if( tempType != 'A' )
+      {
+         return fail( "Error in meta-data. Process start/end failure. Please try again." );
+      }
+
+      addProcess( processes );
+
+      // check for invalid arrival time (same as process before, if not given)
+      if( tempCycle < 0 && tempCycle != INVALID_CYCLE )
+      {
+         processes.pop_back();
+         return fail( "Error in meta-data. Unrecognized process arrival time found. Please try again." );
+      }
+
+      if( !setArrival( processes, tempCycle == INVALID_CYCLE ? lastArrival : tempCycle ) )
+      {
+         return -1;
+      }
+
+      // until end action
+      while( true )
+      {
+         // check for end of file inside process
+         if( !nextAction( tempType, tempDescriptorID, tempCycle ) )
+         {
+            processes.pop_back();
+            return fail( "Error in meta-data. Process start/end failure. Please try again." );
+         }
+
+         // end action
+         if( tempType == 'A' )
+         {
+            break;
+         }
+
+         // queue process action
+         if( !addAction( processes, tempType, tempDescriptorID, tempCycle, cycleTimes ) )
+         {
+            return -1;
+         }
+      }
+
+      endProcess( processes );
+      readCount++;
+   }
+
+   // give back pages already parsed
+   releasePages();
+
+   return readCount;
+}
+
+/**
+openBinary
+
+Checks the header of a binary meta-data file and finds its sections.
+Each descriptor name in the file is looked up once here.
+
+@pre file is mapped and starts with META_MAGIC
+@post binary sections were found
+@return bool representing valid binary file
+*/
+bool MetaReader::openBinary()
+{
+   // initialize variables
+   const MetaDescriptor* descriptors;
+   unsigned int index;
+   size_t headerSize = sizeof( MetaHeader );
+
+   // version 1 header ends before arrival offset
+   if( memcmp( data, META_MAGIC_V1, META_MAGIC_LEN ) == 0 )
+   {
+      headerSize -= sizeof( uint64_t );
+   }
+
+   // check for complete header
+   if( size < headerSize )
+   {
+      return false;
+   }
+
+   memset( &header, 0, sizeof( MetaHeader ) );
+   memcpy( &header, data, headerSize );
+
+   // check each section fits in file (counts are compared with the room
+   // left after each offset, so a large count cannot wrap past the check)
+   if( header.recordSize != sizeof( MetaRecord ) ||
+       header.descriptorOffset > size || header.actionOffset > size || header.indexOffset > size ||
+       header.descriptorCount > sectionRoom( header.descriptorOffset, sizeof( MetaDescriptor ) ) ||
+       header.actionCount > sectionRoom( header.actionOffset, sizeof( MetaRecord ) ) ||
+       header.processCount >= sectionRoom( header.indexOffset, sizeof( uint64_t ) ) ||
+       header.actionOffset % sizeof( MetaRecord ) != 0 || header.indexOffset % sizeof( uint64_t ) != 0 )
+   {
+      return false;
+   }
+
+   if( header.arrivalOffset != 0 &&
+       ( header.arrivalOffset > size ||
+         header.processCount > sectionRoom( header.arrivalOffset, sizeof( uint32_t ) ) ||
+         header.arrivalOffset % sizeof( uint32_t ) != 0 ) )
+   {
+      return false;
+   }
+
+   records = reinterpret_cast<const MetaRecord*>( data + header.actionOffset );
+   processIndex = reinterpret_cast<const uint64_t*>( data + header.indexOffset );
+   arrivals = NULL;
+
+   if( header.arrivalOffset != 0 )
+   {
+      arrivals = reinterpret_cast<const uint32_t*>( data + header.arrivalOffset );
+   }
+
+   // look up descriptor table
+   descriptors = reinterpret_cast<const MetaDescriptor*>( data + header.descriptorOffset );
+   descriptorIDs.clear();
+
+   for( index = 0; index < header.descriptorCount; index++ )
+   {
+      descriptorIDs.push_back( findDescriptor( descriptors[ index ].name,
+                               strnlen( descriptors[ index ].name, META_NAME_LEN ) ) );
+   }
+
+   started = true;
+
+   return true;
+}
+
+/**
+sectionRoom
+
+Returns how many items of a binary section fit between its offset and
+the end of the file.
+
+@param offset file offset of section
+@param itemSize bytes in one item
+@pre offset is not past end of file
+@post none
+@return uint64_t with number of items that fit
+*/
+uint64_t MetaReader::sectionRoom( uint64_t offset, size_t itemSize )
+{
+   return ( size - offset ) / itemSize;
+}
+
+/**
+readBinaryProcesses
+
+Reads up to maxCount processes from a binary meta-data file.
+
+@param processes list to add processes to
+@param maxCount most processes to read (ALL_PROCESSES for no limit)
+@param cycleTimes cycle time of each descriptor, used for estimated run time
+@pre binary file was opened
+@post processes were added to list
+@return int with number of processes read, or -1 on error
+*/
+int MetaReader::readBinaryProcesses( list<PCB>& processes, int maxCount, const float* cycleTimes )
+{
+   // initialize variables
+   int readCount = 0;
+   uint64_t actionIndex;
+   uint64_t lastAction;
+   int tempDescriptorID;
+
+   // add processes until limit or last process
+   while( maxCount == ALL_PROCESSES || readCount < maxCount )
+   {
+      // check for last process
+      if( (uint64_t) processCount >= header.processCount )
+      {
+         ended = true;
+         break;
+      }
+
+      actionIndex = processIndex[ processCount ];
+      lastAction = processIndex[ processCount + 1 ];
+
+      // check for invalid index
+      if( actionIndex > lastAction || lastAction > header.actionCount )
+      {
+         return fail( "Error in meta-data. Process start/end failure. Please try again." );
+      }
+
+      addProcess( processes );
+
+      // check arrival order
+      if( arrivals != NULL && !setArrival( processes, arrivals[ processCount ] ) )
+      {
+         return -1;
+      }
+
+      // queue each process action
+      for( ; actionIndex < lastAction; actionIndex++ )
+      {
+         tempDescriptorID = NO_DESCRIPTOR;
+
+         if( records[ actionIndex ].descriptor < descriptorIDs.size() )
+         {
+            tempDescriptorID = descriptorIDs[ records[ actionIndex ].descriptor ];
+         }
+
+         if( !addAction( processes, records[ actionIndex ].actionType, tempDescriptorID,
+                         records[ actionIndex ].actionCycle, cycleTimes ) )
+         {
+            return -1;
+         }
+      }
+
+      endProcess( processes );
+      readCount++;
+
+      position = header.actionOffset + lastAction * sizeof( MetaRecord );
+   }
+
+   // give back pages already read
+   releasePages();
+
+   return readCount;
+}
+
+/**
+readTraceProcesses
+
+Reads up to maxCount processes from a CSV trace. Each burst becomes a P, I
+or O action with its duration rounded to whole cycles (at least one), and
+each process keeps its arrival time from the start of the trace.
+
+@param processes list to add processes to
+@param maxCount most processes to read (ALL_PROCESSES for no limit)
+@param cycleTimes cycle time of each descriptor, used to convert durations
+@pre trace file was opened
+@post processes were added to list
+@return int with number of processes read, or -1 on error
+*/
+int MetaReader::readTraceProcesses( list<PCB>& processes, int maxCount, const float* cycleTimes )
+{
+   // initialize variables
+   int readCount = 0;
+   size_t rowStart;
+   int tempPid;
+   int processPid;
+   int burstIndex;
+   int tempCycle;
+   double duration;
+   double arrival;
+   const TraceBurst* burst;
+
+   // add processes until limit or end of trace
+   while( maxCount == ALL_PROCESSES || readCount < maxCount )
+   {
+      // get first burst of process
+      if( !nextBurst( tempPid, burstIndex, duration, arrival ) )
+      {
+         if( error )
+         {
+            return -1;
+         }
+
+         ended = true;
+         break;
+      }
+
+      addProcess( processes );
+      processPid = tempPid;
+
+      // find arrival from start of trace (same as process before, if not given)
+      if( arrival != NO_ARRIVAL && traceStart == NO_ARRIVAL )
+      {
+         traceStart = arrival;
+      }
+
+      if( !setArrival( processes, arrival == NO_ARRIVAL ? lastArrival : arrival - traceStart ) )
+      {
+         return -1;
+      }
+
+      // add bursts until next process
+      while( true )
+      {
+         burst = &( TRACE_BURSTS[ burstIndex ] );
+
+         // convert duration to cycles
+         tempCycle = 0;
+
+         if( cycleTimes[ burst->descriptorID ] > 0 )
+         {
+            tempCycle = (int)( duration / cycleTimes[ burst->descriptorID ] + 0.5 );
+
+            if( tempCycle == 0 && duration > 0 )
+            {
+               tempCycle = 1;
+            }
+         }
+
+         // queue process action
+         if( !addAction( processes, burst->actionType, burst->descriptorID, tempCycle, cycleTimes ) )
+         {
+            return -1;
+         }
+
+         // check for end of trace or next process
+         rowStart = position;
+
+         if( !nextBurst( tempPid, burstIndex, duration, arrival ) )
+         {
+            if( error )
+            {
+               processes.pop_back();
+               return -1;
+            }
+
+            break;
+         }
+
+         if( tempPid != processPid )
+         {
+            position = rowStart;
+            break;
+         }
+      }
+
+      endProcess( processes );
+      readCount++;
+   }
+
+   // give back pages already parsed
+   releasePages();
+
+   return readCount;
+}
+
+/**
+nextBurst
+
+Reads the next burst of a CSV trace, skipping blank lines, comments and
+a header line at the start of the file. Errors are printed and end the
+reading.
+
+@param pid reference to save traced process ID to
+@param burstIndex reference to save index in TRACE_BURSTS to
+@param duration reference to save burst duration (msec) to
+@param arrival reference to save arrival time (msec) to, or NO_ARRIVAL
+@pre trace file was opened
+@post position is at end of burst's line
+@return bool representing a burst was read (false at end of trace or error)
+*/
+bool MetaReader::nextBurst( int& pid, int& burstIndex, double& duration, double& arrival )
+{
+   // initialize variables
+   const char* field;
+   size_t length;
+   size_t lineStart;
+   double value;
+   bool moreFields;
+
+   // skip blank lines, comments and header
+   while( true )
+   {
+      skipSpace();
+
+      // check for end of file
+      if( position >= size )
+      {
+         return false;
+      }
+
+      lineStart = position;
+
+      if( data[ position ] != '#' && ( lineStart > 0 || ( data[ position ] >= '0' && data[ position ] <= '9' ) ) )
+      {
+         break;
+      }
+
+      while( position < size && data[ position ] != '\n' )
+      {
+         position++;
+      }
+   }
+
+   // get process ID
+   moreFields = readField( field, length );
+
+   if( !moreFields || !parseNumber( field, length, value ) || value < 0 )
+   {
+      fail( "Error in meta-data. Unrecognized trace process ID found. Please try again." );
+      return false;
+   }
+
+   pid = (int) value;
+
+   // get burst type
+   moreFields = readField( field, length );
+
+   for( burstIndex = 0; burstIndex < TRACE_BURST_COUNT; burstIndex++ )
+   {
+      if( strncmp( field, TRACE_BURSTS[ burstIndex ].name, length ) == 0 &&
+          TRACE_BURSTS[ burstIndex ].name[ length ] == '\0' )
+      {
+         break;
+      }
+   }
+
+   if( !moreFields || burstIndex == TRACE_BURST_COUNT )
+   {
+      fail( "Error in meta-data. Unrecognized trace burst type found. Please try again." );
+      return false;
+   }
+
+   // get duration
+   moreFields = readField( field, length );
+
+   if( !parseNumber( field, length, duration ) || duration < 0 )
+   {
+      fail( "Error in meta-data. Unrecognized trace burst duration found. Please try again." );
+      return false;
+   }
+
+   // get arrival, if given
+   arrival = NO_ARRIVAL;
+
+   if( moreFields )
+   {
+      readField( field, length );
+
+      if( length > 0 && ( !parseNumber( field, length, arrival ) || arrival < 0 ) )
+      {
+         fail( "Error in meta-data. Unrecognized trace arrival time found. Please try again." );
+         return false;
+      }
+   }
+
+   // move to end of line (extra fields are ignored)
+   while( position < size && data[ position ] != '\n' )
+   {
+      position++;
+   }
+
+   return true;
+}
+
+/**
+readField
+
+Reads the next comma separated field of a trace line, without its
+surrounding spaces.
+
+@param field reference to save start of field to
+@param length reference to save number of characters in field to
+@pre trace file was opened
+@post position is after the field's ',' (or at end of line)
+@return bool representing another field follows on the line
+*/
+bool MetaReader::readField( const char*& field, size_t& length )
+{
+   // initialize variables
+   size_t fieldEnd;
+
+   // skip leading spaces
+   while( position < size && ( data[ position ] == ' ' || data[ position ] == '\t' ) )
+   {
+      position++;
+   }
+
+   field = data + position;
+
+   // find end of field
+   while( position < size && data[ position ] != ',' && data[ position ] != '\n' && data[ position ] != '\r' )
+   {
+      position++;
+   }
+
+   // remove trailing spaces
+   fieldEnd = position;
+
+   while( fieldEnd > (size_t)( field - data ) && ( data[ fieldEnd - 1 ] == ' ' || data[ fieldEnd - 1 ] == '\t' ) )
+   {
+      fieldEnd--;
+   }
+
+   length = fieldEnd - ( field - data );
+
+   // move past ','
+   if( position < size && data[ position ] == ',' )
+   {
+      position++;
+      return true;
+   }
+
+   return false;
+}
+
+/**
+setArrival
+
+Sets the arrival time of the last process in the list, checking that it
+does not arrive before the process read before it.
+
+@param processes list with process being read at end
+@param arrival arrival time (msec from start of run)
+@pre addProcess was called
+@post arrival was set, or process was removed and error was printed
+@return bool representing arrival is in order
+*/
+bool MetaReader::setArrival( list<PCB>& processes, double arrival )
+{
+   // check for process arriving before the one read before it
+   if( arrival < lastArrival )
+   {
+      processes.pop_back();
+      fail( "Error in meta-data. Process arrival times out of order. Please try again." );
+      return false;
+   }
+
+   lastArrival = arrival;
+
+   processes.back().arrivalTime = arrival / MSEC_PER_SEC;
+   processes.back().readySince = processes.back().arrivalTime;
+
+   return true;
+}
+
+/**
+addProcess
+
+Adds a new process with its start action to the end of the process list.
+
+@param processes list to add process to
+@pre none
+@post process is at end of list in Enter state
+@return PCB* pointer to new process
+*/
+PCB* MetaReader::addProcess( list<PCB>& processes )
+{
+   // initialize variables
+   Action tempAction;
+
+   // create process with pid equal to process number (in place, at end of list)
+   processes.emplace_back( processCount + 1 );
+
+   // queue start action
+   tempAction.actionType = 'A';
+   tempAction.descriptorID = DESC_START;
+   tempAction.actionCycle = 0;
+   tempAction.pcbID = processCount + 1;
+   processes.back().actions.push( tempAction );
+
+   return &( processes.back() );
+}
+
+/**
+addAction
+
+Checks a P, I, O or M action and queues it to the last process in the list.
+M(allocate) adds memory to the process, and M(access) must be to an address
+inside the memory allocated before it. On error, the unfinished process is removed.
+
+@param processes list with process being read at end
+@param type action type
+@param descriptorID action descriptor ID (NO_DESCRIPTOR if unrecognized)
+@param cycle action cycle count
+@param cycleTimes cycle time of each descriptor, used for estimated run time
+@pre addProcess was called
+@post action was queued, or error was printed
+@return bool representing valid action
+*/
+bool MetaReader::addAction( list<PCB>& processes, char type, int descriptorID, int cycle, const float* cycleTimes )
+{
+   // initialize variables
+   Action tempAction;
+   PCB* tempProcess = &( processes.back() );
+
+   // unrecognized action type
+   if( type != 'P' && type != 'I' && type != 'O' && type != 'M' )
+   {
+      processes.pop_back();
+      fail( "Error in meta-data. Unrecognized action found. Please try again." );
+      return false;
+   }
+
+   // check for invalid action data (cycle time or descriptor)
+   if( cycle < 0 )
+   {
+      processes.pop_back();
+      fail( "Error in meta-data. Unrecognized action cycle count found. Please try again." );
+      return false;
+   }
+   if( descriptorID < DESC_RUN || ( type == 'M' ) != ( descriptorID == DESC_ALLOCATE || descriptorID == DESC_ACCESS ) )
+   {
+      processes.pop_back();
+      fail( "Error in meta-data. Unrecognized action descriptor found. Please try again." );
+      return false;
+   }
+
+   // check for access outside allocated memory
+   if( descriptorID == DESC_ACCESS && cycle >= tempProcess->allocatedMemory )
+   {
+      processes.pop_back();
+      fail( "Error in meta-data. Memory access outside allocated memory found. Please try again." );
+      return false;
+   }
+
+   // queue process action
+   tempAction.actionType = type;
+   tempAction.descriptorID = descriptorID;
+   tempAction.actionCycle = cycle;
+   tempAction.pcbID = processCount + 1;
+   tempProcess->actions.push( tempAction );
+
+   // update estimated runtime (memory actions take at most one cycle)
+   if( type == 'M' )
+   {
+      tempProcess->estimatedRuntime += cycleTimes[ descriptorID ];
+
+      if( descriptorID == DESC_ALLOCATE )
+      {
+         tempProcess->allocatedMemory += cycle;
+      }
+   }
+   else
+   {
+      tempProcess->estimatedRuntime += ( cycle * cycleTimes[ descriptorID ] );
+   }
+
+   return true;
+}
+
+/**
+endProcess
+
+Queues the end action to the last process in the list and makes it Ready.
+
+@param processes list with process being read at end
+@pre addProcess was called
+@post process is in Ready state
+@return void
+*/
+void MetaReader::endProcess( list<PCB>& processes )
+{
+   // initialize variables
+   Action tempAction;
+
+   // queue end action to process
+   tempAction.actionType = 'A';
+   tempAction.descriptorID = DESC_END;
+   tempAction.actionCycle = 0;
+   tempAction.pcbID = processCount + 1;
+   processes.back().actions.push( tempAction );
+
+   // set process to ready state
+   processes.back().state = "Ready";
+
+   // increment successful process save
+   processCount++;
+}
+
+/**
+finished
+
+Returns true once there are no more processes to read.
+
+@pre none
+@post none
+@return bool representing reading is complete (or failed)
+*/
+bool MetaReader::finished()
+{
+   return ended || error;
+}
+
+/**
+failed
+
+Returns true if an error was found in the meta-data.
+
+@pre none
+@post none
+@return bool representing meta-data error
+*/
+bool MetaReader::failed()
+{
+   return error;
+}
+
+/**
+close
+
+Unmaps and closes the meta-data file.
+
+@pre none
+@post file is closed
+@return void
+*/
+void MetaReader::close()
+{
+   if( data != NULL )
+   {
+      munmap( const_cast<char*>( data ), size );
+      data = NULL;
+   }
+
+   records = NULL;
+   processIndex = NULL;
+   arrivals = NULL;
+   binary = false;
+   trace = false;
+
+   if( fileDescriptor >= 0 )
+   {
+      ::close( fileDescriptor );
+      fileDescriptor = -1;
+   }
+}
+
+/**
+nextAction
+
+Reads the next action, e.g. "P(run)11;". The descriptor is looked up,
+and the cycle count is INVALID_CYCLE if it is missing, or TOO_LARGE_CYCLE
+if it is above INT_MAX (both are rejected like any negative count).
+
+@param type reference to save action type to
+@param descriptorID reference to save descriptor ID to (NO_DESCRIPTOR if unrecognized)
+@param cycle reference to save cycle count to
+@pre file was opened
+@post position is after the action's ';' (or '.')
+@return bool representing an action was read (false at end of file)
+*/
+bool MetaReader::nextAction( char& type, int& descriptorID, int& cycle )
+{
+   // initialize variables
+   size_t descriptorStart;
+   bool negative = false;
+   bool hasDigits = false;
+   bool tooLarge = false;
+   int digit;
+
+   skipSpace();
+
+   // check for end of file
+   if( position >= size )
+   {
+      return false;
+   }
+
+   // get type
+   type = data[ position++ ];
+
+   // skip '('
+   if( position < size )
+   {
+      position++;
+   }
+
+   // get descriptor
+   descriptorStart = position;
+
+   while( position < size && data[ position ] != ')' )
+   {
+      position++;
+   }
+
+   descriptorID = findDescriptor( data + descriptorStart, position - descriptorStart );
+
+   // skip ')'
+   if( position < size )
+   {
+      position++;
+   }
+
+   // get cycle count
+   skipSpace();
+   cycle = 0;
+
+   if( position < size && data[ position ] == '-' )
+   {
+      negative = true;
+      position++;
+   }
+
+   while( position < size && data[ position ] >= '0' && data[ position ] <= '9' )
+   {
+      digit = data[ position ] - '0';
+
+      // stop at INT_MAX (rest of digits are skipped)
+      if( cycle > ( INT_MAX - digit ) / 10 )
+      {
+         tooLarge = true;
+      }
+      else if( !tooLarge )
+      {
+         cycle = cycle * 10 + digit;
+      }
+
+      hasDigits = true;
+      position++;
+   }
+
+   if( !hasDigits )
+   {
+      cycle = INVALID_CYCLE;
+   }
+   else if( tooLarge )
+   {
+      cycle = TOO_LARGE_CYCLE;
+   }
+   else if( negative )
+   {
+      cycle = -cycle;
+   }
+
+   // move past end of action
+   while( position < size && data[ position ] != ';' && data[ position ] != '.' )
+   {
+      position++;
+   }
+
+   if( position < size )
+   {
+      position++;
+   }
+
+   return true;
+}
+
+/**
+skipSpace
+
+Moves past spaces and line breaks.
+
+@pre file was opened
+@post position is at next non-space character or end of file
+@return void
+*/
+void MetaReader::skipSpace()
+{
+   while( position < size && ( data[ position ] == ' ' || data[ position ] == '\n' ||
+                               data[ position ] == '\r' || data[ position ] == '\t' ) )
+   {
+      position++;
+   }
+}
+
+/**
+releasePages
+
+Releases mapped pages that have already been parsed, once at least
+RELEASE_SIZE bytes are waiting, so they do not stay resident.
+
+@pre file was opened
+@post pages before the current page were released
+@return void
+*/
+void MetaReader::releasePages()
+{
+   // initialize variables
+   size_t pageSize = sysconf( _SC_PAGESIZE );
+   size_t releaseEnd = ( position / pageSize ) * pageSize;
+
+   // check for enough parsed data
+   if( data == NULL || releaseEnd < released + RELEASE_SIZE )
+   {
+      return;
+   }
+
+   madvise( const_cast<char*>( data ) + released, releaseEnd - released, MADV_DONTNEED );
+   released = releaseEnd;
+}
+
+/**
+fail
+
+Prints a meta-data error and stops reading.
+
+@param message error to print
+@pre none
+@post reader is marked failed
+@return int with -1 (error)
+*/
+int MetaReader::fail( const char* message )
+{
+   cout << message << endl;
+   error = true;
+
+   return -1;
+}
+
+// function implementation
+
+/**
+parseNumber
+
+Converts a trace field (not null terminated) to a number.
+
+@param field start of field
+@param length number of characters in field
+@param value reference to save number to
+@pre none
+@post none
+@return bool representing field is a number
+*/
+bool parseNumber( const char* field, size_t length, double& value )
+{
+   // initialize variables
+   char buffer[ MAX_NUMBER_LEN ];
+   char* numberEnd;
+
+   // check for empty or long field
+   if( length == 0 || length >= (size_t) MAX_NUMBER_LEN )
+   {
+      return false;
+   }
+
+   memcpy( buffer, field, length );
+   buffer[ length ] = '\0';
+
+   value = strtod( buffer, &numberEnd );
+
+   return numberEnd == buffer + length;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file   Meta_Reader.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Streaming meta-data reader header for Operating System simulator
+ */
+
+// definition
+   #ifndef __METAREADER_H_
+   #define __METAREADER_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include <string> // used for string operations
+   #include <list> // used to store processes
+   #include <vector> // used for descriptor table
+   #include <cstddef> // used for sizes
+   #include <stdint.h> // used for fixed-width binary fields
+
+   using namespace std;
+
+// global constants
+   const int ALL_PROCESSES = -1; // read every remaining process
+   const int META_NAME_LEN = 16; // characters in a binary descriptor name
+   const char META_MAGIC[] = "OSMETA02"; // first bytes of a binary meta-data file
+   const char META_MAGIC_V1[] = "OSMETA01"; // first bytes of a binary file without arrival times
+   const int META_MAGIC_LEN = 8;
+   const char TRACE_EXTENSION[] = ".csv"; // extension of a CSV trace file
+   const double NO_ARRIVAL = -1; // trace row without an arrival time
+   const double MSEC_PER_SEC = 1000; // arrival times are read in msec
+
+// global variables
+
+// class declaration
+
+// binary meta-data file layout (native byte order):
+//    MetaHeader
+//    MetaDescriptor[ descriptorCount ] at descriptorOffset
+//    MetaRecord[ actionCount ] at actionOffset (P, I, O and M actions only)
+//    uint64_t[ processCount + 1 ] at indexOffset (first action of each process)
+//    uint32_t[ processCount ] at arrivalOffset (arrival of each process, msec)
+// Files starting with META_MAGIC_V1 have no arrivalOffset in their header,
+// and every process arrives at the start of the run.
+class MetaHeader
+{
+   public:
+      char magic[ META_MAGIC_LEN ]; // META_MAGIC
+      uint32_t descriptorCount; // entries in descriptor table
+      uint32_t recordSize; // bytes in one MetaRecord
+      uint64_t processCount; // processes in file
+      uint64_t actionCount; // action records in file
+      uint64_t descriptorOffset; // file offset of descriptor table
+      uint64_t actionOffset; // file offset of action records
+      uint64_t indexOffset; // file offset of process index
+      uint64_t arrivalOffset; // file offset of arrival times (0 if none)
+};
+
+class MetaDescriptor
+{
+   public:
+      char name[ META_NAME_LEN ]; // descriptor name (null padded)
+};
+
+class MetaRecord
+{
+   public:
+      char actionType; // P, I, O or M
+      uint8_t descriptor; // index into descriptor table
+      uint16_t reserved; // always zero
+      int32_t actionCycle; // cycle count
+};
+
+// burst type of a CSV trace, and the action it becomes
+class TraceBurst
+{
+   public:
+      const char* name; // burst type in trace
+      char actionType; // P, I or O
+      int descriptorID; // action descriptor (DescriptorID)
+};
+
+// CSV trace layout, one burst per line (lines starting with '#', and a
+// header line, are skipped):
+//    pid,burst,duration[,arrival]
+// Bursts of a process are on consecutive lines; a new pid starts the next
+// process. Durations and arrivals are in msec, and arrivals may be given on
+// the first line of each process only. Processes must be in arrival order.
+//
+// In text meta-data the cycle count of a process start action is its
+// arrival time, in msec from the start of the run ("A(start)250;"). Here
+// too processes must be in arrival order, so the simulator can stop
+// reading at the first process that has not yet arrived.
+class MetaReader
+{
+   public:
+      MetaReader();
+      ~MetaReader();
+      bool open( const string& metaPath );
+      int readProcesses( list<PCB>& processes, int maxCount, const float* cycleTimes );
+      bool finished();
+      bool failed();
+      void close();
+   private:
+      bool openBinary();
+      uint64_t sectionRoom( uint64_t offset, size_t itemSize );
+      int readBinaryProcesses( list<PCB>& processes, int maxCount, const float* cycleTimes );
+      int readTraceProcesses( list<PCB>& processes, int maxCount, const float* cycleTimes );
+      bool nextBurst( int& pid, int& burstIndex, double& duration, double& arrival );
+      bool readField( const char*& field, size_t& length );
+      bool setArrival( list<PCB>& processes, double arrival );
+      bool nextAction( char& type, int& descriptorID, int& cycle );
+      void skipSpace();
+      PCB* addProcess( list<PCB>& processes );
+      bool addAction( list<PCB>& processes, char type, int descriptorID, int cycle, const float* cycleTimes );
+      void endProcess( list<PCB>& processes );
+      void releasePages();
+      int fail( const char* message );
+      const char* data; // mapped meta-data file
+      size_t size; // length of file
+      size_t position; // next character to read
+      size_t released; // pages before this offset were released
+      int fileDescriptor; // open meta-data file (-1 if closed)
+      int processCount; // processes read so far
+      bool started; // true once OS start action was read
+      bool ended; // true once OS end action was read
+      bool error; // true once an error was found
+      bool binary; // true if file is in binary format
+      bool trace; // true if file is a CSV trace
+      double traceStart; // arrival of first process in trace (msec, NO_ARRIVAL until read)
+      double lastArrival; // arrival of latest process read (msec from start of run)
+      MetaHeader header; // binary file header
+      const MetaRecord* records; // binary action records
+      const uint64_t* processIndex; // binary first action of each process
+      const uint32_t* arrivals; // binary arrival of each process (NULL if none)
+      vector<int> descriptorIDs; // binary descriptor table as descriptor IDs
+};
+
+#endif
@@ -8,6 +8,15 @@
 // header files
    #include "OS_Control_Block.h"
    #include "Process_Control_Block.h"
+   #include "Sim_Clock.h"
+   #include "Thread_Pool.h"
+   #include "IO_Device.h"
+   #include "Processor.h"
+   #include "Log_Writer.h"
+   #include "Meta_Reader.h"
+   #include "Run_Stats.h"
+   #include "Scheduling_Policy.h"
+   #include "Config_Table.h"
    #include <fstream> // used for file input
    #include <iostream> // used for I/O
    #include <string> // used for string operations
@@ -27,4 +36,23 @@
 // global variables
 
 // class implementation
-OSCB::OSCB() {}
+OSCB::OSCB()
+{
+   // initialize variables
+   int index;
+
+   for( index = 0; index < DESC_COUNT; index++ )
+   {
+      cycleTimes[ index ] = 0;
+   }
+
+   virtualTime = false;
+   tscClock = false;
+   deterministic = false;
+   policyID = NO_POLICY;
+   logMode = LOG_MONITOR;
+   currentQuantum = 0;
+   cpuBusyTime = 0;
+   processorCount = 1;
+   residentLimit = 0;
+}
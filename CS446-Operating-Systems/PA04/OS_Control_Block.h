@@ -11,6 +11,17 @@
 
 // header files
    #include "Process_Control_Block.h"
+   #include "Sim_Clock.h"
+   #include "Thread_Pool.h"
+   #include "IO_Device.h"
+   #include "Processor.h"
+   #include "Log_Writer.h"
+   #include "Meta_Reader.h"
+   #include "Run_Stats.h"
+   #include "Scheduling_Policy.h"
+   #include "Memory_Unit.h"
+   #include "Dispatch_Cost.h"
+   #include "Config_Table.h"
    #include <fstream> // used for file input
    #include <iostream> // used for I/O
    #include <string> // used for string operations
@@ -35,16 +46,37 @@ class OSCB
    friend class Action;   
    public:
       OSCB();
-      clock_t timer; // keeps track of time
-      map<string, float> cycleData; // cycles per action
+      SimClock simClock; // keeps track of time (real or virtual)
+      bool virtualTime; // true to run in simulated time instead of real time
+      bool tscClock; // true to read real time from the time stamp counter
+      bool deterministic; // true to run in simulated time one thread at a time (same log each run)
+      float cycleTimes[ DESC_COUNT ]; // cycle time of each descriptor (zero for start and end)
       float quantum; // holds quantum time value (number of cycles)
-      char logLocation; // location to log to
-      ofstream outputFile; // output file stream
+      int logMode; // where to log to (LogModeID)
+      LogWriter logWriter; // writes log lines to console and/or file
       string schedulingCode; // scheduling code  
+      int policyID; // scheduling policy of scheduling code
+      PolicySettings policySettings; // settings of scheduling policy (MLFQ levels)
       float phase; // value of current phase
+      string configPath; // filepath of configuration file (read again on reload)
+      ConfigTable config; // fields of configuration file
       string metaPath; // filepath of meta-data file
+      MetaReader metaReader; // reads processes from meta-data file
+      int residentLimit; // most processes loaded at once (0 for no limit)
       string logPath; // filepath to log to 
       Action* currentAction; // current action to complete
+      float currentQuantum; // time quantum of current action (cycles)
+      ThreadPool actionPool; // worker threads that run actions
+      IODevice devices[ DESC_COUNT ]; // I/O devices, indexed by descriptor (from FIRST_DEVICE)
+      IODevice arrivals; // returns processes to the scheduler at their arrival times
+      InterruptQueue interrupts; // processes whose I/O has completed (or that arrived)
+      double cpuBusyTime; // total time processors spent running actions
+      RunStats runStats; // times of each exited process
+      string statsPath; // filepath to save JSON statistics to (empty for none)
+      int processorCount; // number of simulated processors
+      ProcessorSet cpus; // simulated processors (when more than one)
+      MemoryUnit memory; // physical memory and page tables
+      DispatchCost dispatchCost; // time lost to dispatching processes
    private:
 };
 
@@ -16,11 +16,30 @@
  * Processes run with RR, FIFO-P, or SRTF-P scheduling, according to
  * configuration file. It also runs with previously impemented scheduling codes
  * FIFO, SJF, and SRTF, but time quantum is still required in config file. 
+ * I/O actions are run by a worker thread for each device, so the processor
+ * keeps running other processes while the blocked process waits on I/O.
+ * Processes can also run on several simulated processors at once, each
+ * with its own thread and run queue.
+ * Each process enters the Ready queue at its arrival time, given in the
+ * meta-data file or replayed from a recorded CSV trace.
+ * With the --virtual-time option, the simulator runs in simulated time,
+ * jumping from event to event instead of waiting on the processor clock.
+ * With the --sweep option, it runs many simulations at once in simulated
+ * time, one for each combination of settings in a grid file.
+ * With the --queue-bench option, it stress tests the lock-free ready ring
+ * used by the processors and compares its speed with a locked run queue.
+ * With the --dispatch-bench option, it times SRTF dispatches from the
+ * Ready heap and from a scan of the Ready list, from 10 Ready processes
+ * up to a million.
  */
 
 // header files
    #include "Process_Control_Block.h" 
    #include "OS_Control_Block.h"
+   #include "IO_Device.h"
+   #include "Run_Stats.h"
+   #include "Scheduling_Policy.h"
+   #include "Queue_Bench.h"
    #include <fstream> // used for file input
    #include <iostream> // used for I/O
    #include <string> // used for string operations
@@ -32,6 +51,13 @@
    #include <queue> // used to store process actions
    #include <algorithm> // used for finding min
    #include <pthread.h> // used for threads
+   #include <cstdlib> // used for string conversions
+   #include <vector> // used for binary meta-data index
+   #include <stdint.h> // used for binary meta-data fields
+   #include <unistd.h> // used to fork sweep runs
+   #include <sys/wait.h> // used to wait for sweep runs
+   #include <csignal> // used for hot reload signal
+   #include <climits> // used for setting limits
 
    using namespace std;
 
@@ -41,27 +67,90 @@
    const int SPACE_BUF = 1;
    const int OP_COUNT = 5;
    const int PRECISION = 6;
-   const float CYCLE_TO_MS = 0.001;
    const float VERSION_MIN = 0.0;
+   const int MAX_PROCESSORS = 1024;
+   const int META_BATCH_SIZE = 1024;
+   const int BENCH_MAX_THREADS = 64;
+   const int BENCH_HANDLES_PER_THREAD = 4;
+   const long BENCH_PASSES = 200000;
+   const long STRESS_PASSES = 100000;
+   const int DISPATCH_MIN_PROCESSES = 10;
+   const int DISPATCH_MAX_PROCESSES = 1000000;
+   const long DISPATCH_PASSES = 1000000;
+   const long SCAN_VISITS = 100000000; // processes visited by each scan timing
+   const int ACTION_WORKERS = 1; // actions of the running process run one at a time, in order
 
 // global variables
+   volatile sig_atomic_t reloadRequested = 0; // set by SIGHUP until configuration is reloaded
 
 // function prototypes
 
    // save data functions
    bool saveConfig( char* configPath, OSCB &simulatorConfig );
+   bool readConfig( istream& configFile, OSCB &simulatorConfig );
+   void addConfigFields( OSCB &simulatorConfig );
+   bool reloadConfig( OSCB &simulatorConfig );
+   void requestReload( int signalNumber );
+   void installReload();
+   void printConfigError( OSCB &simulatorConfig );
    int saveMetaData( OSCB &simulatorConfig, list<PCB>& processes );
+   void loadProcesses( OSCB &simulatorConfig, list<PCB>& processes, int residentCount );
+   void loadArrivals( OSCB &simulatorConfig, list<PCB>& newProcesses, list<PCB>& arrivingQueue );
+   int findProcessLimit( OSCB &simulatorConfig );
+   bool readsByArrival( OSCB &simulatorConfig );
+   bool setPolicySettings( OSCB &simulatorConfig );
+   bool compileMetaData( char* textPath, char* binaryPath );
+
+   // parameter sweep functions
+   int runSweep( char* configPath, char* gridPath, char* resultsPath );
+   bool readGrid( char* gridPath, vector<string>& keys, vector< vector<string> >& values );
+   string applyOverrides( const string& configText, const vector<string>& keys, const vector<string>& settings );
+
+   // queue benchmark functions
+   int runQueueBench( int maxThreads );
+   int runDispatchBench( int maxProcesses );
+   string runSweepPoint( const string& configText );
 
    // process simulating functions
    void runProcesses( OSCB &simulatorConfig, list<PCB>& processes ); 
+   template <class Policy> int runPolicy( OSCB &simulatorConfig, list<PCB>& processes );
    void threadActions( OSCB &simulatorConfig, PCB& process );
-   float threadActionQuantum( OSCB &simulatorConfig, list<PCB> &runningQueue );
+   float threadActionQuantum( OSCB &simulatorConfig, list<PCB> &runningQueue, float quantum );
    void *runner( void *simulatorVoidPtr ); 
    void *quantumRunner( void* simulatorVoidPtr );  
+   double runAction( OSCB* simulatorPtr, Action* currentAction );
+   double runActionQuantum( OSCB* simulatorPtr, Action* currentAction, float quantum );
+   float findRunCycles( const Action& currentAction, float quantum );
+   double runMemoryAction( OSCB* simulatorPtr, Action* currentAction );
+   double chargeDispatch( OSCB* simulatorPtr, int processor, PCB& process );
+
+   // I/O device functions
+   bool startIO( OSCB &simulatorConfig, list<PCB> &runningQueue, list<PCB> &blockedQueue );
+   int prepareIO( OSCB &simulatorConfig, PCB& process, IORequest& newRequest );
+   template <class Policy> void handleInterrupts( OSCB &simulatorConfig, list<PCB> &readyQueue, list<PCB> &blockedQueue, list<PCB> &arrivingQueue, Policy& policy );
+   void *deviceRunner( void* deviceVoidPtr );
+   void *arrivalRunner( void* deviceVoidPtr );
+   void holdArrivals( OSCB &simulatorConfig, list<PCB>& newProcesses, list<PCB>& arrivingQueue );
+   list<PCB>::iterator findReadyPosition( OSCB &simulatorConfig, list<PCB> &readyQueue, const PCB& process );
+
+   // multiple processor functions
+   int runMultiCore( OSCB &simulatorConfig, list<PCB>& processes );
+   void *processorRunner( void* processorVoidPtr );
+   void *ringRunner( void* processorVoidPtr );
+   list<PCB>* findWork( OSCB &simulatorConfig, Processor& currentProcessor );
+   list<PCB>::iterator selectProcess( OSCB &simulatorConfig, list<PCB>& readyQueue );
+   void requeueInterrupts( OSCB &simulatorConfig );
+   float runProcessQuantum( OSCB* simulatorPtr, PCB& process, double& busyTime );
+   bool isPreemptive( int policyID );
+   bool isOrderedPolicy( int policyID );
 
    // helper functions
    void printAction( OSCB* simulatorPtr, stringstream& actionOutput ); 
+   void waitForTime( OSCB* simulatorPtr, int64_t endTime );
+   void printStatistics( OSCB* simulatorPtr, int completedProcesses );
+   bool saveStatistics( OSCB* simulatorPtr, int completedProcesses );
    bool compareRuntimes( const PCB& first, const PCB& second );    
+   float getCycleTime( OSCB* simulatorPtr, int descriptorID );
 
 // main program
 int main( int argc, char* argv[] )
@@ -70,14 +159,80 @@ int main( int argc, char* argv[] )
    OSCB simulatorConfig;
    bool saveSucess;
    int processCount = 0;
+   int argIndex;
+   char* configPath = NULL;
    list<PCB> processes;
 
    // STATE: Enter/Start
 
       // read in configuration file
 
+         // check for meta-data compile option
+         if( argc == 4 && strcmp( argv[ 1 ], "--compile-meta" ) == 0 )
+         {
+            // return result of compile
+            return compileMetaData( argv[ 2 ], argv[ 3 ] ) ? 0 : 1;
+         }
+
+         // check for parameter sweep option
+         if( ( argc == 4 || argc == 5 ) && strcmp( argv[ 1 ], "--sweep" ) == 0 )
+         {
+            // return result of sweep
+            return runSweep( argv[ 2 ], argv[ 3 ], argc == 5 ? argv[ 4 ] : NULL );
+         }
+
+         // check for queue benchmark option
+         if( ( argc == 2 || argc == 3 ) && strcmp( argv[ 1 ], "--queue-bench" ) == 0 )
+         {
+            // return result of benchmark
+            return runQueueBench( argc == 3 ? atoi( argv[ 2 ] ) : BENCH_MAX_THREADS );
+         }
+
+         // check for dispatch benchmark option
+         if( ( argc == 2 || argc == 3 ) && strcmp( argv[ 1 ], "--dispatch-bench" ) == 0 )
+         {
+            // return result of benchmark
+            return runDispatchBench( argc == 3 ? atoi( argv[ 2 ] ) : DISPATCH_MAX_PROCESSES );
+         }
+
+         // read in arguments
+         for( argIndex = 1; argIndex < argc; argIndex++ )
+         {
+            // check for virtual time option
+            if( strcmp( argv[ argIndex ], "--virtual-time" ) == 0 )
+            {
+               simulatorConfig.virtualTime = true;
+            }
+
+            // check for deterministic option (implies virtual time)
+            else if( strcmp( argv[ argIndex ], "--deterministic" ) == 0 )
+            {
+               simulatorConfig.virtualTime = true;
+               simulatorConfig.deterministic = true;
+            }
+
+            // check for time stamp counter clock option
+            else if( strcmp( argv[ argIndex ], "--tsc-clock" ) == 0 )
+            {
+               simulatorConfig.tscClock = true;
+            }
+
+            // otherwise save configuration path
+            else if( configPath == NULL )
+            {
+               configPath = argv[ argIndex ];
+            }
+
+            // extra argument given
+            else
+            {
+               configPath = NULL;
+               break;
+            }
+         }
+
          // check for incorrect arguments 
-         if( argc != 2 )
+         if( configPath == NULL )
          {
             // print failure 
             cout << "Incorrect arguments given. Please try again." << endl;
@@ -87,18 +242,38 @@ int main( int argc, char* argv[] )
          }
 
          // save configuration information
-         saveSucess = saveConfig( argv[1], simulatorConfig );
+         saveSucess = saveConfig( configPath, simulatorConfig );
 
          // check for failed save
          if( !saveSucess )
          {
             // print failure
-            cout << "Error in configuration file. Please try again." << endl;
+            printConfigError( simulatorConfig );
+
+            // return failure
+            return 1;
+         }
+
+         // check for deterministic run on several processors
+         if( simulatorConfig.deterministic && simulatorConfig.processorCount > 1 )
+         {
+            // print failure
+            cout << "Deterministic mode runs on one processor. Please try again." << endl;
 
             // return failure
             return 1;
          }
 
+         // reload cycle times, quantum and dispatch costs on SIGHUP (only
+         // the single processor dispatch loop checks for a reload, so with
+         // several processors SIGHUP keeps its default action)
+         simulatorConfig.configPath = configPath;
+
+         if( simulatorConfig.processorCount == 1 )
+         {
+            installReload();
+         }
+
       // read in meta-data
       processCount = saveMetaData( simulatorConfig, processes );
 
@@ -114,30 +289,38 @@ int main( int argc, char* argv[] )
       // prepare for output 
 
          // for file output 
-         if( simulatorConfig.logLocation != 'M' )
+         if( simulatorConfig.logMode == LOG_MONITOR )
          {
-            // open log file 
-            simulatorConfig.outputFile.open( simulatorConfig.logPath, ofstream::out | ofstream::trunc );
+            simulatorConfig.logPath.clear();
+         }
 
-            // check for valid file
-            if( !simulatorConfig.outputFile.is_open() )
-            {
-               // print failure 
-               cout << "Error in log file. Please try again." << endl;
+         // start log writer thread (opens log file)
+         if( !simulatorConfig.logWriter.start( simulatorConfig.logMode != LOG_FILE, simulatorConfig.logPath ) )
+         {
+            // print failure 
+            cout << "Error in log file. Please try again." << endl;
 
-               // return failure
-               return 1;
-            }
+            // return failure
+            return 1;
          }
 
+      // start action worker threads
+      simulatorConfig.actionPool.start( ACTION_WORKERS );
+
       // run simulator
       runProcesses( simulatorConfig, processes );
 
-      // for file output
-      if( simulatorConfig.logLocation != 'M' )
+      // end action worker threads
+      simulatorConfig.actionPool.stop();
+
+      // write remaining log lines and close file
+      simulatorConfig.logWriter.stop();
+
+      // check for meta-data error found while running
+      if( simulatorConfig.metaReader.failed() )
       {
-         // close file
-         simulatorConfig.outputFile.close();      
+         // return failure
+         return 1;
       }
 
    // STATE: Exit
@@ -146,1141 +329,3534 @@ int main( int argc, char* argv[] )
       return 0;
 }
 
-
-// function implementation 
-
 /**
-saveConfig
+runQueueBench
 
-Saves configuration file information.
-First, opens file for input and ensures that it is valid.
-Ignores information where appropriate and saves information to
-appropriate location. Any errors in reading in data will cause 
-false to be returned. Valid data returns true. 
+Stress tests the lock-free ready ring, then prints the queue operations
+per second of the ring and of a run queue guarded by a mutex, for 1, 2,
+4, ... threads up to the given count. Each thread pops a process handle
+and pushes it back; the queues hold a few handles for each thread.
 
-@param configPath holds path to configuration file
-@param simulatorConfig reference to OSCB object holding all config info
-@pre configPath was passed to program
-@post configuration information saved or error returned
-@return bool representing sucessful saving of configuration
+@param maxThreads most threads to run at once
+@pre none
+@post results were printed
+@return int with exit status (1 if stress test failed)
 */
-bool saveConfig( char* configPath, OSCB &simulatorConfig )
+int runQueueBench( int maxThreads )
 {
    // initialize variables
-   ifstream configFile;
-   float tempTime;
-   string tempPath;
-
-   // read in file
-
-      // open file
-      configFile.open(configPath, ifstream::in);
-
-         // check for open failure
-         if( !configFile.is_open() )
-         {
-            // return failure
-            return false;
-         }
-
-      // ignore start line
-      configFile.ignore( STD_LINE_LEN, '\n' );
-
-      // read in version
-      configFile.ignore( STD_LINE_LEN, ':' );
-      configFile >> simulatorConfig.phase;
-
-         // check for invalid version
-         if( simulatorConfig.phase < VERSION_MIN )
-         {
-            // return failure
-            return false;
-         }
-
-      // read in meta-data filepath
-      configFile.ignore( STD_LINE_LEN, ':' );
-      configFile.ignore( SPACE_BUF, ' ' );
-      configFile >> simulatorConfig.metaPath;
+   QueueBench bench;
+   double ringRate;
+   double listRate;
+   int threadCount;
+   bool passed = true;
+
+   // check for invalid thread count
+   if( maxThreads < 1 )
+   {
+      cout << "Incorrect arguments given. Please try again." << endl;
 
-      // read in scheduling code 
-      configFile.ignore( STD_LINE_LEN, ':' );
-      configFile.ignore( SPACE_BUF, ' ' );
-      configFile >> simulatorConfig.schedulingCode;  
+      return 1;
+   }
 
-         // check for invalid scheduling code
-         if( simulatorConfig.schedulingCode != "FIFO-P" && simulatorConfig.schedulingCode != "RR"
-             && simulatorConfig.schedulingCode != "SRTF-P" && simulatorConfig.schedulingCode != "SRTF"
-             && simulatorConfig.schedulingCode != "SJF" && simulatorConfig.schedulingCode != "FIFO" )
-         {
-            // return failure
-            return false;
-         }
+   cout.precision( 0 );
+   cout << fixed;
 
-      // read in quantum time
-      configFile.ignore( STD_LINE_LEN, ':' );
-      configFile.ignore( SPACE_BUF, ' ' );
-      configFile >> simulatorConfig.quantum;  
+   // stress test ring
+   for( threadCount = 1; threadCount <= maxThreads; threadCount *= 2 )
+   {
+      if( !bench.stressRing( threadCount, threadCount * BENCH_HANDLES_PER_THREAD, STRESS_PASSES / threadCount ) ||
+          !bench.stressRing( threadCount, 1, STRESS_PASSES / threadCount ) )
+      {
+         cout << "Stress test failed with " << threadCount << " threads" << endl;
+         passed = false;
+      }
+   }
 
-         // check for invalid quantum time
-         if( simulatorConfig.quantum <= 0 )
-         {
-            // return failure
-            return false;
-         }        
+   if( passed )
+   {
+      cout << "Stress test passed (no handle duplicated or lost)" << endl;
+   }
 
-      // read in cycle data
+   // compare queues
+   cout << "threads\tring ops/s\tlocked ops/s\tspeedup" << endl;
 
-         // read in processor cycle time
-         configFile.ignore( STD_LINE_LEN, ':' );
-         configFile >> tempTime;
+   for( threadCount = 1; threadCount <= maxThreads; threadCount *= 2 )
+   {
+      ringRate = bench.timeRing( threadCount, threadCount * BENCH_HANDLES_PER_THREAD, BENCH_PASSES / threadCount );
+      listRate = bench.timeLockedList( threadCount, threadCount * BENCH_HANDLES_PER_THREAD, BENCH_PASSES / threadCount );
 
-            // check for valid time
-            if( tempTime >= 0 )
-            {
-               simulatorConfig.cycleData[ "run" ] = tempTime;
-            }
+      cout << threadCount << "\t" << ringRate << "\t" << listRate << "\t";
+      cout.precision( 2 );
+      cout << ( listRate > 0 ? ringRate / listRate : 0 ) << endl;
+      cout.precision( 0 );
+   }
 
-         // read in monitor display time
-         configFile.ignore( STD_LINE_LEN, ':' );
-         configFile >> tempTime;
+   return passed ? 0 : 1;
+}
 
-            // check for valid time
-            if( tempTime >= 0 )
-            {
-               simulatorConfig.cycleData[ "monitor" ] = tempTime;
-            }
+/**
+runDispatchBench
 
-         // read in hard drive cycle time
-         configFile.ignore( STD_LINE_LEN, ':' );
-         configFile >> tempTime;
+Prints the time of an SRTF dispatch from the Ready heap and from a scan
+of the Ready list, for 10, 100, 1000, ... Ready processes up to the given
+count. Each scan timing visits about the same number of processes, so
+large queues are timed over fewer dispatches.
 
-            // check for valid time
-            if( tempTime >= 0 )
-            {
-               simulatorConfig.cycleData[ "hard drive" ] = tempTime;
-            }
-        
-         // read in printer cycle time 
-         configFile.ignore( STD_LINE_LEN, ':' );
-         configFile >> tempTime;
+@param maxProcesses most Ready processes
+@pre none
+@post results were printed
+@return int with exit status
+*/
+int runDispatchBench( int maxProcesses )
+{
+   // initialize variables
+   QueueBench bench;
+   double heapTime;
+   double scanTime;
+   long processCount;
 
-            // check for valid time
-            if( tempTime >= 0 )
-            {
-               simulatorConfig.cycleData[ "printer" ] = tempTime;
-            }
-        
-         // read in keyboard cycle time
-         configFile.ignore( STD_LINE_LEN, ':' );
-         configFile >> tempTime;
+   // check for invalid process count
+   if( maxProcesses < DISPATCH_MIN_PROCESSES )
+   {
+      cout << "Incorrect arguments given. Please try again." << endl;
 
-            // check for valid time
-            if( tempTime >= 0 )
-            {
-               simulatorConfig.cycleData[ "keyboard" ] = tempTime;
-            }
-         
-      // ignore until after "Log to "
-      configFile.ignore( STD_LINE_LEN, ':' );
-      configFile.ignore( STD_LINE_LEN, ' ' );
-      configFile.ignore( STD_LINE_LEN, ' ' );
-      configFile.ignore( STD_LINE_LEN, ' ' );
-      
-      // read in log location
-      configFile >> simulatorConfig.logLocation;
+      return 1;
+   }
 
-         // check for unrecognized location
-         if( simulatorConfig.logLocation != 'M' && simulatorConfig.logLocation != 'B' && simulatorConfig.logLocation != 'F' )
-         { 
-            return false;
-         }
+   cout.precision( 1 );
+   cout << fixed;
 
-      // read in log file path
-      if( simulatorConfig.logLocation  != 'M' )
-      {
-         configFile.ignore( STD_LINE_LEN, '\n' );
-         configFile.ignore( STD_LINE_LEN, ':' );
-         configFile.ignore( SPACE_BUF, ' ' );
-         configFile >> simulatorConfig.logPath;
-      }
+   cout << "processes\theap ns/dispatch\tscan ns/dispatch\tspeedup" << endl;
 
-   // close file
-   configFile.close();
+   for( processCount = DISPATCH_MIN_PROCESSES; processCount <= maxProcesses; processCount *= 10 )
+   {
+      heapTime = bench.timeHeapDispatch( processCount, DISPATCH_PASSES );
+      scanTime = bench.timeScanDispatch( processCount, max( 1L, SCAN_VISITS / processCount ) );
 
-   // check for save failure
-   if( simulatorConfig.cycleData.size() != OP_COUNT || configFile.eof() )
-   { 
-      return false;
+      cout << processCount << "\t" << heapTime << "\t" << scanTime << "\t";
+      cout << ( heapTime > 0 ? scanTime / heapTime : 0 ) << endl;
    }
 
-   // return sucess
-   return true;
-
+   return 0;
 }
 
+
+// function implementation 
+
 /**
-saveMetaData
+saveConfig
 
-Saves meta-data file information.
+Saves configuration file information.
 First, opens file for input and ensures that it is valid.
 Ignores information where appropriate and saves information to
-appropriate location. Each process is added to a process queue 
-and actions within each process are sent into a process control
-block and into a queue within the PCB. The number of seperate
-process programs is returned. An error results in -1 being returned.
+appropriate location. Any errors in reading in data will cause 
+false to be returned. Valid data returns true. 
 
-@param simulatorConfig holds all configuration info to use, including meta-data info
-@param process process control block queue with process information
-@pre valid config information was saved
+@param configPath holds path to configuration file
+@param simulatorConfig reference to OSCB object holding all config info
+@pre configPath was passed to program
 @post configuration information saved or error returned
-@return int representing number of processes saved
+@return bool representing sucessful saving of configuration
 */
-int saveMetaData( OSCB &simulatorConfig, list<PCB>& processes )
+bool saveConfig( char* configPath, OSCB &simulatorConfig )
 {
    // initialize variables
-   int processCount = 0;
-   ifstream metaFile;
-   char tempType;
-   string tempDescriptor;
-   int tempCycle;
-   Action tempAction;
+   ifstream configFile;
+   bool saveSucess;
+
+   // open file
+   configFile.open(configPath, ifstream::in);
 
-   // open meta-data file
-   metaFile.open( simulatorConfig.metaPath, ifstream::in );
-         
       // check for open failure
-      if( !metaFile.is_open() )
+      if( !configFile.is_open() )
       {
-         // print failure
-         cout << "Error in meta-data file. Please try again." << endl;
-
-         // return invalid meta-data
-         return -1;
-      }   
-
-   // read in meta-data
-
-      // read in start
-      metaFile.ignore( STD_LINE_LEN, '\n' );
-      
-         // get OS start action
-         metaFile.get( tempType );
+         // return failure
+         return false;
+      }
 
-         // check for invalid OS start
-         if( tempType != 'S' )
-         {
-            // print failure
-            cout << "Error in meta-data. OS start failure. Please try again." << endl;      
+   // read in configuration
+   saveSucess = readConfig( configFile, simulatorConfig );
 
-            // return invalid meta-data
-            return -1;
-         }
+   // close file
+   configFile.close();
 
-         // skip first line
-         metaFile.ignore( STD_LINE_LEN, ';' );
-         metaFile.ignore( SPACE_BUF, ' ' );    
+   return saveSucess;
+}
 
-      // get process start action
-      metaFile.get( tempType );
+/**
+readConfig
 
-      // add processes until end of file or end simulation command
-      while( metaFile.good() && tempType != 'S' )
-      {
-         // recognized start action
-         if( tempType == 'A' )
-         {
-            // create process
+Reads configuration information from a stream (an open configuration
+file, or configuration text built by a parameter sweep) through the
+configuration table, then checks settings that depend on each other.
+The error found, if any, is saved in the table.
 
-               // create process with pid equal to process number
-               PCB *tempProcess = new PCB( processCount+1 );
+@param configFile stream positioned at start of configuration
+@param simulatorConfig OSCB to save configuration to
+@pre none
+@post configuration was saved, or false was returned
+@return bool representing configuration was valid
+*/
+bool readConfig( istream& configFile, OSCB &simulatorConfig )
+{
+   // initialize variables
+   ConfigTable& config = simulatorConfig.config;
 
-               // set process to enter state 
-               tempProcess->state = "Enter";
+   // read in file
+   addConfigFields( simulatorConfig );
 
-               // queue start action
-               tempAction.actionType = tempType;
-               tempAction.actionDescriptor = "start";
-               tempAction.actionCycle = 0;
-               tempAction.pcbID = processCount + 1;
-               tempProcess->actions.push( tempAction );
+   if( !config.read( configFile ) )
+   {
+      // return failure
+      return false;
+   }
 
-            // move to next action
-            metaFile.ignore( STD_LINE_LEN, ';' );
-            metaFile.ignore( SPACE_BUF, ' ' ); 
+   simulatorConfig.schedulingCode = POLICY_NAMES[ simulatorConfig.policyID ];
 
-            // get next action
-            metaFile.get( tempType );
+   // check for missing log file path
+   if( simulatorConfig.logMode != LOG_MONITOR && !config.isGiven( "Log File Path" ) )
+   {
+      // return failure
+      return config.reject( "Log File Path", "is missing" );
+   }
 
-               // ignore space
-               if( tempType == ' ' || tempType == '\n' )
-               {
-                  metaFile.get( tempType );
-               }             
+   // check for lock-free ring with a scheduling code that orders its
+   // queue (the ring only keeps first-in first-out order)
+   simulatorConfig.cpus.setQueueMode();
 
-            // until end of action
-            while( tempType != 'A' )
-            {
-               // recognized actions
-               if( tempType == 'P' || tempType == 'I' || tempType == 'O' )
-               {
-                  // save meta-data for process action
-                  metaFile.ignore( SPACE_BUF, '(' );
-                  getline( metaFile, tempDescriptor, ')' );
-                  metaFile >> tempCycle; 
-
-                     // check for invalid action data (cycle time or descriptor)
-                     if( tempCycle < 0 )
-                     {
-                        // print failure
-                        cout << "Error in meta-data. Unrecognized action cycle count found. Please try again." << endl;
-
-                        // return no saved processes
-                        return -1;                        
-                     } 
-                     if( tempDescriptor != "monitor" && tempDescriptor != "keyboard" &&
-                         tempDescriptor != "run" && tempDescriptor != "hard drive" &&
-                         tempDescriptor != "printer" )
-                     {
-                        // print failure
-                        cout << "Error in meta-data. Unrecognized action descriptor found. Please try again." << endl;
-
-                        // return no saved processes
-                        return -1;                        
-                     }
-
-                  // save data to temp process               
-                  tempAction.actionType = tempType;
-                  tempAction.actionDescriptor = tempDescriptor;
-                  tempAction.actionCycle = tempCycle;
-                  tempAction.pcbID = processCount + 1;
-
-                  // queue process action 
-                  tempProcess->actions.push( tempAction ); 
-
-                  // update estimated runtime
-                  tempProcess->estimatedRuntime += ( tempCycle * simulatorConfig.cycleData[ tempDescriptor ] );
-               }
-
-               // unrecognized action type
-               else 
-               {
-                  // print failure
-                  cout << "Error in meta-data. Unrecognized action found. Please try again." << endl;
-
-                  // return no saved processes
-                  return -1;
-               }
-
-               // move to next action
-               metaFile.ignore( STD_LINE_LEN, ';' );
-               metaFile.ignore( SPACE_BUF, ' ' ); 
-
-               // save next action
-               metaFile.get( tempType );  
-
-                  // ignore space
-                  if( tempType == ' ' || tempType == '\n' )
-                  {
-                     metaFile.get( tempType );
-                  }                                
-            }
+   if( simulatorConfig.cpus.lockFree && isOrderedPolicy( simulatorConfig.policyID ) )
+   {
+      // return failure
+      return config.reject( "Run queues", "cannot be Lock-free with " + simulatorConfig.schedulingCode );
+   }
 
-            // end action
-            if( tempType == 'A' )
-            {
-               // queue end action to process
-               tempAction.actionType = tempType;
-               tempAction.actionDescriptor = "end";
-               tempAction.actionCycle = 0;
-               tempAction.pcbID = processCount + 1;
-               tempProcess->actions.push( tempAction );
-
-               // increment successful process save
-               processCount++;  
-
-               // set process to ready state 
-               tempProcess->state = "Ready";
-
-               // add process to list
-               processes.push_back( *tempProcess );
-
-                  // delete temporary process
-                  delete tempProcess;
-                  tempProcess = '\0';               
-
-               // move to next action
-               metaFile.ignore( STD_LINE_LEN, ';' );
-               metaFile.ignore( SPACE_BUF, ' ' ); 
-
-               // get next action
-               metaFile.get( tempType );   
-
-                  // ignore space
-                  if( tempType == ' ' || tempType == '\n' )
-                  {
-                     metaFile.get( tempType );
-                  } 
-            }
-         }
+   // check for a scheduling code the processors cannot run (each processor
+   // runs every process for the time quantum, in first-in first-out order)
+   if( simulatorConfig.processorCount > 1 &&
+       ( simulatorConfig.policyID == POLICY_MLFQ || simulatorConfig.policyID == POLICY_CFS ) )
+   {
+      // return failure
+      return config.reject( "CPU Scheduling", "cannot be " + simulatorConfig.schedulingCode + " with more than one processor" );
+   }
 
-         // unrecognized start action
-         else
-         {
-            // print failure
-            cout << "Error in meta-data. Process start/end failure. Please try again." << endl;
+   // set up memory (an access takes one processor cycle)
+   simulatorConfig.memory.configure( simulatorConfig.memory.frameCount, simulatorConfig.memory.pageSize, simulatorConfig.memory.replacement );
+   simulatorConfig.cycleTimes[ DESC_ALLOCATE ] = 0;
+   simulatorConfig.cycleTimes[ DESC_ACCESS ] = simulatorConfig.cycleTimes[ DESC_RUN ];
 
-            // return no saved processes
-            return -1;
-         }
-      }
+   // set policy settings not given in configuration file
+   if( !setPolicySettings( simulatorConfig ) )
+   {
+      // return failure
+      return false;
+   }
 
-      // check for invalid end action
-      if( tempType != 'S' )
-      {
-         // print failure
-         cout << "Error in meta-data. OS end failure. Please try again." << endl;      
+   // return sucess
+   return true;
+}
 
-         // return invalid simulation end
-         return -1;
-      }
+/**
+addConfigFields
 
-   // close meta-data file
-   metaFile.close();
+Adds each setting of the configuration file to the configuration table,
+with its type, the values it allows and where it is saved. Settings that
+are not required keep the defaults set by the OSCB. Cycle times, the
+time quantum and dispatch costs can be reloaded while the simulator runs.
 
-   // return process count
-   return processCount;
+@param simulatorConfig OSCB whose table is filled and whose members are saved to
+@pre none
+@post table holds every setting
+@return void
+*/
+void addConfigFields( OSCB &simulatorConfig )
+{
+   // initialize variables
+   ConfigTable& config = simulatorConfig.config;
+
+   config.clear();
+
+   // required settings
+   config.addFloat( "Version/Phase", &simulatorConfig.phase, VERSION_MIN, false, true, false );
+   config.addText( "File Path", &simulatorConfig.metaPath, true );
+   config.addChoice( "CPU Scheduling", &simulatorConfig.policyID, POLICY_NAMES, POLICY_COUNT, true );
+   config.addFloat( "Quantum time (cycles)", &simulatorConfig.quantum, 0, true, true, true );
+   config.addFloat( "Processor cycle time (msec)", &simulatorConfig.cycleTimes[ DESC_RUN ], 0, false, true, true );
+   config.addFloat( "Monitor display time (msec)", &simulatorConfig.cycleTimes[ DESC_MONITOR ], 0, false, true, true );
+   config.addFloat( "Hard drive cycle time (msec)", &simulatorConfig.cycleTimes[ DESC_HARD_DRIVE ], 0, false, true, true );
+   config.addFloat( "Printer cycle time (msec)", &simulatorConfig.cycleTimes[ DESC_PRINTER ], 0, false, true, true );
+   config.addFloat( "Keyboard cycle time (msec)", &simulatorConfig.cycleTimes[ DESC_KEYBOARD ], 0, false, true, true );
+   config.addChoice( "Log", &simulatorConfig.logMode, LOG_MODE_NAMES, LOG_MODE_COUNT, true );
+   config.addText( "Log File Path", &simulatorConfig.logPath, false );
+
+   // optional settings
+   config.addInt( "Processor count", &simulatorConfig.processorCount, 1, MAX_PROCESSORS, false );
+   config.addChoice( "Run queues", &simulatorConfig.cpus.queueMode, QUEUE_MODE_NAMES, QUEUE_MODE_COUNT, false );
+   config.addText( "Statistics file", &simulatorConfig.statsPath, false );
+   config.addInt( "Resident processes", &simulatorConfig.residentLimit, 0, INT_MAX, false );
+   config.addInt( "MLFQ levels", &simulatorConfig.policySettings.levelCount, 1, INT_MAX, false );
+   config.addList( "MLFQ quantum (cycles)", &simulatorConfig.policySettings.levelQuanta, 0, true );
+   config.addFloat( "MLFQ boost time (msec)", &simulatorConfig.policySettings.boostTime, 0, false, false, false );
+   config.addFloat( "CFS target latency (cycles)", &simulatorConfig.policySettings.targetLatency, 0, true, false, false );
+   config.addFloat( "CFS minimum granularity (cycles)", &simulatorConfig.policySettings.minGranularity, 0, true, false, false );
+   config.addInt( "Memory frames", &simulatorConfig.memory.frameCount, 1, INT_MAX, false );
+   config.addInt( "Page size (kB)", &simulatorConfig.memory.pageSize, 1, INT_MAX, false );
+   config.addChoice( "Page replacement", &simulatorConfig.memory.replacement, REPLACEMENT_NAMES, REPLACE_COUNT, false );
+   config.addFloat( "Dispatch time (msec)", &simulatorConfig.dispatchCost.dispatchTime, 0, false, false, true );
+   config.addFloat( "Context switch time (msec)", &simulatorConfig.dispatchCost.switchTime, 0, false, false, true );
+   config.addFloat( "Migration penalty (msec)", &simulatorConfig.dispatchCost.migrationPenalty, 0, false, false, true );
 }
 
 /**
-runProcesses
-
-Runs queue of processes according to given scheduling code. 
-Can run in either FIFO-P, RR, SRTF-P, FIFO, SJF, or STRF modes.
-Each process is selected and passed to threadActions or threadActionsQuantum
-to be executed, depending on if scheduling method is preemptive or not. 
-Output is printed with printAction for each process. 
-
-@param simulatorConfig a reference to an OSCB object with current action & configuration info
-@param processes a list of process control blocks to be executed
-@pre valid config information and meta-data was saved
-@post each PCB in the list was executed according to scheduling code
-@return void 
+reloadConfig
+
+Reads the configuration file again and saves its cycle times, time
+quantum and dispatch costs (dispatch, context switch and migration
+times), the settings that can change while the simulator runs. Dispatch
+costs left out of the file keep their current values. Other settings
+keep the values read at start. The result is logged.
+
+@param simulatorConfig OSCB holding configuration table and path
+@pre configuration was read with readConfig, no action is running
+@post cycle times, quantum and dispatch costs were reloaded, or left unchanged on error
+@return bool representing configuration was reloaded
 */
-void runProcesses( OSCB &simulatorConfig, list<PCB>& processes )
+bool reloadConfig( OSCB &simulatorConfig )
 {
    // initialize variables
-   list<PCB>::iterator minProcess;
-   list<PCB> runningQueue;
    OSCB* simulatorPtr = &simulatorConfig;
-   float remainingActions;
+   ifstream configFile;
+   bool reloadSucess = false;
 
       // prepare output string
       stringstream actionOutput;
       actionOutput.precision( PRECISION );
-      actionOutput << fixed; 
+      actionOutput << fixed;
 
-      // set time output      
-      simulatorConfig.timer = clock(); 
+   // read in reloadable settings
+   configFile.open( simulatorConfig.configPath.c_str(), ifstream::in );
 
-   // start simulator
-   actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-   actionOutput << " - " << "Simulator program starting \n";
-   printAction( simulatorPtr, actionOutput ); 
+   if( configFile.is_open() )
+   {
+      reloadSucess = simulatorConfig.config.reload( configFile );
+      configFile.close();
+   }
 
-   // output preparing processes
-   actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-   actionOutput << " - " << "OS: preparing all processes \n";
-   printAction( simulatorPtr, actionOutput );      
+   actionOutput << simulatorConfig.simClock.currentTime();
 
-   // enter appropriate scheduling code case
-   // (includes both required cases and previously implemented)
+   if( reloadSucess )
+   {
+      // memory access takes one processor cycle
+      simulatorConfig.cycleTimes[ DESC_ACCESS ] = simulatorConfig.cycleTimes[ DESC_RUN ];
 
-      // first-in first-out preemptive scheduling (fifo-p)
-      if( simulatorConfig.schedulingCode == "FIFO-P" )
-      {
-         // dequeue each process and run
-         while( !processes.empty() )
-         {
-            // prepare processes
-            actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-            actionOutput << " - " << "OS: selecting next process \n";
-            printAction( simulatorPtr, actionOutput );  
+      actionOutput << " - " << "OS: configuration reloaded (quantum " << simulatorConfig.quantum << " cycles) \n";
+   }
 
-            // move process into Running/Blocked queue  
-            runningQueue.push_front( *(processes.begin()) );
+   // check for open failure
+   else if( simulatorConfig.config.errorMessage().empty() )
+   {
+      actionOutput << " - " << "OS: configuration not reloaded, file could not be opened \n";
+   }
 
-            // change process to running state
-            runningQueue.front().state = "Running";
+   else
+   {
+      actionOutput << " - " << "OS: configuration not reloaded, " << simulatorConfig.config.errorMessage() << " \n";
+   }
 
-            // execute process
-            remainingActions = threadActionQuantum( simulatorConfig, runningQueue );
+   printAction( simulatorPtr, actionOutput );
 
-            // check state
+   return reloadSucess;
+}
 
-               // remove process from Ready queue
-               processes.pop_front();
+/**
+installReload
 
-               // check for blocked
-               if( remainingActions > 0 )
-               {
-                  // changed to blocked state
-                  runningQueue.front().state = "Blocked";
+Sets requestReload as the handler of SIGHUP, so "kill -HUP" asks a
+running simulator to reload its configuration file.
 
-                  // insert back into Ready queue (at front because priority queue)
-                  processes.push_front( *(runningQueue.begin()) );
-               }
+@pre none
+@post SIGHUP no longer ends the program
+@return void
+*/
+void installReload()
+{
+   // initialize variables
+   struct sigaction reloadAction;
 
-               // check for completion
-               else 
-               {
-                  // change process to exit state
-                  runningQueue.front().state = "Exit"; 
-               }        
+   memset( &reloadAction, 0, sizeof( reloadAction ) );
+   reloadAction.sa_handler = requestReload;
+   reloadAction.sa_flags = SA_RESTART;
+   sigemptyset( &reloadAction.sa_mask );
 
-            // remove process from Running/Blocked queue
-            runningQueue.pop_front();  
-         }
-      }
+   sigaction( SIGHUP, &reloadAction, NULL );
+}
 
-      // round robin scheduling (rr)
-      if( simulatorConfig.schedulingCode == "RR" )
-      {
-         // dequeue each process and run
-         while( !processes.empty() )
-         {
-            // prepare processes
-            actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-            actionOutput << " - " << "OS: selecting next process \n";
-            printAction( simulatorPtr, actionOutput );  
+/**
+printConfigError
 
-            // move process into Running/Blocked queue  
-            runningQueue.push_front( *(processes.begin()) );
+Prints the error found in the configuration file.
 
-            // change process to running state
-            runningQueue.front().state = "Running";
+@param simulatorConfig OSCB whose configuration table saved the error
+@pre configuration could not be read
+@post error was printed
+@return void
+*/
+void printConfigError( OSCB &simulatorConfig )
+{
+   // check for file that could not be opened
+   if( simulatorConfig.config.errorMessage().empty() )
+   {
+      cout << "Error in configuration file. Please try again." << endl;
+      return;
+   }
+
+   cout << "Error in configuration file. " << simulatorConfig.config.errorMessage() << ". Please try again." << endl;
+}
+
+/**
+requestReload
+
+Signal handler for SIGHUP. Asks the dispatch loop to reload the
+configuration file before its next scheduling round.
+
+@param signalNumber signal received
+@pre none
+@post reload was requested
+@return void
+*/
+void requestReload( int signalNumber )
+{
+   reloadRequested = 1;
+}
+
+/**
+setPolicySettings
+
+Finishes the MLFQ and CFS settings. The number of MLFQ levels is the
+number of level quanta given, or MLFQ_DEFAULT_LEVELS. Levels without a
+quantum double the quantum of the level above, starting from the time
+quantum. The CFS target latency defaults to CFS_LATENCY_QUANTA time
+quanta, and its minimum granularity to one time quantum.
+
+@param simulatorConfig holds policy settings read from configuration file
+@pre time quantum was read
+@post every level has a quantum, CFS times are set
+@return bool representing settings are valid
+*/
+bool setPolicySettings( OSCB &simulatorConfig )
+{
+   // initialize variables
+   PolicySettings& settings = simulatorConfig.policySettings;
+   float levelQuantum = simulatorConfig.quantum;
+
+   // find number of levels
+   if( settings.levelCount == 0 )
+   {
+      settings.levelCount = MLFQ_DEFAULT_LEVELS;
+
+      if( !settings.levelQuanta.empty() )
+      {
+         settings.levelCount = settings.levelQuanta.size();
+      }
+   }
+
+   // check for more quanta than levels
+   if( (int) settings.levelQuanta.size() > settings.levelCount )
+   {
+      return simulatorConfig.config.reject( "MLFQ quantum (cycles)", "has more quanta than MLFQ levels" );
+   }
+
+   // double quantum for each remaining level
+   if( !settings.levelQuanta.empty() )
+   {
+      levelQuantum = settings.levelQuanta.back() * 2;
+   }
+
+   while( (int) settings.levelQuanta.size() < settings.levelCount )
+   {
+      settings.levelQuanta.push_back( levelQuantum );
+      levelQuantum *= 2;
+   }
+
+   // set CFS times
+   if( settings.targetLatency == 0 )
+   {
+      settings.targetLatency = simulatorConfig.quantum * CFS_LATENCY_QUANTA;
+   }
+
+   if( settings.minGranularity == 0 )
+   {
+      settings.minGranularity = simulatorConfig.quantum;
+   }
+
+   // check for CFS time slice shorter than one cycle
+   if( simulatorConfig.policyID == POLICY_CFS &&
+       ( settings.minGranularity < 1 || settings.targetLatency < settings.minGranularity ) )
+   {
+      return simulatorConfig.config.reject( "CFS minimum granularity (cycles)", "must be at least 1 and no more than the target latency" );
+   }
+
+   return true;
+}
+
+/**
+saveMetaData
+
+Opens the meta-data file (text or compiled binary) and reads in processes.
+Each process is added to a process queue and actions within each
+process are sent into a process control block and into a queue within
+the PCB. When the scheduling code runs processes in file order (FIFO,
+or RR with a resident process limit), only the first batch is read
+here and the rest is read by loadProcesses while the simulator runs.
+Other scheduling codes on one processor also read only the first batch,
+and loadArrivals reads the rest as processes arrive. With several
+processors every process is read. The number of processes read is
+returned. An error results in -1 being returned.
+
+@param simulatorConfig holds all configuration info to use, including meta-data info
+@param process process control block queue with process information
+@pre valid config information was saved
+@post first batch of processes saved or error returned
+@return int representing number of processes saved
+*/
+int saveMetaData( OSCB &simulatorConfig, list<PCB>& processes )
+{
+   // open meta-data file
+   if( !simulatorConfig.metaReader.open( simulatorConfig.metaPath ) )
+   {
+      // print failure
+      cout << "Error in meta-data file. Please try again." << endl;
+
+      // return invalid meta-data
+      return -1;
+   }
+
+   // read in first batch (or all) of processes
+   return simulatorConfig.metaReader.readProcesses( processes,
+                                                    readsByArrival( simulatorConfig ) ? META_BATCH_SIZE : findProcessLimit( simulatorConfig ),
+                                                    simulatorConfig.cycleTimes );
+}
+
+/**
+loadProcesses
+
+Reads more processes from the meta-data file while fewer than the
+process limit are in the simulator. New processes are added to the end
+of the Ready queue, the same place they would have been if read up front.
+
+@param simulatorConfig holds meta-data reader and configuration info
+@param processes Ready queue to add processes to
+@param residentCount number of processes currently Ready, Running or Blocked
+@pre saveMetaData was called
+@post Ready queue was refilled up to the process limit, if possible
+@return void
+*/
+void loadProcesses( OSCB &simulatorConfig, list<PCB>& processes, int residentCount )
+{
+   // initialize variables
+   int processLimit = findProcessLimit( simulatorConfig );
+
+   // check for all processes read or enough processes
+   if( simulatorConfig.metaReader.finished() || processLimit == ALL_PROCESSES || residentCount >= processLimit )
+   {
+      return;
+   }
+
+   simulatorConfig.metaReader.readProcesses( processes, processLimit - residentCount, simulatorConfig.cycleTimes );
+}
+
+/**
+loadArrivals
+
+Holds newly read processes that have not yet arrived, then, for
+scheduling codes that read by arrival, reads more processes in batches
+until one that has not yet arrived has been read (or the file ends).
+Processes are in arrival order, so every process that has arrived is
+then loaded, and the processes not yet read arrive later. Only the
+processes that have arrived, and at most one batch more, are in memory.
+
+@param simulatorConfig holds meta-data reader, clock and arrival timer
+@param newProcesses processes to admit, with more added as they are read
+@param arrivingQueue list of PCB objects that have not yet arrived
+@pre saveMetaData was called, arrival timer was started
+@post only arrived processes are left in newProcesses, and if none are
+      arriving every process has been read
+@return void
+*/
+void loadArrivals( OSCB &simulatorConfig, list<PCB>& newProcesses, list<PCB>& arrivingQueue )
+{
+   // initialize variables
+   list<PCB> batch;
+
+   holdArrivals( simulatorConfig, newProcesses, arrivingQueue );
+
+   // check for processes read by process limit
+   if( !readsByArrival( simulatorConfig ) )
+   {
+      return;
+   }
+
+   // read until a process has not yet arrived
+   while( arrivingQueue.empty() && !simulatorConfig.metaReader.finished() )
+   {
+      simulatorConfig.metaReader.readProcesses( batch, META_BATCH_SIZE, simulatorConfig.cycleTimes );
+      holdArrivals( simulatorConfig, batch, arrivingQueue );
+
+      newProcesses.splice( newProcesses.end(), batch );
+   }
+}
+
+/**
+findProcessLimit
+
+Returns the most processes to keep loaded at once. FIFO runs processes
+in file order, so it always reads in batches. RR reads in batches only
+when "Resident processes" is set, since the processes it has not yet
+read do not get a turn. Other scheduling codes need every process that
+has arrived (see readsByArrival).
+
+@param simulatorConfig holds configuration info
+@pre valid config information was saved
+@post none
+@return int with process limit, or ALL_PROCESSES
+*/
+int findProcessLimit( OSCB &simulatorConfig )
+{
+   // check for several processors
+   if( simulatorConfig.processorCount > 1 )
+   {
+      return ALL_PROCESSES;
+   }
+
+   // first-in first-out reads in batches
+   if( simulatorConfig.policyID == POLICY_FIFO )
+   {
+      if( simulatorConfig.residentLimit > 0 )
+      {
+         return simulatorConfig.residentLimit;
+      }
+
+      return META_BATCH_SIZE;
+   }
+
+   // round robin reads in batches if limited
+   if( simulatorConfig.policyID == POLICY_RR && simulatorConfig.residentLimit > 0 )
+   {
+      return simulatorConfig.residentLimit;
+   }
+
+   return ALL_PROCESSES;
+}
+
+/**
+readsByArrival
+
+Returns true if processes are read as they arrive instead of by process
+limit: scheduling codes that need every arrived process, on one processor.
+
+@param simulatorConfig holds configuration info
+@pre valid config information was saved
+@post none
+@return bool representing processes are read by loadArrivals
+*/
+bool readsByArrival( OSCB &simulatorConfig )
+{
+   return simulatorConfig.processorCount == 1 && findProcessLimit( simulatorConfig ) == ALL_PROCESSES;
+}
+
+/**
+compileMetaData
+
+Converts a text meta-data file to the binary format read by MetaReader
+(see Meta_Reader.h). The text file is read a batch of processes at a
+time, so files larger than memory can be converted.
+
+@param textPath path of text meta-data file
+@param binaryPath path of binary meta-data file to write
+@pre none
+@post binary file was written, or error was printed
+@return bool representing successful conversion
+*/
+bool compileMetaData( char* textPath, char* binaryPath )
+{
+   // initialize variables
+   MetaReader textReader;
+   ofstream binaryFile;
+   MetaHeader header;
+   MetaDescriptor descriptor;
+   MetaRecord record;
+   vector<uint64_t> processIndex;
+   vector<uint32_t> arrivalTimes;
+   list<PCB> processes;
+   float cycleTimes[ DESC_COUNT ] = { 0 };
+   Action* currentAction;
+   int descriptorID;
+
+   // open text file (traces need cycle times, so are only read by a run)
+   if( strlen( textPath ) > strlen( TRACE_EXTENSION ) &&
+       strcmp( textPath + strlen( textPath ) - strlen( TRACE_EXTENSION ), TRACE_EXTENSION ) == 0 )
+   {
+      // print failure
+      cout << "Error in meta-data file. Traces cannot be compiled. Please try again." << endl;
+
+      // return failure
+      return false;
+   }
+
+   if( !textReader.open( textPath ) )
+   {
+      // print failure
+      cout << "Error in meta-data file. Please try again." << endl;
+
+      // return failure
+      return false;
+   }
+
+   // open binary file
+   binaryFile.open( binaryPath, ofstream::out | ofstream::trunc | ofstream::binary );
+
+      // check for open failure
+      if( !binaryFile.is_open() )
+      {
+         // print failure
+         cout << "Error in output file. Please try again." << endl;
+
+         // return failure
+         return false;
+      }
+
+   // prepare header (offsets are filled in once known)
+   memset( &header, 0, sizeof( header ) );
+   memcpy( header.magic, META_MAGIC, META_MAGIC_LEN );
+   header.descriptorCount = DESC_COUNT - DESC_RUN;
+   header.recordSize = sizeof( MetaRecord );
+   header.descriptorOffset = sizeof( MetaHeader );
+   header.actionOffset = header.descriptorOffset + header.descriptorCount * sizeof( MetaDescriptor );
+   binaryFile.write( (const char*) &header, sizeof( header ) );
+
+   // write descriptor table (run and each device)
+   for( descriptorID = DESC_RUN; descriptorID < DESC_COUNT; descriptorID++ )
+   {
+      memset( &descriptor, 0, sizeof( descriptor ) );
+      strncpy( descriptor.name, DESCRIPTOR_NAMES[ descriptorID ], META_NAME_LEN - 1 );
+      binaryFile.write( (const char*) &descriptor, sizeof( descriptor ) );
+   }
+
+   // write action records, a batch of processes at a time
+   record.reserved = 0;
+
+   while( textReader.readProcesses( processes, META_BATCH_SIZE, cycleTimes ) > 0 )
+   {
+      while( !processes.empty() )
+      {
+         // check for arrival time (msec) too large for binary field
+         if( processes.front().arrivalTime * MSEC_PER_SEC + 0.5 >= (double) UINT32_MAX + 1 )
+         {
+            binaryFile.close();
+
+            // print failure
+            cout << "Error in meta-data. Process arrival time too large to compile. Please try again." << endl;
+
+            // return failure
+            return false;
+         }
+
+         // save first action and arrival time (msec) of process
+         processIndex.push_back( header.actionCount );
+         arrivalTimes.push_back( (uint32_t)( processes.front().arrivalTime * MSEC_PER_SEC + 0.5 ) );
+
+         // write each P, I, O and M action (start and end are implied)
+         while( !processes.front().actions.empty() )
+         {
+            currentAction = &( processes.front().actions.front() );
+
+            if( currentAction->actionType != 'A' )
+            {
+               record.actionType = currentAction->actionType;
+               record.descriptor = currentAction->descriptorID - DESC_RUN;
+               record.actionCycle = (int32_t) currentAction->actionCycle;
+               binaryFile.write( (const char*) &record, sizeof( record ) );
+
+               header.actionCount++;
+            }
+
+            processes.front().actions.pop();
+         }
+
+         processes.pop_front();
+      }
+   }
+
+   // check for invalid text file
+   if( textReader.failed() )
+   {
+      binaryFile.close();
+
+      // return failure
+      return false;
+   }
+
+   // write process index (with end of last process)
+   processIndex.push_back( header.actionCount );
+   header.processCount = processIndex.size() - 1;
+   header.indexOffset = header.actionOffset + header.actionCount * sizeof( MetaRecord );
+   binaryFile.write( (const char*) &processIndex[ 0 ], processIndex.size() * sizeof( uint64_t ) );
+
+   // write arrival times
+   header.arrivalOffset = header.indexOffset + processIndex.size() * sizeof( uint64_t );
+
+   if( !arrivalTimes.empty() )
+   {
+      binaryFile.write( (const char*) &arrivalTimes[ 0 ], arrivalTimes.size() * sizeof( uint32_t ) );
+   }
+
+   // write finished header
+   binaryFile.seekp( 0 );
+   binaryFile.write( (const char*) &header, sizeof( header ) );
+
+   binaryFile.close();
+
+   // check for write failure
+   if( binaryFile.fail() )
+   {
+      // print failure
+      cout << "Error in output file. Please try again." << endl;
+
+      // return failure
+      return false;
+   }
+
+   cout << "Compiled " << header.processCount << " processes (" << header.actionCount << " actions) to " << binaryPath << endl;
+
+   // return success
+   return true;
+}
+
+/**
+runSweep
+
+Runs the simulator once for each combination of the settings in a grid
+file, and writes a table of results. Each line of the grid file is a
+configuration key and a comma separated list of values, e.g.
+"Quantum time (cycles): 2, 4, 6". Every run is a separate child process
+with its own OSCB, started from the base configuration with the values
+of that combination replacing (or added to) its lines. As many runs as
+there are processors run at once. Runs always use simulated time and do
+not log, so they do not slow each other down or change each other's
+timings.
+
+@param configPath path of base configuration file
+@param gridPath path of grid file
+@param resultsPath path of results file (NULL for console)
+@pre none
+@post results table was written
+@return int with exit code (0 if every run completed)
+*/
+int runSweep( char* configPath, char* gridPath, char* resultsPath )
+{
+   // initialize variables
+   ifstream configFile;
+   ofstream resultsFile;
+   stringstream configText;
+   OSCB baseConfig;
+   vector<string> keys;
+   vector< vector<string> > values;
+   vector<int> position;
+   vector<string> settings;
+   vector< vector<string> > runSettings;
+   vector<string> results;
+   map<pid_t, int> running;
+   map<pid_t, int> resultPipes;
+   int runCount = 1;
+   int nextRun = 0;
+   int jobCount = sysconf( _SC_NPROCESSORS_ONLN );
+   int runIndex;
+   int keyIndex;
+   int pipeEnds[ 2 ];
+   int status;
+   int failedCount = 0;
+   pid_t childID;
+   char buffer[ STD_LINE_LEN ];
+   ssize_t readCount;
+   string result;
+   ostream* outPtr = &cout;
+
+   // read in base configuration
+   configFile.open( configPath, ifstream::in );
+   configText << configFile.rdbuf();
+   configFile.close();
+
+   if( !readConfig( configText, baseConfig ) )
+   {
+      // print failure
+      printConfigError( baseConfig );
+
+      // return failure
+      return 1;
+   }
+
+   // read in grid
+   if( !readGrid( gridPath, keys, values ) )
+   {
+      // print failure
+      cout << "Error in sweep grid file. Please try again." << endl;
+
+      // return failure
+      return 1;
+   }
+
+   // check grid keys are settings, and note keys not in base
+   // configuration (added as optional settings)
+   for( keyIndex = 0; keyIndex < (int) keys.size(); keyIndex++ )
+   {
+      if( !baseConfig.config.hasField( keys[ keyIndex ] ) )
+      {
+         // print failure
+         cout << "Error in sweep grid file. Unrecognized setting \"" << keys[ keyIndex ] << "\". Please try again." << endl;
+
+         // return failure
+         return 1;
+      }
+
+      if( !baseConfig.config.isGiven( keys[ keyIndex ] ) )
+      {
+         cout << "Note: \"" << keys[ keyIndex ] << "\" is not in the configuration file, adding it as an optional setting." << endl;
+      }
+   }
+
+   // list settings of every run (last key changes fastest)
+   for( keyIndex = 0; keyIndex < (int) keys.size(); keyIndex++ )
+   {
+      runCount *= values[ keyIndex ].size();
+   }
+
+   position.assign( keys.size(), 0 );
+   settings.resize( keys.size() );
+
+   for( runIndex = 0; runIndex < runCount; runIndex++ )
+   {
+      for( keyIndex = 0; keyIndex < (int) keys.size(); keyIndex++ )
+      {
+         settings[ keyIndex ] = values[ keyIndex ][ position[ keyIndex ] ];
+      }
+
+      runSettings.push_back( settings );
+
+      // move to next combination
+      for( keyIndex = keys.size() - 1; keyIndex >= 0; keyIndex-- )
+      {
+         position[ keyIndex ]++;
+
+         if( position[ keyIndex ] < (int) values[ keyIndex ].size() )
+         {
+            break;
+         }
+
+         position[ keyIndex ] = 0;
+      }
+   }
+
+   results.resize( runCount );
+
+   if( jobCount < 1 )
+   {
+      jobCount = 1;
+   }
+
+   // start runs, keeping jobCount running at once
+   while( nextRun < runCount || !running.empty() )
+   {
+      // start next run
+      if( nextRun < runCount && (int) running.size() < jobCount )
+      {
+         if( pipe( pipeEnds ) != 0 )
+         {
+            results[ nextRun ] = "error";
+            nextRun++;
+
+            continue;
+         }
+
+         childID = fork();
+
+         // child runs simulation and sends result line
+         if( childID == 0 )
+         {
+            close( pipeEnds[ 0 ] );
+
+            result = runSweepPoint( applyOverrides( configText.str(), keys, runSettings[ nextRun ] ) );
+
+            if( write( pipeEnds[ 1 ], result.data(), result.size() ) < 0 )
+            {
+               _exit( 1 );
+            }
+
+            _exit( 0 );
+         }
+
+         close( pipeEnds[ 1 ] );
+
+         // check for failed fork
+         if( childID < 0 )
+         {
+            close( pipeEnds[ 0 ] );
+            results[ nextRun ] = "error";
+         }
+         else
+         {
+            running[ childID ] = nextRun;
+            resultPipes[ childID ] = pipeEnds[ 0 ];
+         }
+
+         nextRun++;
+
+         continue;
+      }
+
+      // wait for a run to end
+      childID = waitpid( -1, &status, 0 );
+
+      if( childID < 0 || running.find( childID ) == running.end() )
+      {
+         continue;
+      }
+
+      // read result line (small enough that child never waits to write it)
+      result.clear();
+
+      while( ( readCount = read( resultPipes[ childID ], buffer, sizeof( buffer ) ) ) > 0 )
+      {
+         result.append( buffer, readCount );
+      }
+
+      close( resultPipes[ childID ] );
+
+      if( result.empty() )
+      {
+         result = "error";
+      }
+
+      results[ running[ childID ] ] = result;
+      running.erase( childID );
+      resultPipes.erase( childID );
+   }
+
+   // open results file
+   if( resultsPath != NULL )
+   {
+      resultsFile.open( resultsPath, ofstream::out | ofstream::trunc );
+
+      if( !resultsFile.is_open() )
+      {
+         // print failure
+         cout << "Error in results file. Please try again." << endl;
+
+         // return failure
+         return 1;
+      }
+
+      outPtr = &resultsFile;
+   }
+
+   // write results table (tab separated)
+   *outPtr << "run";
+
+   for( keyIndex = 0; keyIndex < (int) keys.size(); keyIndex++ )
+   {
+      *outPtr << "\t" << keys[ keyIndex ];
+   }
+
+   *outPtr << "\tprocesses\ttotal time\tthroughput\tturnaround mean\tturnaround p99\twait mean\twait p99" << endl;
+
+   for( runIndex = 0; runIndex < runCount; runIndex++ )
+   {
+      *outPtr << runIndex + 1;
+
+      for( keyIndex = 0; keyIndex < (int) keys.size(); keyIndex++ )
+      {
+         *outPtr << "\t" << runSettings[ runIndex ][ keyIndex ];
+      }
+
+      *outPtr << "\t" << results[ runIndex ] << endl;
+
+      if( results[ runIndex ] == "error" )
+      {
+         failedCount++;
+      }
+   }
+
+   // return failure if any run failed
+   return failedCount > 0 ? 1 : 0;
+}
+
+/**
+readGrid
+
+Reads a sweep grid file. Each non-empty line is a configuration key,
+a colon, and a comma separated list of values.
+
+@param gridPath path of grid file
+@param keys configuration key of each line
+@param values values of each key
+@pre none
+@post keys and values were read
+@return bool representing grid was valid (at least one key, each with a value)
+*/
+bool readGrid( char* gridPath, vector<string>& keys, vector< vector<string> >& values )
+{
+   // initialize variables
+   ifstream gridFile;
+   string tempLine;
+   string value;
+   size_t colon;
+
+   gridFile.open( gridPath, ifstream::in );
+
+   // check for open failure
+   if( !gridFile.is_open() )
+   {
+      return false;
+   }
+
+   // read each key
+   while( getline( gridFile, tempLine ) )
+   {
+      // skip empty lines
+      if( trimText( tempLine ).empty() )
+      {
+         continue;
+      }
+
+      colon = tempLine.find( ':' );
+
+      // check for missing key
+      if( colon == string::npos || trimText( tempLine.substr( 0, colon ) ).empty() )
+      {
+         return false;
+      }
+
+      keys.push_back( trimText( tempLine.substr( 0, colon ) ) );
+      values.push_back( vector<string>() );
+
+      // read each value
+      stringstream valueList( tempLine.substr( colon + 1 ) );
+
+      while( getline( valueList, value, ',' ) )
+      {
+         if( !trimText( value ).empty() )
+         {
+            values.back().push_back( trimText( value ) );
+         }
+      }
+
+      // check for missing values
+      if( values.back().empty() )
+      {
+         return false;
+      }
+   }
+
+   return !keys.empty();
+}
+
+/**
+applyOverrides
+
+Returns configuration text with the line of each key replaced by its
+sweep setting. Keys not in the configuration (optional settings) are
+added before its last line.
+
+@param configText base configuration text
+@param keys configuration keys to set
+@param settings value of each key
+@pre none
+@post none
+@return string with configuration text of run
+*/
+string applyOverrides( const string& configText, const vector<string>& keys, const vector<string>& settings )
+{
+   // initialize variables
+   stringstream configLines( configText );
+   string tempLine;
+   string runText;
+   vector<bool> applied( keys.size(), false );
+   unsigned int keyIndex;
+   size_t colon;
+
+   while( getline( configLines, tempLine ) )
+   {
+      // add settings not yet applied before end line
+      if( tempLine.find( "End Simulator" ) == 0 )
+      {
+         for( keyIndex = 0; keyIndex < keys.size(); keyIndex++ )
+         {
+            if( !applied[ keyIndex ] )
+            {
+               runText += keys[ keyIndex ] + ": " + settings[ keyIndex ] + "\n";
+            }
+         }
+      }
+
+      // replace line of swept key
+      colon = tempLine.find( ':' );
+
+      for( keyIndex = 0; colon != string::npos && keyIndex < keys.size(); keyIndex++ )
+      {
+         if( trimText( tempLine.substr( 0, colon ) ) == keys[ keyIndex ] )
+         {
+            tempLine = keys[ keyIndex ] + ": " + settings[ keyIndex ];
+            applied[ keyIndex ] = true;
+         }
+      }
+
+      runText += tempLine + "\n";
+   }
+
+   return runText;
+}
+
+/**
+runSweepPoint
+
+Runs one simulation of a sweep in simulated time without logging, and
+returns its results as a tab separated line.
+
+@param configText configuration text of run
+@pre called in its own process
+@post simulation was run
+@return string with results line, or "error" if configuration or meta-data was invalid
+*/
+string runSweepPoint( const string& configText )
+{
+   // initialize variables
+   OSCB simulatorConfig;
+   stringstream configLines( configText );
+   stringstream resultLine;
+   list<PCB> processes;
+   TimeSummary turnaround;
+   TimeSummary wait;
+   double totalTime;
+   int processCount;
+
+   // read in configuration and meta-data
+   if( !readConfig( configLines, simulatorConfig ) )
+   {
+      return "error";
+   }
+
+   if( saveMetaData( simulatorConfig, processes ) < 0 )
+   {
+      return "error";
+   }
+
+   // run in simulated time, without log or statistics file
+   simulatorConfig.virtualTime = true;
+   simulatorConfig.statsPath.clear();
+
+   simulatorConfig.actionPool.start( ACTION_WORKERS );
+   runProcesses( simulatorConfig, processes );
+   simulatorConfig.actionPool.stop();
+
+   // check for meta-data error found while running
+   if( simulatorConfig.metaReader.failed() )
+   {
+      return "error";
+   }
+
+   // find results
+   totalTime = simulatorConfig.simClock.currentTime();
+   processCount = simulatorConfig.runStats.processCount();
+   turnaround = simulatorConfig.runStats.summarize( TURNAROUND_TIME );
+   wait = simulatorConfig.runStats.summarize( WAIT_TIME );
+
+   resultLine.precision( PRECISION );
+   resultLine << fixed;
+   resultLine << processCount << "\t" << totalTime << "\t" << ( totalTime > 0 ? processCount / totalTime : 0 );
+   resultLine << "\t" << turnaround.mean << "\t" << turnaround.p99 << "\t" << wait.mean << "\t" << wait.p99;
+
+   return resultLine.str();
+}
+
+/**
+runProcesses
+
+Runs queue of processes according to given scheduling code. 
+Can run in either FIFO-P, RR, SRTF-P, FIFO, SJF, or STRF modes.
+Starts the simulation and I/O devices, then runs the dispatch loop of
+the scheduling policy chosen when the configuration was read (or the
+processors, if there are several). Output is printed with printAction
+for each process. 
+
+@param simulatorConfig a reference to an OSCB object with current action & configuration info
+@param processes a list of process control blocks to be executed
+@pre valid config information and meta-data was saved
+@post each PCB in the list was executed according to scheduling code
+@return void 
+*/
+void runProcesses( OSCB &simulatorConfig, list<PCB>& processes )
+{
+   // initialize variables
+   int deviceID;
+   OSCB* simulatorPtr = &simulatorConfig;
+   int completedProcesses = 0;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+      // set time output      
+      simulatorConfig.simClock.start( simulatorConfig.virtualTime, simulatorConfig.tscClock, simulatorConfig.deterministic ); 
+
+      // no processor has run a process yet
+      simulatorConfig.dispatchCost.configure( simulatorConfig.processorCount );
+
+      // start one I/O device for each I/O cycle time
+      simulatorConfig.interrupts.setClock( &simulatorConfig.simClock );
+      simulatorConfig.interrupts.setLog( &simulatorConfig.logWriter );
+
+      for( deviceID = FIRST_DEVICE; deviceID <= LAST_DEVICE; deviceID++ )
+      {
+         simulatorConfig.devices[ deviceID ].start( DESCRIPTOR_NAMES[ deviceID ], simulatorPtr, deviceRunner );
+      }
+
+      // start arrival timer (for processes that arrive after the start)
+      simulatorConfig.arrivals.start( "arrivals", simulatorPtr, arrivalRunner );
+
+   // start simulator
+   actionOutput << simulatorConfig.simClock.currentTime();
+   actionOutput << " - " << "Simulator program starting \n";
+   printAction( simulatorPtr, actionOutput ); 
+
+   // output preparing processes
+   actionOutput << simulatorConfig.simClock.currentTime();
+   actionOutput << " - " << "OS: preparing all processes \n";
+   printAction( simulatorPtr, actionOutput );      
+
+   // run on several processors
+   if( simulatorConfig.processorCount > 1 )
+   {
+      completedProcesses = runMultiCore( simulatorConfig, processes );
+   }
+
+   // run dispatch loop of scheduling policy on one processor
+   // (includes both required cases and previously implemented)
+   else
+   {
+      switch( simulatorConfig.policyID )
+      {
+         case POLICY_FIFO_P:
+            completedProcesses = runPolicy<FifoPreemptivePolicy>( simulatorConfig, processes );
+            break;
+
+         case POLICY_RR:
+            completedProcesses = runPolicy<RoundRobinPolicy>( simulatorConfig, processes );
+            break;
+
+         case POLICY_SRTF_P:
+            completedProcesses = runPolicy<ShortestRemainingPreemptivePolicy>( simulatorConfig, processes );
+            break;
+
+         case POLICY_FIFO:
+            completedProcesses = runPolicy<FifoPolicy>( simulatorConfig, processes );
+            break;
+
+         case POLICY_SJF:
+            completedProcesses = runPolicy<ShortestJobPolicy>( simulatorConfig, processes );
+            break;
+
+         case POLICY_SRTF:
+            completedProcesses = runPolicy<ShortestRemainingPolicy>( simulatorConfig, processes );
+            break;
+
+         case POLICY_MLFQ:
+            completedProcesses = runPolicy<FeedbackQueuePolicy>( simulatorConfig, processes );
+            break;
+
+         case POLICY_CFS:
+            completedProcesses = runPolicy<FairSharePolicy>( simulatorConfig, processes );
+            break;
+      }
+   }
+
+   // stop I/O devices and arrival timer
+   for( deviceID = FIRST_DEVICE; deviceID <= LAST_DEVICE; deviceID++ )
+   {
+      simulatorConfig.devices[ deviceID ].stop();
+   }
+
+   simulatorConfig.arrivals.stop();
+
+   // print throughput and utilization
+   printStatistics( simulatorPtr, completedProcesses );
+
+   // end simulator
+   actionOutput << simulatorConfig.simClock.currentTime();
+   actionOutput << " - " << "Simulator program ending \n";
+   printAction( simulatorPtr, actionOutput );
+}
+
+/**
+runPolicy
+
+Dispatch loop for one processor, instantiated for each scheduling policy.
+The policy admits processes into the Ready queue and selects the next one,
+which is moved into the Running queue and run. Preemptive policies run one
+time quantum at a time, send I/O actions to their devices and return
+preempted processes through the policy; other policies run the whole
+process. Processes are read from the meta-data file as others exit, if
+the number loaded at once is limited, or else as they arrive. Processes
+that have not yet arrived wait in the Arriving queue, and are admitted
+when the arrival timer returns them.
+
+@param simulatorConfig reference to OSCB object with current action & configuration info
+@param processes a list of process control blocks to be executed
+@pre simulation and devices were started
+@post each PCB in the list was executed according to policy
+@return int with number of processes that reached Exit state
+*/
+template <class Policy>
+int runPolicy( OSCB &simulatorConfig, list<PCB>& processes )
+{
+   // initialize variables
+   Policy policy( simulatorConfig.quantum, simulatorConfig.policySettings );
+   list<PCB> readyQueue;
+   list<PCB> runningQueue;
+   list<PCB> blockedQueue;
+   list<PCB> arrivingQueue;
+   list<PCB> newProcesses;
+   OSCB* simulatorPtr = &simulatorConfig;
+   float remainingActions;
+   float startActions = 0;
+   int completedProcesses = 0;
+   double eventTime;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+   // admit processes read before the run (that have arrived)
+   loadArrivals( simulatorConfig, processes, arrivingQueue );
+   policy.admit( readyQueue, processes, simulatorConfig.simClock.currentTime() );
+
+   // dequeue each process and run
+   while( !readyQueue.empty() || !blockedQueue.empty() || !arrivingQueue.empty() )
+   {
+      // apply configuration reloaded since the last scheduling round
+      if( reloadRequested )
+      {
+         reloadRequested = 0;
+
+         if( reloadConfig( simulatorConfig ) )
+         {
+            policy.setQuantum( simulatorConfig.quantum );
+         }
+      }
+
+      // return processes with completed I/O (or that arrived) to Ready queue
+      if( Policy::PREEMPTIVE || !arrivingQueue.empty() )
+      {
+         handleInterrupts( simulatorConfig, readyQueue, blockedQueue, arrivingQueue, policy );
+      }
+
+      // read processes that may have arrived, once every process read has
+      if( arrivingQueue.empty() && !simulatorConfig.metaReader.finished() )
+      {
+         loadArrivals( simulatorConfig, newProcesses, arrivingQueue );
+         policy.admit( readyQueue, newProcesses, simulatorConfig.simClock.currentTime() );
+      }
+
+      // prepare processes
+      eventTime = simulatorConfig.simClock.currentTime();
+      actionOutput << eventTime;
+      actionOutput << " - " << "OS: selecting next process \n";
+      printAction( simulatorPtr, actionOutput );  
+
+      // move selected process from Ready queue into Running/Blocked queue
+      runningQueue.splice( runningQueue.begin(), readyQueue, policy.selectNext( readyQueue, eventTime ) );
+
+      // change process to running state (after dispatch overhead)
+      eventTime = chargeDispatch( simulatorPtr, 0, runningQueue.front() );
+      runningQueue.front().dispatch( eventTime );
+
+      // preemptive policies
+      if( Policy::PREEMPTIVE )
+      {
+         // send I/O action to its device (process is Blocked until interrupt)
+         if( startIO( simulatorConfig, runningQueue, blockedQueue ) )
+         {
+            policy.onBlock( blockedQueue.back(), simulatorConfig.simClock.currentTime() );
+
+            continue;
+         }
+
+         // execute process for one quantum
+         startActions = runningQueue.front().actions.size();
+         remainingActions = threadActionQuantum( simulatorConfig, runningQueue, policy.findQuantum( runningQueue.front() ) );
+      }
+
+      // non-preemptive policies
+      else
+      {
+         // execute process
+         threadActions( simulatorConfig, runningQueue.front() );
+
+         remainingActions = 0;
+      }
+
+      // check state
+
+         // check for blocked
+         if( remainingActions > 0 )
+         {
+            // return process to Ready state
+            eventTime = simulatorConfig.simClock.currentTime();
+            runningQueue.front().preempt( eventTime );
+
+            // move back into Ready queue
+            // (quantum was used if its action did not finish)
+            policy.onPreempt( readyQueue, runningQueue, remainingActions == startActions, eventTime );
+         }
+
+         // check for completion
+         else 
+         {
+            // change process to exit state
+            eventTime = simulatorConfig.simClock.currentTime();
+            runningQueue.front().exit( eventTime );
+            simulatorConfig.runStats.record( runningQueue.front() );
+            policy.onComplete( runningQueue.front(), eventTime );
+            completedProcesses++;
+
+            // remove process from Running/Blocked queue
+            runningQueue.pop_front();
+
+            // read in more processes, if limited
+            loadProcesses( simulatorConfig, newProcesses, readyQueue.size() + blockedQueue.size() + arrivingQueue.size() );
+            holdArrivals( simulatorConfig, newProcesses, arrivingQueue );
+            policy.admit( readyQueue, newProcesses, eventTime );
+         }        
+   }
+
+   // save policy statistics
+   policy.finish( simulatorConfig.runStats, simulatorConfig.simClock.currentTime() );
+
+   // return completed processes
+   return completedProcesses;
+}
+
+/**
+compareRuntimes
+
+Compares estimated remaining run times of two processes and returns
+true if first process has lower (or equal) runtime as process
+two, false otherwise. 
+
+@param first process to compare
+@param second process to compare
+@pre processes have been created and have estimated runtimes
+@post processes' estimated runtimes were compared
+@return bool indicating run time was lower for first process 
+*/
+bool compareRuntimes( const PCB& first, const PCB& second )
+{
+   // return true if first PCB has lower (or same) estimated runtime
+   // than second PCB, false otherwise
+   return( first.estimatedRuntime <= second.estimatedRuntime );
+}
+
+/**
+getCycleTime
+
+Returns the cycle time (msec) of the given action descriptor,
+or zero if the descriptor has no cycle time (e.g. start and end).
+Does not change cycle data, so it is safe to call from any thread.
+
+@param simulatorPtr pointer to OSCB object with cycle data
+@param descriptorID ID of action descriptor to look up
+@pre configuration was saved
+@post none
+@return float with cycle time of descriptor
+*/
+float getCycleTime( OSCB* simulatorPtr, int descriptorID )
+{
+   return simulatorPtr->cycleTimes[ descriptorID ];
+}
+
+/**
+threadActions
+
+Runs one process and hands each action to the action thread pool.
+The start simulation action is executed, then processes actions in
+process control block in order of arrival from meta-data file. Lastly,
+the end simulation action is executed. Each action is submitted to a
+worker thread which calls the runner function, and is waited on until
+it completes. 
+
+@param process process control block with process information
+@pre valid config information and meta-data was saved
+@post each action in the PCB was executed via a thread
+@return void 
+*/
+void threadActions( OSCB &simulatorConfig, PCB& process )
+{
+   // initialize variables
+   void* simulatorVoidPtr;
+
+   // run each action in action queue
+   while( !( process.actions.empty() ) )
+   {
+      // get first action in queue
+      simulatorConfig.currentAction = &(process.actions.front());
+
+      // save void pointer
+      simulatorVoidPtr = &(simulatorConfig);
+
+      // run action on worker thread and wait for completion
+      simulatorConfig.actionPool.submit( runner, simulatorVoidPtr );
+      simulatorConfig.actionPool.wait();
+
+      // remove completed action
+      process.actions.pop();
+   }        
+}
+
+/**
+threadActionsQuantum
+
+Submits an action of current process to the action thread pool and runs for specified time quantum.
+After time quantum, process is Blocked and OS returns to runProcesses to select another process.
+The start simulation action is executed, then processes actions in process control block in order of
+arrival from meta-data file. Current process was already selected in runProcesses according to
+scheduling code. Lastly, the end simulation action is executed if that action has completed.
+Each action is run by a worker thread calling the quantumRunner function, and is removed
+upon completion, or blocked if incomplete. 
+
+@param simulatorConfig reference to OSCB object with configuration information
+@param runningQueue a list of PCB objects that holds all currently running proceeses
+@param quantum time quantum to run for (cycles)
+@pre valid config information and meta-data was saved
+@post each action in the PCB was executed via a thread
+@return float with remaining number of actions in running process 
+*/
+float threadActionQuantum( OSCB &simulatorConfig, list<PCB> &runningQueue, float quantum )
+{
+   // initialize variables
+   void* simulatorVoidPtr;
+
+   // run first action in action queue
+   if( !( runningQueue.front().actions.empty() ) )
+   {
+      // get first action in queue
+      simulatorConfig.currentAction = &(runningQueue.front().actions.front());
+
+      // update remaining estimated process run time by cycles run (for SRTF-P)
+      runningQueue.front().estimatedRuntime -= ( getCycleTime( &simulatorConfig, simulatorConfig.currentAction->descriptorID ) *
+                                                 findRunCycles( *simulatorConfig.currentAction, quantum ) );
+
+      // save quantum and void pointer
+      simulatorConfig.currentQuantum = quantum;
+      simulatorVoidPtr = &(simulatorConfig);
+
+      // run action on worker thread and wait for completion
+      simulatorConfig.actionPool.submit( quantumRunner, simulatorVoidPtr );
+      simulatorConfig.actionPool.wait();
+
+      // check for action completion 
+      if( simulatorConfig.currentAction->actionCycle <= 0 )
+      {
+         // remove completed action
+         runningQueue.front().actions.pop();            
+      }
+   } 
+   
+   // return number of remaining actions in process
+   return runningQueue.front().actions.size();
+       
+}
+
+/**
+runner
+
+Simulates execution of the current action.
+A worker thread calls this function for each action in threadActions(). 
+The action is run by runAction() and its processor time is added to
+the simulator's processor busy time.
+
+@param void pointer to simulatorConfig with current action
+@pre a valid action is given
+@post action is completed and logged
+@return void
+*/
+void *runner( void* simulatorVoidPtr )
+{
+   // set void pointer to OSCB pointer
+   OSCB* simulatorPtr = static_cast<OSCB*>( simulatorVoidPtr );
+
+   // run action
+   simulatorPtr->cpuBusyTime += runAction( simulatorPtr, simulatorPtr->currentAction );
+
+   // end action
+   return NULL;
+}
+
+/**
+runAction
+
+Simulates execution of action.
+Prints appropriate information by calling printAction(),
+waits until it has completed the appropriate cycle time and then ends.
+
+@param simulatorPtr pointer to OSCB object with configuration information
+@param currentAction pointer to the action to run
+@pre a valid action is given
+@post action is completed and logged
+@return double with processor time used by action (seconds)
+*/
+double runAction( OSCB* simulatorPtr, Action* currentAction )
+{
+   // initialize variables
+
+      // processor time used
+      double busyTime = 0;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+      // action start and end time, and run duration (nsec)
+      int64_t startTime;
+      int64_t endTime;
+      int64_t runTime;
+
+      // action run duration 
+      runTime = SimClock::fromMsec( currentAction->actionCycle * getCycleTime( simulatorPtr, currentAction->descriptorID ) );
+
+   // application action type
+   if( currentAction->actionType == 'A' )
+   {
+      // start application descriptor
+      if( currentAction->descriptorID == DESC_START )
+      {
+         actionOutput << simulatorPtr->simClock.currentTime();
+         actionOutput << " - " << "OS: starting process " << currentAction->pcbID << endl;   
+         printAction( simulatorPtr, actionOutput );
+      }      
+
+      // end application descriptor
+      else
+      {
+         actionOutput << simulatorPtr->simClock.currentTime();
+         actionOutput << " - " << "OS: removing process " << currentAction->pcbID << endl; 
+         printAction( simulatorPtr, actionOutput );     
+
+         // free memory frames of process
+         simulatorPtr->memory.release( currentAction->pcbID );
+      }
+       
+   }
+
+   // process action type
+   else if( currentAction->actionType == 'P' )
+   {
+      // set current time
+      startTime = simulatorPtr->simClock.now();
+
+      // run application descriptor start
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start processing action \n"; 
+      printAction( simulatorPtr, actionOutput );
+
+      // run for specified time
+      waitForTime( simulatorPtr, startTime + runTime );
+
+      // set end time
+      endTime = simulatorPtr->simClock.now();
+
+      // update processor busy time
+      busyTime += SimClock::toSeconds( endTime - startTime );
+
+      // run application desciptor end 
+      actionOutput << SimClock::toSeconds( endTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": end processing action \n";
+      printAction( simulatorPtr, actionOutput );      
+   }
+
+   // input action type
+   else if( currentAction->actionType == 'I' )
+   {
+      // set current time
+      startTime = simulatorPtr->simClock.now();
+
+      // input descriptor start
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start " << currentAction->descriptorName() << " input \n"; 
+      printAction( simulatorPtr, actionOutput );
+
+      // run for specified time
+      waitForTime( simulatorPtr, startTime + runTime );
+
+      // set end time
+      endTime = simulatorPtr->simClock.now();
+
+      // input desciptor end 
+      actionOutput << SimClock::toSeconds( endTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": end " << currentAction->descriptorName() << " input \n";
+      printAction( simulatorPtr, actionOutput );
+   }
+
+   // output action type
+   else if( currentAction->actionType == 'O' )
+   {
+      // set current time
+      startTime = simulatorPtr->simClock.now();
+
+      // output descriptor start
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start " << currentAction->descriptorName() << " output \n"; 
+      printAction( simulatorPtr, actionOutput );
+      
+      // run for specified time
+      waitForTime( simulatorPtr, startTime + runTime );
+
+      // set end time
+      endTime = simulatorPtr->simClock.now();
+
+      // output desciptor end 
+      actionOutput << SimClock::toSeconds( endTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": end " << currentAction->descriptorName() << " output \n";
+      printAction( simulatorPtr, actionOutput );
+   }   
+
+   // memory action type
+   else if( currentAction->actionType == 'M' )
+   {
+      busyTime += runMemoryAction( simulatorPtr, currentAction );
+   }
+
+   // unrecognized action type
+   else 
+   {
+      actionOutput << simulatorPtr->simClock.currentTime();
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": unrecognized action \n";
+      printAction( simulatorPtr, actionOutput );
+   }   
+
+   // return processor time used
+   return busyTime;
+}
+
+/**
+quantumRunner
+
+Simulates execution of the current action for given time quantum.
+A worker thread calls this function for each action in threadActionsQuantum(). 
+The action is run by runActionQuantum() and its processor time is added to
+the simulator's processor busy time.
+
+@param void pointer to simulatorConfig with current action
+@pre a valid action is given
+@post action is blocked or completed, and logged
+@return void
+*/
+void *quantumRunner( void* simulatorVoidPtr )
+{
+   // set void pointer to OSCB pointer
+   OSCB* simulatorPtr = static_cast<OSCB*>( simulatorVoidPtr );
+
+   // run action for one quantum
+   simulatorPtr->cpuBusyTime += runActionQuantum( simulatorPtr, simulatorPtr->currentAction, simulatorPtr->currentQuantum );
+
+   // end action
+   return NULL;
+}
+
+/**
+runActionQuantum
+
+Simulates execution of action for given time quantum.
+Prints appropriate information by calling printAction(),
+waits until it is blocked or completed, according to appropriate cycle time and then
+returns so the process can either Exit or return to Ready queue.
+
+@param simulatorPtr pointer to OSCB object with configuration information
+@param currentAction pointer to the action to run
+@param quantum time quantum to run for (cycles)
+@pre a valid action is given
+@post action is blocked or completed, and logged
+@return double with processor time used by action (seconds)
+*/
+double runActionQuantum( OSCB* simulatorPtr, Action* currentAction, float quantum )
+{
+   // initialize variables
+
+      // processor time used
+      double busyTime = 0;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+      string endStatus;
+
+      // action start and end time, and run duration (nsec)
+      int64_t startTime;
+      int64_t endTime;
+      int64_t runTime;
+
+      // memory actions take at most one cycle, so always complete
+      if( currentAction->actionType == 'M' )
+      {
+         busyTime += runMemoryAction( simulatorPtr, currentAction );
+         currentAction->actionCycle = 0;
+
+         return busyTime;
+      }
+
+      // for if action will complete within given time quantum
+      if( quantum >= currentAction->actionCycle )
+      {
+         // run for remaining cycles of action
+         runTime = SimClock::fromMsec( currentAction->actionCycle * getCycleTime( simulatorPtr, currentAction->descriptorID ) );
+
+         // update action status to exit 
+         endStatus = ": end ";
+      }
+
+      // for if action will not complete in this time quantum
+      else
+      {
+         // run for whole quantum
+         runTime = SimClock::fromMsec( quantum * getCycleTime( simulatorPtr, currentAction->descriptorID ) );
+
+         // update action status to blocked
+         endStatus = " : block ";
+      }
+      
+      // update number of remaining cycles (for SRTF-P)
+      currentAction->actionCycle = currentAction->actionCycle - quantum;
+
+   // application action type
+   if( currentAction->actionType == 'A' )
+   {
+      // start application descriptor
+      if( currentAction->descriptorID == DESC_START )
+      {
+         actionOutput << simulatorPtr->simClock.currentTime();
+         actionOutput << " - " << "OS: preparing process " << currentAction->pcbID << endl;   
+         printAction( simulatorPtr, actionOutput );
+      }      
+
+      // end application descriptor
+      else
+      {
+         actionOutput << simulatorPtr->simClock.currentTime();
+         actionOutput << " - " << "OS: removing process " << currentAction->pcbID << endl; 
+         printAction( simulatorPtr, actionOutput );     
+
+         // free memory frames of process
+         simulatorPtr->memory.release( currentAction->pcbID );
+      }
+       
+   }
+
+   // process action type
+   else if( currentAction->actionType == 'P' )
+   {
+      // set current time
+      startTime = simulatorPtr->simClock.now();
+
+      // run application descriptor start
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start " << "processing action \n"; 
+      printAction( simulatorPtr, actionOutput );
+
+      // run for specified time
+      waitForTime( simulatorPtr, startTime + runTime );
+
+      // set end time
+      endTime = simulatorPtr->simClock.now();
+
+      // update processor busy time
+      busyTime += SimClock::toSeconds( endTime - startTime );
+
+      // run application desciptor end 
+      actionOutput << SimClock::toSeconds( endTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << endStatus << "processing action \n";
+      printAction( simulatorPtr, actionOutput );      
+   }
+
+   // input action type
+   else if( currentAction->actionType == 'I' )
+   {
+      // set current time
+      startTime = simulatorPtr->simClock.now();
+
+      // input descriptor start
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start " << currentAction->descriptorName() << " input \n"; 
+      printAction( simulatorPtr, actionOutput );
+
+      // run for specified time
+      waitForTime( simulatorPtr, startTime + runTime );
+
+      // set end time
+      endTime = simulatorPtr->simClock.now();
+
+      // input desciptor end 
+      actionOutput << SimClock::toSeconds( endTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << endStatus << currentAction->descriptorName() << " input \n";
+      printAction( simulatorPtr, actionOutput );
+   }
+
+   // output action type
+   else if( currentAction->actionType == 'O' )
+   {
+      // set current time
+      startTime = simulatorPtr->simClock.now();
+
+      // output descriptor start
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start " << currentAction->descriptorName() << " output \n"; 
+      printAction( simulatorPtr, actionOutput );
+      
+      // run for specified time
+      waitForTime( simulatorPtr, startTime + runTime );
+
+      // set end time
+      endTime = simulatorPtr->simClock.now();
+
+      // output desciptor end 
+      actionOutput << SimClock::toSeconds( endTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << endStatus << currentAction->descriptorName() << " output \n";
+      printAction( simulatorPtr, actionOutput );
+   }   
+
+   // unrecognized action type
+   else 
+   {
+      actionOutput << simulatorPtr->simClock.currentTime();
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": unrecognized action \n";
+      printAction( simulatorPtr, actionOutput );
+   }   
+
+   // return processor time used
+   return busyTime;
+}
+
+/**
+findRunCycles
+
+Returns the cycles an action runs for in one time quantum: the whole
+quantum, or the cycles left if the action completes sooner. Memory
+actions always complete in one cycle.
+
+@param currentAction action to run
+@param quantum time quantum to run for (cycles)
+@pre none
+@post none
+@return float with cycles action will run for
+*/
+float findRunCycles( const Action& currentAction, float quantum )
+{
+   // memory actions take at most one cycle
+   if( currentAction.actionType == 'M' )
+   {
+      return 1;
+   }
+
+   return min( quantum, currentAction.actionCycle );
+}
+
+/**
+runMemoryAction
+
+Simulates a memory action. M(allocate) only logs the memory allocated
+(pages are loaded when first accessed). M(access) looks up the page of
+its address; if the page is not resident, the page fault first waits one
+hard drive cycle while the page is read. The access itself takes one
+processor cycle.
+
+@param simulatorPtr pointer to OSCB object with configuration information
+@param currentAction pointer to the memory action to run
+@pre a valid memory action is given
+@post action is completed and logged
+@return double with processor time used by action (seconds)
+*/
+double runMemoryAction( OSCB* simulatorPtr, Action* currentAction )
+{
+   // initialize variables
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+      // action start and end time (nsec)
+      int64_t startTime;
+      int64_t endTime;
+
+      // page of address
+      int page = simulatorPtr->memory.findPage( currentAction->actionCycle );
+
+   // allocate descriptor
+   if( currentAction->descriptorID == DESC_ALLOCATE )
+   {
+      actionOutput << simulatorPtr->simClock.currentTime();
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": allocating " << (int) currentAction->actionCycle << " kB of memory \n";
+      printAction( simulatorPtr, actionOutput );
+
+      return 0;
+   }
+
+   // page fault, read page from hard drive
+   if( !simulatorPtr->memory.access( currentAction->pcbID, page ) )
+   {
+      startTime = simulatorPtr->simClock.now();
+
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start page fault, reading page " << page << " \n";
+      printAction( simulatorPtr, actionOutput );
+
+      waitForTime( simulatorPtr, startTime + SimClock::fromMsec( getCycleTime( simulatorPtr, DESC_HARD_DRIVE ) ) );
+
+      actionOutput << simulatorPtr->simClock.currentTime();
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": end page fault, reading page " << page << " \n";
+      printAction( simulatorPtr, actionOutput );
+   }
+
+   // set current time
+   startTime = simulatorPtr->simClock.now();
+
+   // access descriptor start
+   actionOutput << SimClock::toSeconds( startTime );
+   actionOutput << " - " << "Process " << currentAction->pcbID << ": start memory access, page " << page << " \n";
+   printAction( simulatorPtr, actionOutput );
+
+   // run for one cycle
+   waitForTime( simulatorPtr, startTime + SimClock::fromMsec( getCycleTime( simulatorPtr, DESC_ACCESS ) ) );
+
+   // set end time
+   endTime = simulatorPtr->simClock.now();
+
+   // access descriptor end
+   actionOutput << SimClock::toSeconds( endTime );
+   actionOutput << " - " << "Process " << currentAction->pcbID << ": end memory access, page " << page << " \n";
+   printAction( simulatorPtr, actionOutput );
+
+   // return processor time used
+   return SimClock::toSeconds( endTime - startTime );
+}
+
+/**
+chargeDispatch
+
+Simulates the overhead of dispatching a process on a processor: the
+dispatch time, the context switch time if the processor last ran
+another process, and the migration penalty if the process last ran on
+another processor. The processor waits out the overhead before the
+process runs, and it is logged. Nothing is waited or logged when
+dispatching is free.
+
+@param simulatorPtr pointer to OSCB object with configuration information
+@param processor processor dispatching (from 0)
+@param process process being dispatched
+@pre process was selected and not yet marked dispatched
+@post overhead was counted and waited out
+@return double with time process starts running (seconds)
+*/
+double chargeDispatch( OSCB* simulatorPtr, int processor, PCB& process )
+{
+   // initialize variables
+   int64_t cost = simulatorPtr->dispatchCost.charge( processor, process );
+   int64_t startTime;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+   // check for free dispatch
+   if( cost > 0 )
+   {
+      // log overhead
+      startTime = simulatorPtr->simClock.now();
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "OS: dispatching process " << process.processID << " (" << (double) cost / NSEC_PER_MSEC << " msec overhead) \n";
+      printAction( simulatorPtr, actionOutput );
+
+      // wait out overhead
+      waitForTime( simulatorPtr, startTime + cost );
+   }
+
+   return simulatorPtr->simClock.currentTime();
+}
+
+/**
+startIO
+
+Checks if the next action of the running process is an I/O action, or a
+memory access to a page that is not resident (a page fault).
+If so, the process is moved into the Blocked queue and the action is
+sent to its device (the hard drive, for a page fault), where it runs
+while the processor runs other processes. The process returns to the
+Ready queue from handleInterrupts once the device has completed the action.
+
+@param simulatorConfig reference to OSCB object with configuration information
+@param runningQueue a list of PCB objects that holds the running process
+@param blockedQueue a list of PCB objects waiting on I/O
+@pre process was selected and moved into runningQueue
+@post an I/O process was moved to blockedQueue and its device request was queued
+@return bool representing process was blocked for I/O
+*/
+bool startIO( OSCB &simulatorConfig, list<PCB> &runningQueue, list<PCB> &blockedQueue )
+{
+   // initialize variables
+   IORequest newRequest;
+   int deviceID;
+
+   // check for I/O action
+   if( runningQueue.empty() )
+   {
+      return false;
+   }
+
+   deviceID = prepareIO( simulatorConfig, runningQueue.front(), newRequest );
+
+   if( deviceID == NO_DESCRIPTOR )
+   {
+      return false;
+   }
+
+   // change process to blocked state
+   runningQueue.front().block( simulatorConfig.simClock.currentTime() );
+
+   // move process into Blocked queue
+   blockedQueue.splice( blockedQueue.end(), runningQueue, runningQueue.begin() );
+   newRequest.process = --blockedQueue.end();
+
+   // send request to device
+   simulatorConfig.devices[ deviceID ].request( newRequest );
+
+   // return blocked
+   return true;
+}
+
+/**
+prepareIO
+
+Checks if the next action of a process runs on a device (an I/O action,
+or a memory access to a page that is not resident), and if so fills in
+the time of its device request. A page fault loads the page here; the
+access completes once the hard drive has read it.
+
+@param simulatorConfig reference to OSCB object with configuration information
+@param process process about to run
+@param newRequest device request to fill in (except its process)
+@pre none
+@post request run time was set and estimated run time updated, if action runs on a device
+@return int with device ID, or NO_DESCRIPTOR if action runs on the processor
+*/
+int prepareIO( OSCB &simulatorConfig, PCB& process, IORequest& newRequest )
+{
+   // initialize variables
+   Action* nextAction;
+   float cycleTime;
+   int deviceID;
+   int page;
+
+   // check for no actions
+   if( process.actions.empty() )
+   {
+      return NO_DESCRIPTOR;
+   }
+
+   nextAction = &( process.actions.front() );
+
+   // check for page fault
+   if( nextAction->actionType == 'M' )
+   {
+      if( nextAction->descriptorID != DESC_ACCESS )
+      {
+         return NO_DESCRIPTOR;
+      }
+
+      page = simulatorConfig.memory.findPage( nextAction->actionCycle );
+
+      if( simulatorConfig.memory.isResident( nextAction->pcbID, page ) )
+      {
+         return NO_DESCRIPTOR;
+      }
+
+      // load page (access completes once page is read)
+      simulatorConfig.memory.access( nextAction->pcbID, page );
+
+      // read page in one hard drive cycle
+      deviceID = DESC_HARD_DRIVE;
+      newRequest.runTime = SimClock::fromMsec( getCycleTime( &simulatorConfig, DESC_HARD_DRIVE ) );
+
+      // update remaining estimated process run time (for SRTF-P)
+      process.estimatedRuntime -= getCycleTime( &simulatorConfig, DESC_ACCESS );
+   }
+
+   else if( nextAction->actionType == 'I' || nextAction->actionType == 'O' )
+   {
+      // find device run time
+      deviceID = nextAction->descriptorID;
+      cycleTime = getCycleTime( &simulatorConfig, deviceID );
+      newRequest.runTime = SimClock::fromMsec( nextAction->actionCycle * cycleTime );
+
+      // update remaining estimated process run time (for SRTF-P)
+      process.estimatedRuntime -= nextAction->actionCycle * cycleTime;
+   }
+
+   else
+   {
+      return NO_DESCRIPTOR;
+   }
+
+   return deviceID;
+}
+
+/**
+handleInterrupts
+
+Moves each process whose I/O has completed from the Blocked queue back
+into the Ready queue, at the position given by the scheduling policy,
+and admits each process that has arrived from the Arriving queue.
+If no process is ready, waits until a device completes or a process arrives.
+
+@param simulatorConfig reference to OSCB object with configuration information
+@param readyQueue list of PCB objects in the Ready queue
+@param blockedQueue list of PCB objects waiting on I/O
+@param arrivingQueue list of PCB objects that have not yet arrived
+@param policy scheduling policy that places returning processes
+@pre devices were started
+@post processes with completed I/O (or that arrived) were moved into Ready queue
+@return void
+*/
+template <class Policy>
+void handleInterrupts( OSCB &simulatorConfig, list<PCB> &readyQueue, list<PCB> &blockedQueue, list<PCB> &arrivingQueue, Policy& policy )
+{
+   // initialize variables
+   list< list<PCB>::iterator > completed;
+   list<PCB>::iterator readyProcess;
+   list<PCB> arrived;
+   double eventTime;
+
+   // collect interrupts (wait for one if nothing can run)
+   simulatorConfig.interrupts.collect( completed, readyQueue.empty() );
+   eventTime = simulatorConfig.simClock.currentTime();
+
+   // return each process to Ready queue
+   while( !completed.empty() )
+   {
+      readyProcess = completed.front();
+      completed.pop_front();
+
+      // admit arrived process
+      if( readyProcess->state == "Enter" )
+      {
+         readyProcess->arrive( eventTime );
+         arrived.splice( arrived.end(), arrivingQueue, readyProcess );
+         policy.admit( readyQueue, arrived, eventTime );
+
+         continue;
+      }
+
+      // change process to ready state
+      readyProcess->unblock( eventTime );
+
+      // move process into Ready queue
+      policy.onReady( readyQueue, blockedQueue, readyProcess, eventTime );
+   }
+}
+
+/**
+findReadyPosition
+
+Finds where a process returning from I/O goes in a processor run queue.
+FIFO-P processes return in order of process number, other scheduling
+codes return to the end of the run queue.
+
+@param simulatorConfig reference to OSCB object with configuration information
+@param readyQueue list of PCB objects in the Ready queue
+@param process process returning to the Ready queue
+@pre none
+@post none
+@return list<PCB>::iterator to insert process before
+*/
+list<PCB>::iterator findReadyPosition( OSCB &simulatorConfig, list<PCB> &readyQueue, const PCB& process )
+{
+   // for fifo-p, keep process number order
+   if( simulatorConfig.policyID == POLICY_FIFO_P )
+   {
+      return findIDPosition( readyQueue, process );
+   }
+
+   return readyQueue.end();
+}
+
+/**
+deviceRunner
+
+Runs on the worker thread of each I/O device.
+Takes requests from the device queue in order, logs and waits for each
+I/O action (or page read for a page fault, on the hard drive), removes
+the completed action from its process, and posts an interrupt so the
+scheduler returns the process to the Ready queue.
+
+@param deviceVoidPtr void pointer to the IODevice
+@pre device was started
+@post device was stopped
+@return void
+*/
+void *deviceRunner( void* deviceVoidPtr )
+{
+   // initialize variables
+
+      // set void pointer to IODevice pointer
+      IODevice* devicePtr = static_cast<IODevice*>( deviceVoidPtr );
+      OSCB* simulatorPtr = devicePtr->simulatorPtr;
+      IORequest currentRequest;
+      Action* currentAction;
+      string description;
+      stringstream pageOutput;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+      // request start and end time (nsec)
+      int64_t startTime;
+      int64_t endTime;
+
+   // post log lines as device
+   simulatorPtr->logWriter.attach( devicePtr->logProducer );
+
+   // run each request
+   while( devicePtr->nextRequest( currentRequest ) )
+   {
+      currentAction = &( currentRequest.process->actions.front() );
+
+      // check action direction
+      if( currentAction->actionType == 'I' )
+      {
+         description = string( currentAction->descriptorName() ) + " input \n";
+      }
+      else if( currentAction->actionType == 'O' )
+      {
+         description = string( currentAction->descriptorName() ) + " output \n";
+      }
+
+      // page fault (memory access action)
+      else
+      {
+         pageOutput.str( string() );
+         pageOutput << "page fault, reading page " << simulatorPtr->memory.findPage( currentAction->actionCycle ) << " \n";
+         description = pageOutput.str();
+      }
+
+      // set current time
+      startTime = simulatorPtr->simClock.now();
 
-            // execute process
-            remainingActions = threadActionQuantum( simulatorConfig, runningQueue );
+      // device descriptor start
+      actionOutput << SimClock::toSeconds( startTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": start " << description; 
+      printAction( simulatorPtr, actionOutput );
+
+      // run for specified time
+      waitForTime( simulatorPtr, startTime + currentRequest.runTime );
 
-            // remove process from Ready queue
-            processes.pop_front();
+      // set end time
+      endTime = simulatorPtr->simClock.now();
 
-            // check state
+      // device descriptor end
+      actionOutput << SimClock::toSeconds( endTime );
+      actionOutput << " - " << "Process " << currentAction->pcbID << ": end " << description; 
+      printAction( simulatorPtr, actionOutput );
 
-               // check for blocked
-               if( remainingActions > 0 )
-               {
-                  // changed to blocked state
-                  runningQueue.front().state = "Blocked";
+      // update device usage
+      devicePtr->busyTime += SimClock::toSeconds( endTime - startTime );
+      devicePtr->requestCount++;
 
-                  // insert back into Ready queue (at end because queue)
-                  processes.push_back( *(runningQueue.begin()) );
-               }
+      // remove completed action
+      currentRequest.process->actions.pop();
 
-               // check for completion
-               else 
-               {
-                  // change process to exit state
-                  runningQueue.front().state = "Exit"; 
-               }        
+      // interrupt processor
+      simulatorPtr->interrupts.post( currentRequest.process );
+   }
 
-            // remove process from Running/Blocked queue
-            runningQueue.pop_front();  
+   // end device
+   return NULL;
+}
+
+/**
+arrivalRunner
+
+Runs on the worker thread of the arrival timer.
+Takes processes in order of arrival, waits until simulated time reaches
+the arrival time of each (the run time of its request), logs it and
+posts an interrupt so the scheduler admits it into the Ready queue.
+
+@param deviceVoidPtr void pointer to the arrivals IODevice
+@pre device was started
+@post device was stopped
+@return void
+*/
+void *arrivalRunner( void* deviceVoidPtr )
+{
+   // initialize variables
+
+      // set void pointer to IODevice pointer
+      IODevice* devicePtr = static_cast<IODevice*>( deviceVoidPtr );
+      OSCB* simulatorPtr = devicePtr->simulatorPtr;
+      IORequest currentRequest;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+   // post log lines as arrival timer
+   simulatorPtr->logWriter.attach( devicePtr->logProducer );
+
+   // return each process at its arrival time
+   while( devicePtr->nextRequest( currentRequest ) )
+   {
+      waitForTime( simulatorPtr, currentRequest.runTime );
+
+      actionOutput << simulatorPtr->simClock.currentTime();
+      actionOutput << " - " << "Process " << currentRequest.process->processID << ": arrived \n";
+      printAction( simulatorPtr, actionOutput );
+
+      devicePtr->requestCount++;
+
+      // interrupt processor
+      simulatorPtr->interrupts.post( currentRequest.process );
+   }
+
+   // end arrival timer
+   return NULL;
+}
+
+/**
+holdArrivals
+
+Moves each newly read process that has not yet arrived into the Arriving
+queue (in Enter state), and asks the arrival timer to return it at its
+arrival time. Processes that have arrived are left to be admitted.
+
+@param simulatorConfig reference to OSCB object with clock and arrival timer
+@param newProcesses processes read from meta-data file, in arrival order
+@param arrivingQueue list to hold processes that have not yet arrived
+@pre arrival timer was started
+@post only arrived processes are left in newProcesses
+@return void
+*/
+void holdArrivals( OSCB &simulatorConfig, list<PCB>& newProcesses, list<PCB>& arrivingQueue )
+{
+   // initialize variables
+   list<PCB>::iterator process = newProcesses.begin();
+   list<PCB>::iterator nextProcess;
+   IORequest newRequest;
+   double currentTime = simulatorConfig.simClock.currentTime();
+
+   while( process != newProcesses.end() )
+   {
+      nextProcess = process;
+      nextProcess++;
+
+      // check for process not yet arrived
+      if( process->arrivalTime > currentTime )
+      {
+         process->state = "Enter";
+         arrivingQueue.splice( arrivingQueue.end(), newProcesses, process );
+
+         // return process at its arrival time
+         newRequest.process = process;
+         newRequest.runTime = (int64_t)( process->arrivalTime * NSEC_PER_SEC + 0.5 );
+         simulatorConfig.arrivals.request( newRequest );
+      }
+
+      process = nextProcess;
+   }
+}
+
+/**
+runMultiCore
+
+Runs processes on several simulated processors at once.
+Processes are shared out among the processor run queues (or all placed
+in the first queue when the run queue is shared), then each processor
+runs processorRunner on its own thread until every process has exited.
+In lock-free mode the processes stay in the first queue, which is not
+changed while they run, and handles to them are queued in the ready ring
+for ringRunner instead. Processes that have not yet arrived wait in the
+Blocked queue (or the first queue, in lock-free mode) until the arrival
+timer returns them.
+
+@param simulatorConfig reference to OSCB object with configuration information
+@param processes a list of process control blocks to be executed
+@pre valid config information and meta-data was saved, devices were started
+@post each PCB in the list was executed according to scheduling code
+@return int with number of processes that reached Exit state
+*/
+int runMultiCore( OSCB &simulatorConfig, list<PCB>& processes )
+{
+   // initialize variables
+   ProcessorSet& cpus = simulatorConfig.cpus;
+   int index;
+   list<PCB>::iterator selected;
+   int queueIndex = 0;
+   int targetIndex;
+
+   // create processors
+   cpus.processors.resize( simulatorConfig.processorCount );
+
+   for( index = 0; index < simulatorConfig.processorCount; index++ )
+   {
+      cpus.processors[ index ].processorID = index + 1;
+      cpus.processors[ index ].simulatorPtr = &simulatorConfig;
+   }
+
+   // hold processes that have not yet arrived
+   cpus.processCount = processes.size();
+
+   holdArrivals( simulatorConfig, processes, cpus.lockFree ? cpus.processors[ 0 ].runQueue : cpus.blockedQueue );
+
+   for( selected = cpus.blockedQueue.begin(); selected != cpus.blockedQueue.end(); selected++ )
+   {
+      selected->lastProcessor = queueIndex;
+      queueIndex = ( queueIndex + 1 ) % simulatorConfig.processorCount;
+   }
+
+   // share out processes among run queues
+   while( !processes.empty() )
+   {
+      // find run queue
+      targetIndex = queueIndex;
+
+      if( cpus.sharedQueue )
+      {
+         targetIndex = 0;
+      }
+
+      processes.front().lastProcessor = targetIndex;
+
+      // move process into run queue
+      cpus.processors[ targetIndex ].runQueue.splice( cpus.processors[ targetIndex ].runQueue.end(), processes, processes.begin() );
+
+      queueIndex = ( queueIndex + 1 ) % simulatorConfig.processorCount;
+   }
+
+   // queue a handle to each process in ring (never full, a process is
+   // queued at most once)
+   if( cpus.lockFree )
+   {
+      cpus.readyRing.reserve( cpus.processCount );
+
+      for( selected = cpus.processors[ 0 ].runQueue.begin(); selected != cpus.processors[ 0 ].runQueue.end(); selected++ )
+      {
+         if( selected->state != "Enter" )
+         {
+            cpus.readyRing.push( selected );
          }
-      }      
+      }
+   }
+
+   // hand this thread's place on the clock and in the log to the processors
+   for( index = 0; index < simulatorConfig.processorCount; index++ )
+   {
+      simulatorConfig.simClock.actorWake();
+      cpus.processors[ index ].logProducer = simulatorConfig.logWriter.addProducer();
+      simulatorConfig.logWriter.wake( cpus.processors[ index ].logProducer );
+   }
+
+   simulatorConfig.simClock.actorIdle();
+   simulatorConfig.logWriter.idle();
+
+   // start each processor
+   for( index = 0; index < simulatorConfig.processorCount; index++ )
+   {
+      pthread_create( &( cpus.processors[ index ].tid ), NULL, cpus.lockFree ? ringRunner : processorRunner, &( cpus.processors[ index ] ) );
+   }
+
+   // wait for each processor
+   for( index = 0; index < simulatorConfig.processorCount; index++ )
+   {
+      pthread_join( cpus.processors[ index ].tid, NULL );
+   }
+
+   simulatorConfig.simClock.actorWake();
+   simulatorConfig.logWriter.resume();
+
+   // remove exited processes (kept for their handles in lock-free mode)
+   cpus.processors[ 0 ].runQueue.clear();
 
-      // shortest remaining time first preemptive (srtf-p)
-      if( simulatorConfig.schedulingCode == "SRTF-P" )
+   // total processor busy time
+   for( index = 0; index < simulatorConfig.processorCount; index++ )
+   {
+      simulatorConfig.cpuBusyTime += cpus.processors[ index ].busyTime;
+   }
+
+   // return completed processes
+   return cpus.completedCount;
+}
+
+/**
+processorRunner
+
+Runs on the thread of each simulated processor.
+Repeatedly returns processes with completed I/O to their run queues,
+selects the next process from its run queue (or steals one) according
+to scheduling code, and runs it. Preemptive codes run one time quantum
+and send I/O actions to their devices; other codes run the whole process.
+Waits for an interrupt when there is nothing to run, and ends once every
+process has exited.
+
+@param processorVoidPtr void pointer to the Processor
+@pre processes were shared out among run queues
+@post every process has exited
+@return void
+*/
+void *processorRunner( void* processorVoidPtr )
+{
+   // initialize variables
+
+      // set void pointer to Processor pointer
+      Processor* cpuPtr = static_cast<Processor*>( processorVoidPtr );
+      OSCB* simulatorPtr = cpuPtr->simulatorPtr;
+      ProcessorSet& cpus = simulatorPtr->cpus;
+      bool preemptive = isPreemptive( simulatorPtr->policyID );
+      list<PCB>* sourceQueue;
+      list<PCB>* ownQueue;
+      list<PCB>::iterator selected;
+      PCB* process;
+      float remainingActions;
+      double dispatchTime;
+      int lastGeneration;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+      // find own run queue
+      ownQueue = &( cpuPtr->runQueue );
+
+      if( cpus.sharedQueue )
+      {
+         ownQueue = &( cpus.processors[ 0 ].runQueue );
+      }
+
+   // post log lines as processor
+   simulatorPtr->logWriter.attach( cpuPtr->logProducer );
+
+   pthread_mutex_lock( &cpus.lock );
+
+   while( true )
+   {
+      // return processes with completed I/O to run queues
+      requeueInterrupts( *simulatorPtr );
+
+      // find queue to take next process from
+      sourceQueue = findWork( *simulatorPtr, *cpuPtr );
+
+      // no process to run
+      if( sourceQueue == NULL )
       {
-         // dequeue each process and run
-         while( !processes.empty() )
+         // check for end of simulation
+         if( cpus.completedCount == cpus.processCount )
          {
-            // prepare processes
-            actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-            actionOutput << " - " << "OS: selecting next process \n";
-            printAction( simulatorPtr, actionOutput );  
-
-            // select next process
-
-               // check for > 1 process
-               if( processes.size() > 1 )
-               {
-                  // find minimum process
-                  minProcess = min_element( processes.begin(), processes.end(), compareRuntimes );
-               }
-
-               // for one process
-               else
-               {
-                  // set process to execute
-                  minProcess = processes.begin();
-               }
-
-            // move process into Running/Blocked queue  
-            runningQueue.push_front( *minProcess );
-
-            // change process to running state
-            runningQueue.front().state = "Running";
-
-            // execute process
-            remainingActions = threadActionQuantum( simulatorConfig, runningQueue );
-
-            // check state
-
-               // remove process from Ready queue
-               processes.erase( minProcess );
-
-               // check for blocked
-               if( remainingActions > 0 )
-               {
-                  // changed to blocked state
-                  runningQueue.front().state = "Blocked";
-
-                  // insert back into Ready queue 
-                  processes.push_back( *(runningQueue.begin()) );
-               }
-
-               // check for completion
-               else 
-               {
-                  // change process to exit state
-                  runningQueue.front().state = "Exit"; 
-               }        
+            // wake other waiting processors so they also end
+            simulatorPtr->interrupts.notify();
 
-            // remove process from Running/Blocked queue
-            runningQueue.pop_front();  
+            break;
          }
-      }      
 
-      // first-in first-out scheduling (fifo)
-      if( simulatorConfig.schedulingCode == "FIFO" )
+         // wait for interrupt or newly ready process
+         lastGeneration = simulatorPtr->interrupts.generation();
+
+         pthread_mutex_unlock( &cpus.lock );
+         simulatorPtr->interrupts.wait( lastGeneration );
+         pthread_mutex_lock( &cpus.lock );
+
+         continue;
+      }
+
+      // select next process and move it onto processor
+      selected = selectProcess( *simulatorPtr, *sourceQueue );
+      cpuPtr->running.splice( cpuPtr->running.begin(), *sourceQueue, selected );
+      cpuPtr->dispatchCount++;
+
+      if( sourceQueue != ownQueue )
+      {
+         cpuPtr->stealCount++;
+      }
+
+      pthread_mutex_unlock( &cpus.lock );
+
+      // prepare processes
+      process = &( cpuPtr->running.front() );
+      actionOutput << simulatorPtr->simClock.currentTime();
+      actionOutput << " - " << "OS: selecting next process for processor " << cpuPtr->processorID << " \n";
+      printAction( simulatorPtr, actionOutput );  
+
+      // change process to running state (after dispatch overhead)
+      dispatchTime = chargeDispatch( simulatorPtr, cpuPtr->processorID - 1, *process );
+      process->dispatch( dispatchTime );
+      process->lastProcessor = cpuPtr->processorID - 1;
+
+      // preemptive scheduling codes
+      if( preemptive )
       {
-         // dequeue each process and run
-         while( !processes.empty() )
+         pthread_mutex_lock( &cpus.lock );
+
+         // send I/O action to its device (process is Blocked until interrupt)
+         if( startIO( *simulatorPtr, cpuPtr->running, cpus.blockedQueue ) )
          {
-            // prepare processes
-            actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-            actionOutput << " - " << "OS: selecting next process \n";
-            printAction( simulatorPtr, actionOutput );    
+            continue;
+         }
+
+         pthread_mutex_unlock( &cpus.lock );
+
+         // execute process for one quantum
+         remainingActions = runProcessQuantum( simulatorPtr, *process, cpuPtr->busyTime );
+
+         pthread_mutex_lock( &cpus.lock );
 
-            // change process to running state
-            (processes.front()).state = "Running";
+         // check for blocked
+         if( remainingActions > 0 )
+         {
+            // return process to run queue
+            process->preempt( simulatorPtr->simClock.currentTime() );
+
+            // insert back into run queue (at front for fifo-p)
+            if( simulatorPtr->policyID == POLICY_FIFO_P )
+            {
+               ownQueue->splice( ownQueue->begin(), cpuPtr->running, cpuPtr->running.begin() );
+            }
+            else
+            {
+               ownQueue->splice( ownQueue->end(), cpuPtr->running, cpuPtr->running.begin() );
+            }
 
-            // execute process
-            threadActions( simulatorConfig, *(processes.begin()) );
+            // wake idle processors that may take it
+            simulatorPtr->interrupts.notify();
+         }
 
+         // check for completion
+         else
+         {
             // change process to exit state
-            (processes.front()).state = "Exit";            
+            process->exit( simulatorPtr->simClock.currentTime() );
+            simulatorPtr->runStats.record( *process );
+            cpus.completedCount++;
+            cpuPtr->running.pop_front();
+         }
+      }
 
-            // remove process
-            processes.pop_front();            
+      // non-preemptive scheduling codes
+      else
+      {
+         // execute each action of process
+         while( !process->actions.empty() )
+         {
+            cpuPtr->busyTime += runAction( simulatorPtr, &( process->actions.front() ) );
+            process->actions.pop();
          }
+
+         pthread_mutex_lock( &cpus.lock );
+
+         // change process to exit state
+         process->exit( simulatorPtr->simClock.currentTime() );
+         simulatorPtr->runStats.record( *process );
+         cpus.completedCount++;
+         cpuPtr->running.pop_front();
       }
+   }
+
+   pthread_mutex_unlock( &cpus.lock );
+
+   // give up place on clock and in the log
+   simulatorPtr->simClock.actorIdle();
+   simulatorPtr->logWriter.idle();
+
+   // end processor
+   return NULL;
+}
+
+/**
+ringRunner
+
+Runs on the thread of each simulated processor in lock-free mode.
+Works like processorRunner with a shared run queue, but takes no lock:
+processes with completed I/O and preempted processes are pushed onto
+the ready ring, and the next process is popped from it (first in, first
+out). A process is run only by the processor that popped its handle,
+and blocked processes stay in place while their device runs.
+
+@param processorVoidPtr void pointer to the Processor
+@pre a handle to each process was queued in ready ring
+@post every process has exited
+@return void
+*/
+void *ringRunner( void* processorVoidPtr )
+{
+   // initialize variables
+
+      // set void pointer to Processor pointer
+      Processor* cpuPtr = static_cast<Processor*>( processorVoidPtr );
+      OSCB* simulatorPtr = cpuPtr->simulatorPtr;
+      ProcessorSet& cpus = simulatorPtr->cpus;
+      bool preemptive = isPreemptive( simulatorPtr->policyID );
+      list< list<PCB>::iterator > completed;
+      list<PCB>::iterator selected;
+      IORequest newRequest;
+      float remainingActions;
+      double dispatchTime;
+      int lastGeneration;
+      int deviceID;
+
+      // prepare output string
+      stringstream actionOutput;
+      actionOutput.precision( PRECISION );
+      actionOutput << fixed; 
+
+   // post log lines as processor
+   simulatorPtr->logWriter.attach( cpuPtr->logProducer );
+
+   while( true )
+   {
+      // note interrupts seen so far, so a push after the pop below wakes processor
+      lastGeneration = simulatorPtr->interrupts.generation();
 
-      // shortest job first scheduling (sjf)
-      if( simulatorConfig.schedulingCode == "SJF" )
+      // return processes with completed I/O (or that arrived) to ring
+      simulatorPtr->interrupts.collect( completed, false );
+
+      if( !completed.empty() )
       {
-         // sort all processes according to runtime
-         processes.sort( compareRuntimes );
+         while( !completed.empty() )
+         {
+            if( completed.front()->state == "Enter" )
+            {
+               completed.front()->arrive( simulatorPtr->simClock.currentTime() );
+            }
+            else
+            {
+               completed.front()->unblock( simulatorPtr->simClock.currentTime() );
+            }
+
+            cpus.readyRing.push( completed.front() );
+            completed.pop_front();
+         }
 
-         // dequeue each process and run
-         while( !processes.empty() )
+         // wake idle processors that may take them
+         simulatorPtr->interrupts.notify();
+      }
+
+      // no process to run
+      if( !cpus.readyRing.pop( selected ) )
+      {
+         // check for end of simulation
+         if( cpus.completedCount == cpus.processCount )
          {
-            // output preparing processes
-            actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-            actionOutput << " - " << "OS: selecting next process \n";
-            printAction( simulatorPtr, actionOutput ); 
+            // wake other waiting processors so they also end
+            simulatorPtr->interrupts.notify();
+
+            break;
+         }
 
-            // change process to running state
-            (processes.front()).state = "Running";            
+         // wait for interrupt or newly ready process
+         simulatorPtr->interrupts.wait( lastGeneration );
 
-            // execute process
-            threadActions( simulatorConfig, *(processes.begin()) );
+         continue;
+      }
 
-            // change process to exit state
-            (processes.front()).state = "Exit";   
+      cpuPtr->dispatchCount++;
 
-            // remove process
-            processes.pop_front();
-         }         
-      }      
+      // prepare processes
+      actionOutput << simulatorPtr->simClock.currentTime();
+      actionOutput << " - " << "OS: selecting next process for processor " << cpuPtr->processorID << " \n";
+      printAction( simulatorPtr, actionOutput );  
 
-      // shortest remaining time first scheduling (srtf)
-      if( simulatorConfig.schedulingCode == "SRTF" )
+      // change process to running state (after dispatch overhead)
+      dispatchTime = chargeDispatch( simulatorPtr, cpuPtr->processorID - 1, *selected );
+      selected->dispatch( dispatchTime );
+      selected->lastProcessor = cpuPtr->processorID - 1;
+
+      // preemptive scheduling codes
+      if( preemptive )
       {
-         // dequeue each process and run
-         while( !processes.empty() )
+         // send I/O action to its device (process is Blocked until interrupt)
+         deviceID = prepareIO( *simulatorPtr, *selected, newRequest );
+
+         if( deviceID != NO_DESCRIPTOR )
          {
-            // output preparing processes
-            actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-            actionOutput << " - " << "OS: selecting next process \n";
-            printAction( simulatorPtr, actionOutput );             
-
-            // run process
-
-               // check for > 1 process
-               if( processes.size() > 1 )
-               {
-                  // find minimum process
-                  minProcess = min_element( processes.begin(), processes.end(), compareRuntimes );
-               }
-
-               // for one process
-               else
-               {
-                  // set process to execute
-                  minProcess = processes.begin();
-               }
-
-               // change process to running state
-               minProcess->state = "Running";                
-             
-               // execute process
-               threadActions( simulatorConfig, *minProcess );
+            selected->block( simulatorPtr->simClock.currentTime() );
+            newRequest.process = selected;
+            simulatorPtr->devices[ deviceID ].request( newRequest );
 
-            // change process to exit state
-            minProcess->state = "Exit";           
+            continue;
+         }
 
-            // remove process
-            processes.erase( minProcess );
-         }          
-      }   
+         // execute process for one quantum
+         remainingActions = runProcessQuantum( simulatorPtr, *selected, cpuPtr->busyTime );
 
-   // end simulator
-   actionOutput << ((float)(clock()-simulatorConfig.timer)/CLOCKS_PER_SEC);
-   actionOutput << " - " << "Simulator program ending \n";
-   printAction( simulatorPtr, actionOutput );
-}
+         // check for blocked
+         if( remainingActions > 0 )
+         {
+            // return process to back of ring
+            selected->preempt( simulatorPtr->simClock.currentTime() );
+            cpus.readyRing.push( selected );
 
-/**
-compareRuntimes
+            // wake idle processors that may take it
+            simulatorPtr->interrupts.notify();
 
-Compares estimated remaining run times of two processes and returns
-true if first process has lower (or equal) runtime as process
-two, false otherwise. 
+            continue;
+         }
+      }
 
-@param first process to compare
-@param second process to compare
-@pre processes have been created and have estimated runtimes
-@post processes' estimated runtimes were compared
-@return bool indicating run time was lower for first process 
-*/
-bool compareRuntimes( const PCB& first, const PCB& second )
-{
-   // return true if first PCB has lower (or same) estimated runtime
-   // than second PCB, false otherwise
-   return( first.estimatedRuntime <= second.estimatedRuntime );
+      // non-preemptive scheduling codes
+      else
+      {
+         // execute each action of process
+         while( !selected->actions.empty() )
+         {
+            cpuPtr->busyTime += runAction( simulatorPtr, &( selected->actions.front() ) );
+            selected->actions.pop();
+         }
+      }
+
+      // change process to exit state
+      selected->exit( simulatorPtr->simClock.currentTime() );
+      simulatorPtr->runStats.record( *selected );
+      cpus.completedCount++;
+   }
+
+   // give up place on clock and in the log
+   simulatorPtr->simClock.actorIdle();
+   simulatorPtr->logWriter.idle();
+
+   // end processor
+   return NULL;
 }
 
 /**
-threadActions
+findWork
 
-Runs one process and creates threads for each action
-The start simulation action is executed, then processes actions in
-process control block in order of arrival from meta-data file. Lastly,
-the end simulation action is executed. Each action creates a thread
-and calls the runner function. Each thread is joined to previous threads
-upon exit. 
+Finds the run queue a processor should take its next process from.
+This is its own queue (or the shared queue), or, with work stealing,
+the longest queue of another processor when its own is empty.
 
-@param process process control block with process information
-@pre valid config information and meta-data was saved
-@post each action in the PCB was executed via a thread
-@return void 
+@param simulatorConfig reference to OSCB object with processors
+@param currentProcessor processor looking for work
+@pre processor lock is held
+@post none
+@return list<PCB>* to run queue with work, or NULL if there is none
 */
-void threadActions( OSCB &simulatorConfig, PCB& process )
+list<PCB>* findWork( OSCB &simulatorConfig, Processor& currentProcessor )
 {
    // initialize variables
-   int tidCount = process.actions.size(); // number of actions in queue
-   pthread_t tids[ tidCount ]; // an array of threads to be joined
-   pthread_attr_t attr;
-   void* simulatorVoidPtr;
-   int tidIndex = 0;  
+   ProcessorSet& cpus = simulatorConfig.cpus;
+   list<PCB>* victimQueue = NULL;
+   unsigned int index;
+
+   // check shared queue
+   if( cpus.sharedQueue )
+   {
+      if( cpus.processors[ 0 ].runQueue.empty() )
+      {
+         return NULL;
+      }
 
-   // get the default attributes
-   pthread_attr_init(&attr);
+      return &( cpus.processors[ 0 ].runQueue );
+   }
 
-   // thread each action in action queue
-   while( !( process.actions.empty() ) )
+   // check own queue
+   if( !currentProcessor.runQueue.empty() )
    {
-      // get first action in queue
-      simulatorConfig.currentAction = &(process.actions.front());
+      return &( currentProcessor.runQueue );
+   }
+
+   // check for work stealing
+   if( !cpus.workStealing )
+   {
+      return NULL;
+   }
+
+   // find longest queue of another processor
+   for( index = 0; index < cpus.processors.size(); index++ )
+   {
+      if( !cpus.processors[ index ].runQueue.empty() &&
+          ( victimQueue == NULL || cpus.processors[ index ].runQueue.size() > victimQueue->size() ) )
+      {
+         victimQueue = &( cpus.processors[ index ].runQueue );
+      }
+   }
+
+   return victimQueue;
+}
 
-      // save void pointer
-      simulatorVoidPtr = &(simulatorConfig);
+/**
+selectProcess
 
-      // create thread and run action
-      pthread_create( &( tids[ tidIndex ] ), &attr, runner, simulatorVoidPtr );
-      pthread_join( tids[ tidIndex ], NULL );
+Selects the next process to run from a run queue according to scheduling
+code. SJF, SRTF and SRTF-P take the lowest estimated remaining run time,
+other codes take the front of the queue.
 
-      // increment to next thread
-      tidIndex++;
+@param simulatorConfig reference to OSCB object with scheduling code
+@param readyQueue non-empty run queue to select from
+@pre readyQueue is not empty
+@post none
+@return list<PCB>::iterator to selected process
+*/
+list<PCB>::iterator selectProcess( OSCB &simulatorConfig, list<PCB>& readyQueue )
+{
+   // shortest job or remaining time
+   if( simulatorConfig.policyID == POLICY_SJF || simulatorConfig.policyID == POLICY_SRTF ||
+       simulatorConfig.policyID == POLICY_SRTF_P )
+   {
+      return min_element( readyQueue.begin(), readyQueue.end(), compareRuntimes );
+   }
 
-      // remove completed action
-      process.actions.pop();
-   }        
+   // first in queue
+   return readyQueue.begin();
 }
 
 /**
-threadActionsQuantum
+requeueInterrupts
 
-Creates a thread for an action of current process and runs for specified time quantum.
-After time quantum, process is Blocked and OS returns to runProcesses to select another process.
-The start simulation action is executed, then processes actions in process control block in order of
-arrival from meta-data file. Current process was already selected in runProcesses according to
-scheduling code. Lastly, the end simulation action is executed if that action has completed.
-Each action creates a thread and calls the quantumRunner function. Each thread is joined to previous threads
-upon completion, and blocked if incomplete. 
+Moves each process whose I/O has completed (or that has arrived) from the
+Blocked queue into the run queue of the processor it last ran on (or the
+shared queue), and wakes idle processors if any were moved.
 
-@param simulatorConfig reference to OSCB object with configuration information
-@param runningQueue a list of PCB objects that holds all currently running proceeses
-@pre valid config information and meta-data was saved
-@post each action in the PCB was executed via a thread
-@return float with remaining number of actions in running process 
+@param simulatorConfig reference to OSCB object with processors
+@pre processor lock is held
+@post processes with completed I/O were moved into run queues
+@return void
 */
-float threadActionQuantum( OSCB &simulatorConfig, list<PCB> &runningQueue )
+void requeueInterrupts( OSCB &simulatorConfig )
 {
    // initialize variables
-   int tidCount = runningQueue.front().actions.size(); // number of actions in queue
-   pthread_t tids[ tidCount ]; // an array of threads to be joined
-   pthread_attr_t attr;
-   void* simulatorVoidPtr;
-   int tidIndex = 0;  
+   ProcessorSet& cpus = simulatorConfig.cpus;
+   list< list<PCB>::iterator > completed;
+   list<PCB>::iterator readyProcess;
+   list<PCB>* targetQueue;
 
-   // get the default attributes
-   pthread_attr_init(&attr);
+   // collect interrupts
+   simulatorConfig.interrupts.collect( completed, false );
 
-   // thread each action in action queue
-   if( !( runningQueue.front().actions.empty() ) )
+   // check for no interrupts
+   if( completed.empty() )
    {
-      // get first action in queue
-      simulatorConfig.currentAction = &(runningQueue.front().actions.front());
-
-      // update remaining estimated process run time (for SRTF-P)
-      runningQueue.front().estimatedRuntime -= (simulatorConfig.cycleData[ simulatorConfig.currentAction->actionDescriptor ] * simulatorConfig.quantum );      
-
-      // save void pointer
-      simulatorVoidPtr = &(simulatorConfig);
+      return;
+   }
 
-      // create thread and run action
-      pthread_create( &( tids[ tidIndex ] ), &attr, quantumRunner, simulatorVoidPtr );
-      pthread_join( tids[ tidIndex ], NULL );
+   // return each process to run queue
+   while( !completed.empty() )
+   {
+      readyProcess = completed.front();
+      completed.pop_front();
 
-      // increment to next thread
-      tidIndex++;
+      // change process to ready state
+      if( readyProcess->state == "Enter" )
+      {
+         readyProcess->arrive( simulatorConfig.simClock.currentTime() );
+      }
+      else
+      {
+         readyProcess->unblock( simulatorConfig.simClock.currentTime() );
+      }
 
-      // check for action completion 
-      if( simulatorConfig.currentAction->actionCycle <= 0 )
+      // find run queue
+      if( cpus.sharedQueue )
       {
-         // remove completed action
-         runningQueue.front().actions.pop();            
+         targetQueue = &( cpus.processors[ 0 ].runQueue );
       }
-   } 
-   
-   // return number of remaining actions in process
-   return runningQueue.front().actions.size();
-       
+      else
+      {
+         targetQueue = &( cpus.processors[ readyProcess->lastProcessor ].runQueue );
+      }
+
+      // move process into run queue
+      targetQueue->splice( findReadyPosition( simulatorConfig, *targetQueue, *readyProcess ), cpus.blockedQueue, readyProcess );
+   }
+
+   // wake idle processors that may take them
+   simulatorConfig.interrupts.notify();
 }
 
 /**
-runner
+runProcessQuantum
 
-Simulates execution of action.
-Each thread calls this function upon its creation in threadActions(). 
-Each thread prints appropriate information by calling printAction(),
-waits until it has completed the appropriate cycle time and then ends.
+Runs the first action of a process for one time quantum on the calling
+processor thread, removing the action once it has completed.
 
-@param void pointer to the current action
-@pre a valid action is given
-@post action is completed and logged
-@return void
+@param simulatorPtr pointer to OSCB object with configuration information
+@param process process to run
+@param busyTime processor busy time to add to
+@pre process is running on calling processor
+@post first action ran for one quantum
+@return float with remaining number of actions in process
 */
-void *runner( void* simulatorVoidPtr )
+float runProcessQuantum( OSCB* simulatorPtr, PCB& process, double& busyTime )
 {
    // initialize variables
+   Action* currentAction;
 
-      // set void pointer to Action pointer
-      OSCB* simulatorPtr = static_cast<OSCB*>( simulatorVoidPtr );
-
-      // prepare output string
-      stringstream actionOutput;
-      actionOutput.precision( PRECISION );
-      actionOutput << fixed; 
-
-      // action start time
-      float floatTime;
-      float runTime;
+   // run first action in action queue
+   if( !( process.actions.empty() ) )
+   {
+      // get first action in queue
+      currentAction = &( process.actions.front() );
 
-      // action run duration 
-      runTime = simulatorPtr->currentAction->actionCycle * simulatorPtr->cycleData[ simulatorPtr->currentAction->actionDescriptor ] * CYCLE_TO_MS;
+      // update remaining estimated process run time by cycles run (for SRTF-P)
+      process.estimatedRuntime -= ( getCycleTime( simulatorPtr, currentAction->descriptorID ) *
+                                    findRunCycles( *currentAction, simulatorPtr->quantum ) );
 
-   // application action type
-   if( simulatorPtr->currentAction->actionType == 'A' )
-   {
-      // start application descriptor
-      if( simulatorPtr->currentAction->actionDescriptor == "start")
-      {
-         actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-         actionOutput << " - " << "OS: starting process " << simulatorPtr->currentAction->pcbID << endl;   
-         printAction( simulatorPtr, actionOutput );
-      }      
+      // run action
+      busyTime += runActionQuantum( simulatorPtr, currentAction, simulatorPtr->quantum );
 
-      // end application descriptor
-      else
+      // check for action completion 
+      if( currentAction->actionCycle <= 0 )
       {
-         actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-         actionOutput << " - " << "OS: removing process " << simulatorPtr->currentAction->pcbID << endl; 
-         printAction( simulatorPtr, actionOutput );     
+         // remove completed action
+         process.actions.pop();
       }
-       
    }
 
-   // process action type
-   else if( simulatorPtr->currentAction->actionType == 'P' )
-   {
-      // set current time
-      floatTime = ((float)(clock() - simulatorPtr->timer)/CLOCKS_PER_SEC);
-
-      // run application descriptor start
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": start processing action \n"; 
-      printAction( simulatorPtr, actionOutput );
+   // return number of remaining actions in process
+   return process.actions.size();
+}
 
-      // run for specified time
-      while( ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+/**
+isPreemptive
 
-      // run application desciptor end 
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": end processing action \n";
-      printAction( simulatorPtr, actionOutput );      
-   }
+Returns true if scheduling policy runs processes one time quantum at a time.
 
-   // input action type
-   else if( simulatorPtr->currentAction->actionType == 'I' )
-   {
-      // set current time
-      floatTime = ((float)(clock() - simulatorPtr->timer)/CLOCKS_PER_SEC);
+@param policyID PolicyID to check
+@pre none
+@post none
+@return bool representing preemptive scheduling policy
+*/
+bool isPreemptive( int policyID )
+{
+   return ( policyID == POLICY_FIFO_P || policyID == POLICY_RR || policyID == POLICY_SRTF_P ||
+            policyID == POLICY_MLFQ || policyID == POLICY_CFS );
+}
 
-      // input descriptor start
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": start " << simulatorPtr->currentAction->actionDescriptor << " input \n"; 
-      printAction( simulatorPtr, actionOutput );
+/**
+isOrderedPolicy
 
-      // run for specified time
-      while( ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+Returns true if scheduling policy selects processes by something other
+than their order in the run queue (so it cannot use the lock-free ring).
 
-      // input desciptor end 
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": end " << simulatorPtr->currentAction->actionDescriptor << " input \n";
-      printAction( simulatorPtr, actionOutput );
-   }
+@param policyID PolicyID to check
+@pre none
+@post none
+@return bool representing ordered scheduling policy
+*/
+bool isOrderedPolicy( int policyID )
+{
+   return ( policyID == POLICY_FIFO_P || policyID == POLICY_SJF || policyID == POLICY_SRTF ||
+            policyID == POLICY_SRTF_P );
+}
 
-   // output action type
-   else if( simulatorPtr->currentAction->actionType == 'O' )
-   {
-      // set current time
-      floatTime = ((float)(clock() - simulatorPtr->timer)/CLOCKS_PER_SEC);
+/**
+printAction
 
-      // output descriptor start
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": start " << simulatorPtr->currentAction->actionDescriptor << " output \n"; 
-      printAction( simulatorPtr, actionOutput );
-      
-      // run for specified time
-      while( ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+Prints information for action.
+Queues the passed string stream for the log writer thread, which
+writes it to the appropriate location(s), and clears the string stream.
 
-      // output desciptor end 
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": end " << simulatorPtr->currentAction->actionDescriptor << " output \n";
-      printAction( simulatorPtr, actionOutput );
-   }   
+@param actionOutput stringstream holds information to be logged
+@pre none
+@post actionOutput was logged appropriately 
+@return none
+*/
+void printAction( OSCB* simulatorPtr, stringstream& actionOutput )
+{
+   // initialize variables
+   string actionLine = actionOutput.str();
 
-   // unrecognized action type
-   else 
-   {
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": unrecognized action \n";
-      printAction( simulatorPtr, actionOutput );
-   }   
+   // queue line for log writer thread (every line starts with its time)
+   simulatorPtr->logWriter.post( strtod( actionLine.c_str(), NULL ), actionLine.data(), actionLine.size() );
 
-   // end thread
-   pthread_exit(0);
+   // clear string stream
+   actionOutput.str( string() );
+   actionOutput.clear();
 }
 
 /**
-quantumRunner
+waitForTime
 
-Simulates execution of action for given time quantum.
-Each thread calls this function upon its creation in threadActionsQuantum(). 
-Each thread prints appropriate information by calling printAction(),
-waits until it is blocked or completed, according to appropriate cycle time and then
-returns to threadActionsQuantum to either Exit or return to Ready queue.
+Waits until the simulator clock reaches the given time. The log writer
+is told first that this thread posts nothing earlier, so lines of other
+threads up to that time are written while it waits.
 
-@param void pointer to simulatorConfig with current action
-@pre a valid action is given
-@post action is blocked or completed, and logged
+@param endTime time to wait until (nsec)
+@pre none
+@post clock has reached endTime
+@return none
+*/
+void waitForTime( OSCB* simulatorPtr, int64_t endTime )
+{
+   simulatorPtr->logWriter.advance( SimClock::toSeconds( endTime ) );
+   simulatorPtr->simClock.waitUntil( endTime );
+}
+
+/**
+printStatistics
+
+Prints throughput of the simulation, utilization of the processors
+and each I/O device as a percentage of total simulation time, and the
+turnaround, wait, response and blocked times of the exited processes,
+and (for MLFQ) the time processes spent at each level, and the page fault
+rate if processes accessed memory. Also saves the statistics as JSON if a statistics file was configured.
+
+@param simulatorPtr pointer to OSCB object with device and timing info
+@param completedProcesses number of processes that reached Exit state
+@pre simulation has completed
+@post statistics were logged
 @return void
 */
-void *quantumRunner( void* simulatorVoidPtr )
+void printStatistics( OSCB* simulatorPtr, int completedProcesses )
 {
    // initialize variables
-
-      // set void pointer to Action pointer
-      OSCB* simulatorPtr = static_cast<OSCB*>( simulatorVoidPtr );
+   int deviceID;
+   IODevice* devicePtr;
+   double totalTime = simulatorPtr->simClock.currentTime();
+   unsigned int index;
+   Processor* cpuPtr;
+   int measure;
+   TimeSummary summary;
+   const vector<LevelSummary>& levels = simulatorPtr->runStats.levelSummaries();
+   MemoryUnit* memoryPtr = &( simulatorPtr->memory );
+   DispatchCost* dispatchPtr = &( simulatorPtr->dispatchCost );
+   float totalResidency = 0;
 
       // prepare output string
       stringstream actionOutput;
       actionOutput.precision( PRECISION );
       actionOutput << fixed; 
-      string endStatus;
-
-      // action start time
-      float floatTime;
-      float runTime;
-
-      // for if action will complete within given time quantum
-      if( simulatorPtr-> quantum > simulatorPtr -> currentAction -> actionCycle )
-      {
-         // update estimated run time
-         runTime = simulatorPtr->quantum * simulatorPtr->cycleData[ simulatorPtr->currentAction->actionDescriptor ] * CYCLE_TO_MS;
 
-         // update action status to exit 
-         endStatus = ": end ";
-      }
+   // check for no elapsed time
+   if( totalTime <= 0 )
+   {
+      return;
+   }
 
-      // for if action will not complete in this time quantum
-      else
-      {
-         // update estimed run time
-         runTime = simulatorPtr-> currentAction ->actionCycle * simulatorPtr->cycleData[ simulatorPtr->currentAction->actionDescriptor ] * CYCLE_TO_MS;
+   // print throughput
+   actionOutput << totalTime;
+   actionOutput << " - " << "OS: throughput " << ( completedProcesses / totalTime ) << " processes per second \n";
+   printAction( simulatorPtr, actionOutput );
 
-         // update action status to blocked
-         endStatus = " : block ";
-      }
-      
-      // update number of remaining cycles (for SRTF-P)
-      simulatorPtr->currentAction->actionCycle = simulatorPtr->currentAction->actionCycle - simulatorPtr->quantum;
+   // print processor utilization
+   actionOutput << totalTime;
+   actionOutput << " - " << "OS: processor utilization " << ( 100 * simulatorPtr->cpuBusyTime / ( totalTime * simulatorPtr->processorCount ) ) << "% \n";
+   printAction( simulatorPtr, actionOutput );
 
-   // application action type
-   if( simulatorPtr->currentAction->actionType == 'A' )
+   // print utilization of each processor
+   for( index = 0; index < simulatorPtr->cpus.processors.size(); index++ )
    {
-      // start application descriptor
-      if( simulatorPtr->currentAction->actionDescriptor == "start")
-      {
-         actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-         actionOutput << " - " << "OS: preparing process " << simulatorPtr->currentAction->pcbID << endl;   
-         printAction( simulatorPtr, actionOutput );
-      }      
+      cpuPtr = &( simulatorPtr->cpus.processors[ index ] );
 
-      // end application descriptor
-      else
-      {
-         actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-         actionOutput << " - " << "OS: removing process " << simulatorPtr->currentAction->pcbID << endl; 
-         printAction( simulatorPtr, actionOutput );     
-      }
-       
+      actionOutput << totalTime;
+      actionOutput << " - " << "OS: processor " << cpuPtr->processorID << " utilization " << ( 100 * cpuPtr->busyTime / totalTime ) << "% (";
+      actionOutput << cpuPtr->dispatchCount << " dispatches, " << cpuPtr->stealCount << " stolen) \n";
+      printAction( simulatorPtr, actionOutput );
    }
 
-   // process action type
-   else if( simulatorPtr->currentAction->actionType == 'P' )
+   // print utilization of each device
+   for( deviceID = FIRST_DEVICE; deviceID <= LAST_DEVICE; deviceID++ )
    {
-      // set current time
-      floatTime = ((float)(clock() - simulatorPtr->timer)/CLOCKS_PER_SEC);
+      devicePtr = &( simulatorPtr->devices[ deviceID ] );
 
-      // run application descriptor start
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": start " << "processing action \n"; 
+      actionOutput << totalTime;
+      actionOutput << " - " << "OS: " << devicePtr->deviceName << " utilization " << ( 100 * devicePtr->busyTime / totalTime ) << "% (" << devicePtr->requestCount << " requests) \n";
       printAction( simulatorPtr, actionOutput );
-
-      // run for specified time
-      while( ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
-
-      // run application desciptor end 
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << endStatus << "processing action \n";
-      printAction( simulatorPtr, actionOutput );      
    }
 
-   // input action type
-   else if( simulatorPtr->currentAction->actionType == 'I' )
-   {
-      // set current time
-      floatTime = ((float)(clock() - simulatorPtr->timer)/CLOCKS_PER_SEC);
+   // print context switches
+   actionOutput << totalTime;
+   actionOutput << " - " << "OS: context switches " << simulatorPtr->runStats.dispatchCount() << " \n";
+   printAction( simulatorPtr, actionOutput );
 
-      // input descriptor start
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": start " << simulatorPtr->currentAction->actionDescriptor << " input \n"; 
+   // print time lost to dispatching
+   if( dispatchPtr->totalNanos() > 0 )
+   {
+      actionOutput << totalTime;
+      actionOutput << " - " << "OS: dispatch overhead " << SimClock::toSeconds( dispatchPtr->totalNanos() ) << " seconds (";
+      actionOutput << ( 100 * SimClock::toSeconds( dispatchPtr->totalNanos() ) / ( totalTime * simulatorPtr->processorCount ) ) << "% of processor time), ";
+      actionOutput << dispatchPtr->dispatchCount << " dispatches " << SimClock::toSeconds( dispatchPtr->dispatchNanos ) << " seconds, ";
+      actionOutput << dispatchPtr->switchCount << " process switches " << SimClock::toSeconds( dispatchPtr->switchNanos ) << " seconds, ";
+      actionOutput << dispatchPtr->migrationCount << " migrations " << SimClock::toSeconds( dispatchPtr->migrationNanos ) << " seconds \n";
       printAction( simulatorPtr, actionOutput );
+   }
 
-      // run for specified time
-      while( ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+   // print summary of each process time
+   for( measure = 0; measure < MEASURE_COUNT && simulatorPtr->runStats.processCount() > 0; measure++ )
+   {
+      summary = simulatorPtr->runStats.summarize( measure );
 
-      // input desciptor end 
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << endStatus << simulatorPtr->currentAction->actionDescriptor << " input \n";
+      actionOutput << totalTime;
+      actionOutput << " - " << "OS: " << MEASURE_NAMES[ measure ] << " time mean " << summary.mean;
+      actionOutput << " p50 " << summary.p50 << " p95 " << summary.p95 << " p99 " << summary.p99;
+      actionOutput << " max " << summary.maximum << " \n";
       printAction( simulatorPtr, actionOutput );
    }
 
-   // output action type
-   else if( simulatorPtr->currentAction->actionType == 'O' )
+   // print residency of each MLFQ level
+   for( index = 0; index < levels.size(); index++ )
    {
-      // set current time
-      floatTime = ((float)(clock() - simulatorPtr->timer)/CLOCKS_PER_SEC);
-
-      // output descriptor start
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": start " << simulatorPtr->currentAction->actionDescriptor << " output \n"; 
-      printAction( simulatorPtr, actionOutput );
-      
-      // run for specified time
-      while( ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC) < (floatTime + runTime) ); // busy wait
+      totalResidency += levels[ index ].residency;
+   }
 
-      // output desciptor end 
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << endStatus << simulatorPtr->currentAction->actionDescriptor << " output \n";
+   for( index = 0; index < levels.size(); index++ )
+   {
+      actionOutput << totalTime;
+      actionOutput << " - " << "OS: MLFQ level " << index << " (quantum " << levels[ index ].quantum << ") residency " << levels[ index ].residency;
+      actionOutput << " (" << ( totalResidency > 0 ? 100 * levels[ index ].residency / totalResidency : 0 ) << "%), ";
+      actionOutput << levels[ index ].dispatches << " dispatches, " << levels[ index ].demotions << " demotions, " << levels[ index ].exits << " exits \n";
       printAction( simulatorPtr, actionOutput );
-   }   
+   }
 
-   // unrecognized action type
-   else 
+   // print page fault rate
+   if( memoryPtr->accessCount > 0 )
    {
-      actionOutput << ((float)(clock()-simulatorPtr->timer)/CLOCKS_PER_SEC);
-      actionOutput << " - " << "Process " << simulatorPtr->currentAction->pcbID << ": unrecognized action \n";
+      actionOutput << totalTime;
+      actionOutput << " - " << "OS: memory " << memoryPtr->frameCount << " frames of " << memoryPtr->pageSize << " kB (" << REPLACEMENT_NAMES[ memoryPtr->replacement ] << "), ";
+      actionOutput << memoryPtr->accessCount << " accesses, " << memoryPtr->faultCount << " page faults (";
+      actionOutput << ( 100.0 * memoryPtr->faultCount / memoryPtr->accessCount ) << "%), " << memoryPtr->evictionCount << " evictions \n";
       printAction( simulatorPtr, actionOutput );
-   }   
+   }
 
-   // end thread
-   pthread_exit(0);
+   // save JSON statistics
+   if( !simulatorPtr->statsPath.empty() && !saveStatistics( simulatorPtr, completedProcesses ) )
+   {
+      cout << "Error: statistics file " << simulatorPtr->statsPath << " could not be written" << endl;
+   }
 }
 
 /**
-printAction
+saveStatistics
 
-Prints information for action.
-Logs the passed string stream to appropriate location(s) and 
-clears the string stream. 
+Saves the statistics of the run to the configured statistics file as a
+JSON object, so runs can be compared by scripts.
 
-@param actionOutput stringstream holds information to be logged
-@pre none
-@post actionOutput was logged appropriately 
-@return none
+@param simulatorPtr pointer to OSCB object with device and timing info
+@param completedProcesses number of processes that reached Exit state
+@pre simulation has completed, statsPath is not empty
+@post statistics file was written
+@return bool representing file was written
 */
-void printAction( OSCB* simulatorPtr, stringstream& actionOutput )
+bool saveStatistics( OSCB* simulatorPtr, int completedProcesses )
 {
-   // print to console
-   if( simulatorPtr->logLocation == 'M' || simulatorPtr->logLocation == 'B' )
+   // initialize variables
+   ofstream fout;
+   double totalTime = simulatorPtr->simClock.currentTime();
+   int measure;
+   int deviceID;
+   unsigned int index;
+   TimeSummary summary;
+   Processor* cpuPtr;
+   IODevice* devicePtr;
+   const vector<LevelSummary>& levels = simulatorPtr->runStats.levelSummaries();
+   MemoryUnit* memoryPtr = &( simulatorPtr->memory );
+   DispatchCost* dispatchPtr = &( simulatorPtr->dispatchCost );
+
+   fout.open( simulatorPtr->statsPath.c_str() );
+
+   // check for open failure
+   if( !fout.good() )
    {
-      cout << actionOutput.str();
+      return false;
    }
 
-   // print to file
-   if( simulatorPtr->logLocation == 'F' || simulatorPtr->logLocation == 'B' )
+   fout.precision( PRECISION );
+   fout << fixed;
+
+   // write run totals
+   fout << "{\n";
+   fout << "  \"scheduling\": \"" << simulatorPtr->schedulingCode << "\",\n";
+   fout << "  \"processors\": " << simulatorPtr->processorCount << ",\n";
+   fout << "  \"processes\": " << completedProcesses << ",\n";
+   fout << "  \"total_time\": " << totalTime << ",\n";
+   fout << "  \"throughput\": " << ( totalTime > 0 ? completedProcesses / totalTime : 0 ) << ",\n";
+   fout << "  \"cpu_utilization\": " << ( totalTime > 0 ? 100 * simulatorPtr->cpuBusyTime / ( totalTime * simulatorPtr->processorCount ) : 0 ) << ",\n";
+   fout << "  \"context_switches\": " << simulatorPtr->runStats.dispatchCount() << ",\n";
+
+   // write time lost to dispatching
+   fout << "  \"dispatch_overhead\": { \"total\": " << SimClock::toSeconds( dispatchPtr->totalNanos() );
+   fout << ", \"dispatches\": " << dispatchPtr->dispatchCount << ", \"dispatch_time\": " << SimClock::toSeconds( dispatchPtr->dispatchNanos );
+   fout << ", \"switches\": " << dispatchPtr->switchCount << ", \"switch_time\": " << SimClock::toSeconds( dispatchPtr->switchNanos );
+   fout << ", \"migrations\": " << dispatchPtr->migrationCount << ", \"migration_time\": " << SimClock::toSeconds( dispatchPtr->migrationNanos ) << " },\n";
+
+   // write summary of each process time
+   for( measure = 0; measure < MEASURE_COUNT; measure++ )
    {
-      simulatorPtr->outputFile << actionOutput.str();
+      summary = simulatorPtr->runStats.summarize( measure );
+
+      fout << "  \"" << MEASURE_NAMES[ measure ] << "\": { ";
+      fout << "\"mean\": " << summary.mean << ", \"min\": " << summary.minimum << ", ";
+      fout << "\"p50\": " << summary.p50 << ", \"p95\": " << summary.p95 << ", ";
+      fout << "\"p99\": " << summary.p99 << ", \"max\": " << summary.maximum << " },\n";
    }
 
-   // clear string stream
-   actionOutput.str( string() );
-   actionOutput.clear();
-}
+   // write each processor
+   fout << "  \"processor_stats\": [";
+
+   for( index = 0; index < simulatorPtr->cpus.processors.size(); index++ )
+   {
+      cpuPtr = &( simulatorPtr->cpus.processors[ index ] );
+
+      fout << ( index > 0 ? ", " : " " ) << "{ \"id\": " << cpuPtr->processorID;
+      fout << ", \"utilization\": " << ( totalTime > 0 ? 100 * cpuPtr->busyTime / totalTime : 0 );
+      fout << ", \"dispatches\": " << cpuPtr->dispatchCount << ", \"stolen\": " << cpuPtr->stealCount << " }";
+   }
+
+   fout << " ],\n";
+
+   // write each device
+   fout << "  \"device_stats\": [";
+
+   for( deviceID = FIRST_DEVICE; deviceID <= LAST_DEVICE; deviceID++ )
+   {
+      devicePtr = &( simulatorPtr->devices[ deviceID ] );
+
+      fout << ( deviceID > FIRST_DEVICE ? ", " : " " ) << "{ \"name\": \"" << devicePtr->deviceName << "\"";
+      fout << ", \"utilization\": " << ( totalTime > 0 ? 100 * devicePtr->busyTime / totalTime : 0 );
+      fout << ", \"requests\": " << devicePtr->requestCount << " }";
+   }
+
+   fout << " ],\n";
 
+   // write page fault rate
+   fout << "  \"memory_stats\": { \"frames\": " << memoryPtr->frameCount << ", \"page_size_kb\": " << memoryPtr->pageSize;
+   fout << ", \"replacement\": \"" << REPLACEMENT_NAMES[ memoryPtr->replacement ] << "\"";
+   fout << ", \"accesses\": " << memoryPtr->accessCount << ", \"page_faults\": " << memoryPtr->faultCount;
+   fout << ", \"fault_rate\": " << ( memoryPtr->accessCount > 0 ? 100.0 * memoryPtr->faultCount / memoryPtr->accessCount : 0 );
+   fout << ", \"evictions\": " << memoryPtr->evictionCount << " },\n";
+
+   // write each MLFQ level
+   fout << "  \"level_stats\": [";
+
+   for( index = 0; index < levels.size(); index++ )
+   {
+      fout << ( index > 0 ? ", " : " " ) << "{ \"level\": " << index << ", \"quantum\": " << levels[ index ].quantum;
+      fout << ", \"residency\": " << levels[ index ].residency << ", \"dispatches\": " << levels[ index ].dispatches;
+      fout << ", \"demotions\": " << levels[ index ].demotions << ", \"exits\": " << levels[ index ].exits << " }";
+   }
+
+   fout << " ]\n";
+   fout << "}\n";
+
+   fout.close();
+
+   return !fout.fail();
+}
@@ -26,19 +26,185 @@
 
 // global variables
 
+   // descriptor names, indexed by DescriptorID
+   const char* const DESCRIPTOR_NAMES[ DESC_COUNT ] =
+   {
+      "start", "end", "run", "hard drive", "keyboard", "monitor", "printer",
+      "allocate", "access"
+   };
+
+// function implementation
+
+/**
+findDescriptor
+
+Returns the ID of the given action descriptor, so descriptors are
+compared once when meta-data is read instead of on every action.
+
+@param descriptor descriptor name from meta-data (not null terminated)
+@param length number of characters in descriptor
+@pre none
+@post none
+@return int with descriptor ID, or NO_DESCRIPTOR if unrecognized
+*/
+int findDescriptor( const char* descriptor, int length )
+{
+   // initialize variables
+   int index;
+
+   for( index = 0; index < DESC_COUNT; index++ )
+   {
+      if( strncmp( descriptor, DESCRIPTOR_NAMES[ index ], length ) == 0 &&
+          DESCRIPTOR_NAMES[ index ][ length ] == '\0' )
+      {
+         return index;
+      }
+   }
+
+   return NO_DESCRIPTOR;
+}
+
 // class implementation
 PCB::PCB( int id )
 {
    processID = id;
    state = "Enter";
    estimatedRuntime = 0;
+   lastProcessor = 0;
+   readySequence = 0;
+   arrivalTime = 0;
+   firstRunTime = -1;
+   exitTime = 0;
+   readySince = 0;
+   blockedSince = 0;
+   waitTime = 0;
+   blockedTime = 0;
+   dispatchCount = 0;
+   priorityLevel = 0;
+   levelSince = 0;
+   virtualRuntime = 0;
+   allocatedMemory = 0;
+}
+
+/**
+dispatch
+
+Moves the process from Ready to Running state, adding the time since
+it became Ready to its wait time.
+
+@param currentTime simulator time
+@pre process is Ready
+@post process is Running
+@return void
+*/
+void PCB::dispatch( double currentTime )
+{
+   state = "Running";
+
+   // record first run (for response time)
+   if( firstRunTime < 0 )
+   {
+      firstRunTime = currentTime;
+   }
+
+   waitTime += currentTime - readySince;
+   dispatchCount++;
+}
+
+/**
+preempt
+
+Moves the process from Running back to Ready state at the end of its
+time quantum.
+
+@param currentTime simulator time
+@pre process is Running
+@post process is Ready
+@return void
+*/
+void PCB::preempt( double currentTime )
+{
+   state = "Ready";
+   readySince = currentTime;
+}
+
+/**
+block
+
+Moves the process from Running to Blocked state while it waits on I/O.
+
+@param currentTime simulator time
+@pre process is Running
+@post process is Blocked
+@return void
+*/
+void PCB::block( double currentTime )
+{
+   state = "Blocked";
+   blockedSince = currentTime;
 }
 
-Action::Action() {}
+/**
+unblock
+
+Moves the process from Blocked to Ready state once its I/O has completed,
+adding the time since it was Blocked to its blocked time.
+
+@param currentTime simulator time
+@pre process is Blocked
+@post process is Ready
+@return void
+*/
+void PCB::unblock( double currentTime )
+{
+   state = "Ready";
+   blockedTime += currentTime - blockedSince;
+   readySince = currentTime;
+}
+
+/**
+arrive
+
+Moves the process from Enter to Ready state once simulated time reaches
+its arrival time.
+
+@param currentTime simulator time
+@pre process is in Enter state
+@post process is Ready
+@return void
+*/
+void PCB::arrive( double currentTime )
+{
+   state = "Ready";
+   readySince = currentTime;
+}
+
+/**
+exit
+
+Moves the process from Running to Exit state.
+
+@param currentTime simulator time
+@pre process is Running
+@post process is in Exit state
+@return void
+*/
+void PCB::exit( double currentTime )
+{
+   state = "Exit";
+   exitTime = currentTime;
+}
+
+/**
+descriptorName
+
+Returns the name of the action's descriptor, for log output.
 
-Action::Action( char type, string descriptor, float cycle )
+@pre descriptorID was set
+@post none
+@return const char* with descriptor name
+*/
+const char* Action::descriptorName() const
 {
-   actionType = type;
-   actionDescriptor = descriptor;
-   actionCycle = cycle;
+   return DESCRIPTOR_NAMES[ descriptorID ];
 }
@@ -26,19 +26,40 @@
 
 // global constants
 
+   // action descriptor IDs (I/O devices in alphabetical order, then memory)
+   enum DescriptorID
+   {
+      DESC_START,
+      DESC_END,
+      DESC_RUN,
+      DESC_HARD_DRIVE,
+      DESC_KEYBOARD,
+      DESC_MONITOR,
+      DESC_PRINTER,
+      DESC_ALLOCATE,
+      DESC_ACCESS,
+      DESC_COUNT
+   };
+
+   const int FIRST_DEVICE = DESC_HARD_DRIVE;
+   const int LAST_DEVICE = DESC_PRINTER;
+   const int NO_DESCRIPTOR = -1;
+
 // global variables
+   extern const char* const DESCRIPTOR_NAMES[ DESC_COUNT ];
+
+// function prototypes
+   int findDescriptor( const char* descriptor, int length );
 
 // class specification
 class Action
 {
    public:
-      Action();
-      Action( char type, string descriptor, float cycle );
-      char actionType;
-      string actionDescriptor;
-      float actionCycle;
-      int pcbID;
-   private:      
+      const char* descriptorName() const;
+      float actionCycle; // remaining cycles (memory size or address for M)
+      int pcbID; // process action belongs to
+      char actionType; // A, P, I, O or M
+      unsigned char descriptorID; // interned descriptor (DescriptorID)
 };
 
 class PCB
@@ -46,9 +67,29 @@ class PCB
    friend class Action;
    public:
       PCB( int id = 0 );
+      void dispatch( double currentTime );
+      void preempt( double currentTime );
+      void block( double currentTime );
+      void unblock( double currentTime );
+      void arrive( double currentTime );
+      void exit( double currentTime );
       int processID;
       float estimatedRuntime;
       string state;
+      int lastProcessor; // processor the process last ran on (from 0)
+      long readySequence; // order process was queued in ready queue heap
+      double arrivalTime; // time process entered Ready state first (from meta-data)
+      double firstRunTime; // time process was first dispatched (-1 if not yet)
+      double exitTime; // time process reached Exit state
+      double readySince; // time process last entered Ready state
+      double blockedSince; // time process last entered Blocked state
+      double waitTime; // total time spent in Ready state
+      double blockedTime; // total time spent Blocked on I/O
+      int dispatchCount; // number of times process was dispatched
+      int priorityLevel; // MLFQ level (0 is highest)
+      double levelSince; // time process entered its MLFQ level
+      double virtualRuntime; // CFS processor time received
+      int allocatedMemory; // memory allocated by M(allocate) actions (kB)
       queue<Action> actions;
    private:
 };
@@ -0,0 +1,74 @@
+/**
+ * @file   Processor.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Simulated processor for Operating System simulator
+ *
+ * Each simulated processor has its own thread and run queue. Processors
+ * either all share the first run queue, or each use their own, with idle
+ * processors optionally stealing work from the others. In lock-free mode
+ * processors share a lock-free ring of process handles instead.
+ */
+
+// header files
+   #include "Processor.h"
+   #include "Process_Control_Block.h"
+   #include <list> // used to store processes
+   #include <vector> // used to store processors
+   #include <atomic> // used for lock-free completed count
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+   // run queue modes in configuration file, indexed by QueueModeID
+   const char* const QUEUE_MODE_NAMES[ QUEUE_MODE_COUNT ] =
+   {
+      "Shared", "Per processor", "Work stealing", "Lock-free"
+   };
+
+// class implementation
+Processor::Processor()
+{
+   processorID = 0;
+   simulatorPtr = NULL;
+   busyTime = 0;
+   dispatchCount = 0;
+   stealCount = 0;
+   logProducer = 0;
+}
+
+ProcessorSet::ProcessorSet()
+{
+   queueMode = QUEUE_SHARED;
+   sharedQueue = true;
+   workStealing = false;
+   lockFree = false;
+   processCount = 0;
+   completedCount = 0;
+   pthread_mutex_init( &lock, NULL );
+}
+
+ProcessorSet::~ProcessorSet()
+{
+   pthread_mutex_destroy( &lock );
+}
+
+/**
+setQueueMode
+
+Sets how processors share run queues from the run queue mode.
+
+@pre queueMode is a QueueModeID
+@post sharedQueue, workStealing and lockFree match queueMode
+@return void
+*/
+void ProcessorSet::setQueueMode()
+{
+   sharedQueue = ( queueMode == QUEUE_SHARED || queueMode == QUEUE_LOCK_FREE );
+   workStealing = ( queueMode == QUEUE_WORK_STEALING );
+   lockFree = ( queueMode == QUEUE_LOCK_FREE );
+}
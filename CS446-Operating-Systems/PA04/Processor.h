@@ -0,0 +1,73 @@
+/**
+ * @file   Processor.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Simulated processor header for Operating System simulator
+ */
+
+// definition
+   #ifndef __PROCESSOR_H_
+   #define __PROCESSOR_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include "Ready_Ring.h"
+   #include <list> // used to store processes
+   #include <vector> // used to store processors
+   #include <atomic> // used for lock-free completed count
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+   // run queue modes, indexed by QueueModeID
+   enum QueueModeID
+   {
+      QUEUE_SHARED,
+      QUEUE_PER_PROCESSOR,
+      QUEUE_WORK_STEALING,
+      QUEUE_LOCK_FREE,
+      QUEUE_MODE_COUNT
+   };
+
+// global variables
+   extern const char* const QUEUE_MODE_NAMES[ QUEUE_MODE_COUNT ];
+
+// class declaration
+class OSCB;
+
+class Processor
+{
+   public:
+      Processor();
+      int processorID; // processor number (starting at 1)
+      OSCB* simulatorPtr; // simulator that owns processor
+      list<PCB> runQueue; // Ready processes waiting for this processor
+      list<PCB> running; // process currently running on this processor
+      double busyTime; // total time spent running actions (seconds)
+      int dispatchCount; // number of processes dispatched
+      int stealCount; // number of processes taken from other processors
+      int logProducer; // log producer of processor thread
+      pthread_t tid; // processor thread
+};
+
+class ProcessorSet
+{
+   public:
+      ProcessorSet();
+      ~ProcessorSet();
+      void setQueueMode();
+      vector<Processor> processors; // simulated processors
+      list<PCB> blockedQueue; // processes waiting on I/O
+      int queueMode; // run queue mode (QueueModeID)
+      bool sharedQueue; // true if every processor uses the first run queue
+      bool workStealing; // true if idle processors take from other run queues
+      bool lockFree; // true if processors share readyRing instead of the first run queue
+      ReadyRing readyRing; // handles of Ready processes (lock-free mode)
+      int processCount; // processes to run
+      atomic<int> completedCount; // processes that reached Exit state
+      pthread_mutex_t lock; // guards run queues, blocked queue and counters (except lock-free mode)
+};
+
+#endif
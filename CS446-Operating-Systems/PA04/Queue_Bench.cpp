@@ -0,0 +1,508 @@
+/**
+ * @file   Queue_Bench.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Ready queue stress test and benchmark for Operating System simulator
+ *
+ * Checks the lock-free ReadyRing and compares it with a run queue guarded
+ * by a mutex. Each thread pops a process handle and pushes it back, over
+ * and over, so every thread contends on both ends of the queue at once.
+ * The stress test counts the threads holding each handle, so a handle
+ * popped twice (or lost) is found, and drains the ring at the end to check
+ * that every handle is still queued exactly once.
+ *
+ * The dispatch benchmark runs the hold model: each dispatch takes the
+ * process with the lowest estimated run time, gives it a new run time and
+ * queues it again, so the number of Ready processes stays the same.
+ */
+
+// header files
+   #include "Queue_Bench.h"
+   #include "Process_Control_Block.h"
+   #include "Ready_Ring.h"
+   #include "Ready_Queue.h"
+   #include <list> // used for process handles
+   #include <vector> // used for drain counts
+   #include <algorithm> // used to scan for shortest process
+   #include <atomic> // used for ownership checks
+   #include <ctime> // used to time runs
+   #include <sched.h> // used to yield while queue is empty
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+   const unsigned int RUNTIME_SEED = 12345;
+   const unsigned int RUNTIME_RANGE = 1000000; // run times drawn from 0 to this (cycles)
+
+// global variables
+
+// class implementation
+QueueBench::QueueBench()
+{
+   holders = NULL;
+   duplicateCount = 0;
+   lostCount = 0;
+   passes = 0;
+   pthread_mutex_init( &lock, NULL );
+}
+
+QueueBench::~QueueBench()
+{
+   delete[] holders;
+   pthread_mutex_destroy( &lock );
+}
+
+/**
+stressRing
+
+Runs threads that pop and push ring handles at once, then checks that no
+handle was held by two threads, no push failed, and every handle is in
+the ring exactly once.
+
+@param threadCount number of threads
+@param handleCount number of handles queued
+@param passCount pop and push pairs run by each thread
+@pre threadCount and handleCount are positive
+@post ring was drained
+@return bool representing ring kept every handle exactly once
+*/
+bool QueueBench::stressRing( int threadCount, int handleCount, long passCount )
+{
+   // initialize variables
+   vector<int> seenCount( handleCount, 0 );
+   list<PCB>::iterator handle;
+   int drained = 0;
+   int index;
+
+   fill( handleCount );
+   passes = passCount;
+
+   delete[] holders;
+   holders = new atomic<int>[ handleCount ];
+
+   for( index = 0; index < handleCount; index++ )
+   {
+      holders[ index ].store( 0 );
+   }
+
+   duplicateCount = 0;
+   lostCount = 0;
+
+   runThreads( threadCount, stressWorker );
+
+   // drain ring and count each handle
+   while( ring.pop( handle ) )
+   {
+      seenCount[ handle->processID - 1 ]++;
+      drained++;
+   }
+
+   if( duplicateCount > 0 || lostCount > 0 || drained != handleCount )
+   {
+      return false;
+   }
+
+   for( index = 0; index < handleCount; index++ )
+   {
+      if( seenCount[ index ] != 1 )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/**
+timeRing
+
+Times threads that pop and push handles of the lock-free ring.
+
+@param threadCount number of threads
+@param handleCount number of handles queued
+@param passCount pop and push pairs run by each thread
+@pre threadCount and handleCount are positive
+@post none
+@return double with queue operations (pops and pushes) per second
+*/
+double QueueBench::timeRing( int threadCount, int handleCount, long passCount )
+{
+   // initialize variables
+   double seconds;
+
+   fill( handleCount );
+   passes = passCount;
+
+   seconds = runThreads( threadCount, ringWorker );
+
+   return seconds > 0 ? 2.0 * threadCount * passCount / seconds : 0;
+}
+
+/**
+timeLockedList
+
+Times threads that pop and push handles of a list guarded by a mutex.
+
+@param threadCount number of threads
+@param handleCount number of handles queued
+@param passCount pop and push pairs run by each thread
+@pre threadCount and handleCount are positive
+@post none
+@return double with queue operations (pops and pushes) per second
+*/
+double QueueBench::timeLockedList( int threadCount, int handleCount, long passCount )
+{
+   // initialize variables
+   double seconds;
+
+   fill( handleCount );
+   passes = passCount;
+
+   seconds = runThreads( threadCount, listWorker );
+
+   return seconds > 0 ? 2.0 * threadCount * passCount / seconds : 0;
+}
+
+/**
+timeHeapDispatch
+
+Times SRTF dispatches from a ReadyQueue heap of processes.
+
+@param processCount number of Ready processes
+@param passCount dispatches to run
+@pre processCount and passCount are positive
+@post none
+@return double with time of each dispatch (nsec)
+*/
+double QueueBench::timeHeapDispatch( int processCount, long passCount )
+{
+   // initialize variables
+   list<PCB> readyList;
+   list<PCB>::iterator process;
+   ReadyQueue readyHeap;
+   struct timespec startTime;
+   unsigned int seed = RUNTIME_SEED;
+   long pass;
+
+   fillReady( readyList, processCount );
+
+   for( process = readyList.begin(); process != readyList.end(); process++ )
+   {
+      readyHeap.push( process );
+   }
+
+   clock_gettime( CLOCK_MONOTONIC, &startTime );
+
+   for( pass = 0; pass < passCount; pass++ )
+   {
+      process = readyHeap.top();
+      readyHeap.pop();
+
+      process->estimatedRuntime = nextRuntime( seed );
+      readyHeap.push( process );
+   }
+
+   return elapsedNanos( startTime ) / passCount;
+}
+
+/**
+timeScanDispatch
+
+Times SRTF dispatches found by scanning the whole Ready list (as
+selectProcess does with min_element).
+
+@param processCount number of Ready processes
+@param passCount dispatches to run
+@pre processCount and passCount are positive
+@post none
+@return double with time of each dispatch (nsec)
+*/
+double QueueBench::timeScanDispatch( int processCount, long passCount )
+{
+   // initialize variables
+   list<PCB> readyList;
+   list<PCB>::iterator process;
+   struct timespec startTime;
+   unsigned int seed = RUNTIME_SEED;
+   long pass;
+
+   fillReady( readyList, processCount );
+
+   clock_gettime( CLOCK_MONOTONIC, &startTime );
+
+   for( pass = 0; pass < passCount; pass++ )
+   {
+      process = min_element( readyList.begin(), readyList.end(), compareRuntimes );
+
+      process->estimatedRuntime = nextRuntime( seed );
+   }
+
+   return elapsedNanos( startTime ) / passCount;
+}
+
+/**
+fill
+
+Creates processes and queues a handle to each in both queues.
+
+@param handleCount number of handles queued
+@pre no thread is using the queues
+@post each queue holds handleCount handles, in process number order
+@return void
+*/
+void QueueBench::fill( int handleCount )
+{
+   // initialize variables
+   list<PCB>::iterator handle;
+   int index;
+
+   processes.clear();
+   lockedList.clear();
+
+   for( index = 1; index <= handleCount; index++ )
+   {
+      processes.push_back( PCB( index ) );
+   }
+
+   ring.reserve( handleCount );
+
+   for( handle = processes.begin(); handle != processes.end(); handle++ )
+   {
+      ring.push( handle );
+      lockedList.push_back( handle );
+   }
+}
+
+/**
+fillReady
+
+Creates Ready processes with run times spread over the run time range.
+
+@param readyList list to add processes to
+@param processCount number of processes
+@pre readyList is empty
+@post readyList holds processCount processes
+@return void
+*/
+void QueueBench::fillReady( list<PCB>& readyList, int processCount )
+{
+   // initialize variables
+   unsigned int seed = RUNTIME_SEED + 1;
+   int index;
+
+   for( index = 1; index <= processCount; index++ )
+   {
+      readyList.push_back( PCB( index ) );
+      readyList.back().estimatedRuntime = nextRuntime( seed );
+   }
+}
+
+/**
+nextRuntime
+
+Returns the next pseudo-random run time of a seeded sequence, so every
+run of the benchmark queues the same run times.
+
+@param seed state of sequence
+@pre none
+@post seed was advanced
+@return float with run time (cycles)
+*/
+float QueueBench::nextRuntime( unsigned int& seed )
+{
+   seed = seed * 1103515245 + 12345;
+
+   return ( seed >> 8 ) % RUNTIME_RANGE;
+}
+
+/**
+compareRuntimes
+
+Returns true if the first process has a lower estimated run time.
+
+@param first first process
+@param second second process
+@pre none
+@post none
+@return bool representing first process is shorter
+*/
+bool QueueBench::compareRuntimes( const PCB& first, const PCB& second )
+{
+   return first.estimatedRuntime < second.estimatedRuntime;
+}
+
+/**
+elapsedNanos
+
+Returns the time since a start time.
+
+@param startTime time read with CLOCK_MONOTONIC
+@pre none
+@post none
+@return double with elapsed time (nsec)
+*/
+double QueueBench::elapsedNanos( const struct timespec& startTime )
+{
+   // initialize variables
+   struct timespec endTime;
+
+   clock_gettime( CLOCK_MONOTONIC, &endTime );
+
+   return ( endTime.tv_sec - startTime.tv_sec ) * 1e9 + ( endTime.tv_nsec - startTime.tv_nsec );
+}
+
+/**
+runThreads
+
+Starts threads running a worker function and waits for them.
+
+@param threadCount number of threads
+@param function worker function, passed this bench
+@pre queues were filled
+@post every thread has ended
+@return double with elapsed time (seconds)
+*/
+double QueueBench::runThreads( int threadCount, void *(*function)( void* ) )
+{
+   // initialize variables
+   vector<pthread_t> threads( threadCount );
+   struct timespec startTime;
+   struct timespec endTime;
+   int index;
+
+   clock_gettime( CLOCK_MONOTONIC, &startTime );
+
+   for( index = 0; index < threadCount; index++ )
+   {
+      pthread_create( &( threads[ index ] ), NULL, function, this );
+   }
+
+   for( index = 0; index < threadCount; index++ )
+   {
+      pthread_join( threads[ index ], NULL );
+   }
+
+   clock_gettime( CLOCK_MONOTONIC, &endTime );
+
+   return ( endTime.tv_sec - startTime.tv_sec ) + ( endTime.tv_nsec - startTime.tv_nsec ) / 1e9;
+}
+
+/**
+ringWorker
+
+Runs on each benchmark thread. Pops a ring handle and pushes it back,
+yielding while the ring is empty.
+
+@param benchVoidPtr void pointer to the QueueBench
+@pre ring was filled
+@post thread ran its passes
+@return void
+*/
+void *QueueBench::ringWorker( void* benchVoidPtr )
+{
+   // initialize variables
+   QueueBench* benchPtr = static_cast<QueueBench*>( benchVoidPtr );
+   list<PCB>::iterator handle;
+   long pass;
+
+   for( pass = 0; pass < benchPtr->passes; pass++ )
+   {
+      while( !benchPtr->ring.pop( handle ) )
+      {
+         sched_yield();
+      }
+
+      benchPtr->ring.push( handle );
+   }
+
+   return NULL;
+}
+
+/**
+stressWorker
+
+Runs on each stress test thread. Pops a ring handle, marks it held while
+checking that no other thread holds it, and pushes it back.
+
+@param benchVoidPtr void pointer to the QueueBench
+@pre ring was filled and holders cleared
+@post thread ran its passes, errors were counted
+@return void
+*/
+void *QueueBench::stressWorker( void* benchVoidPtr )
+{
+   // initialize variables
+   QueueBench* benchPtr = static_cast<QueueBench*>( benchVoidPtr );
+   list<PCB>::iterator handle;
+   atomic<int>* holder;
+   long pass;
+
+   for( pass = 0; pass < benchPtr->passes; pass++ )
+   {
+      while( !benchPtr->ring.pop( handle ) )
+      {
+         sched_yield();
+      }
+
+      // check handle is not held by another thread
+      holder = &( benchPtr->holders[ handle->processID - 1 ] );
+
+      if( holder->fetch_add( 1 ) != 0 )
+      {
+         benchPtr->duplicateCount++;
+      }
+
+      holder->fetch_sub( 1 );
+
+      if( !benchPtr->ring.push( handle ) )
+      {
+         benchPtr->lostCount++;
+      }
+   }
+
+   return NULL;
+}
+
+/**
+listWorker
+
+Runs on each benchmark thread. Pops a handle from the front of the
+locked list and pushes it onto the back, yielding while the list is
+empty.
+
+@param benchVoidPtr void pointer to the QueueBench
+@pre list was filled
+@post thread ran its passes
+@return void
+*/
+void *QueueBench::listWorker( void* benchVoidPtr )
+{
+   // initialize variables
+   QueueBench* benchPtr = static_cast<QueueBench*>( benchVoidPtr );
+   list<PCB>::iterator handle;
+   long pass;
+
+   for( pass = 0; pass < benchPtr->passes; pass++ )
+   {
+      pthread_mutex_lock( &benchPtr->lock );
+
+      while( benchPtr->lockedList.empty() )
+      {
+         pthread_mutex_unlock( &benchPtr->lock );
+         sched_yield();
+         pthread_mutex_lock( &benchPtr->lock );
+      }
+
+      handle = benchPtr->lockedList.front();
+      benchPtr->lockedList.pop_front();
+
+      pthread_mutex_unlock( &benchPtr->lock );
+
+      pthread_mutex_lock( &benchPtr->lock );
+      benchPtr->lockedList.push_back( handle );
+      pthread_mutex_unlock( &benchPtr->lock );
+   }
+
+   return NULL;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file   Queue_Bench.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Ready queue stress test and benchmark header for Operating System simulator
+ */
+
+// definition
+   #ifndef __QUEUEBENCH_H_
+   #define __QUEUEBENCH_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include "Ready_Ring.h"
+   #include "Ready_Queue.h"
+   #include <list> // used for process handles
+   #include <atomic> // used for ownership checks
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class declaration
+
+// runs threads that repeatedly take a process handle from a shared ready
+// queue and put it back, either through the lock-free ReadyRing or through
+// a list guarded by a mutex (as the processors share a run queue). Also
+// times SRTF dispatches from the ReadyQueue heap and from a scan of the
+// Ready list as the number of Ready processes grows.
+class QueueBench
+{
+   public:
+      QueueBench();
+      ~QueueBench();
+      bool stressRing( int threadCount, int handleCount, long passCount );
+      double timeRing( int threadCount, int handleCount, long passCount );
+      double timeLockedList( int threadCount, int handleCount, long passCount );
+      double timeHeapDispatch( int processCount, long passCount );
+      double timeScanDispatch( int processCount, long passCount );
+   private:
+      void fill( int handleCount );
+      void fillReady( list<PCB>& readyList, int processCount );
+      static float nextRuntime( unsigned int& seed );
+      static bool compareRuntimes( const PCB& first, const PCB& second );
+      static double elapsedNanos( const struct timespec& startTime );
+      double runThreads( int threadCount, void *(*function)( void* ) );
+      static void *ringWorker( void* benchVoidPtr );
+      static void *stressWorker( void* benchVoidPtr );
+      static void *listWorker( void* benchVoidPtr );
+      list<PCB> processes; // processes whose handles are queued
+      ReadyRing ring; // lock-free queue of handles
+      list< list<PCB>::iterator > lockedList; // mutex-guarded queue of handles
+      atomic<int>* holders; // threads holding each handle (stress test)
+      atomic<long> duplicateCount; // pops of a handle another thread already held
+      atomic<long> lostCount; // pushes that failed (ring full)
+      long passes; // pop and push pairs run by each thread
+      pthread_mutex_t lock; // guards lockedList
+};
+
+#endif
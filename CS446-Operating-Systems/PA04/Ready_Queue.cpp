@@ -0,0 +1,212 @@
+/**
+ * @file   Ready_Queue.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Shortest remaining time ready queue for Operating System simulator
+ *
+ * Binary min-heap of processes keyed on estimated remaining run time,
+ * used by SRTF and SRTF-P. A process's run time only changes while it is
+ * running (out of the heap), so a preempted process is pushed again with
+ * its new run time rather than moved within the heap. Processes with equal
+ * run times come out most recently queued first, the same order
+ * min_element( compareRuntimes ) gave over the Ready list.
+ */
+
+// header files
+   #include "Ready_Queue.h"
+   #include "Process_Control_Block.h"
+   #include <list> // used to store processes
+   #include <vector> // used as heap container
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class implementation
+ReadyQueue::ReadyQueue()
+{
+   sequence = 0;
+}
+
+/**
+push
+
+Adds a process to the queue.
+
+@param process process to add
+@pre process is not already in queue
+@post process is in queue
+@return void
+*/
+void ReadyQueue::push( list<PCB>::iterator process )
+{
+   // mark order process was queued in
+   process->readySequence = sequence++;
+
+   // add to bottom of heap and move up
+   heap.push_back( process );
+   siftUp( heap.size() - 1 );
+}
+
+/**
+top
+
+Returns the process with the lowest estimated remaining run time.
+
+@pre queue is not empty
+@post none
+@return list<PCB>::iterator to process
+*/
+list<PCB>::iterator ReadyQueue::top()
+{
+   return heap.front();
+}
+
+/**
+pop
+
+Removes the process with the lowest estimated remaining run time.
+
+@pre queue is not empty
+@post top process was removed
+@return void
+*/
+void ReadyQueue::pop()
+{
+   // move last process into top position
+   heap.front() = heap.back();
+   heap.pop_back();
+
+   // restore heap order
+   if( !heap.empty() )
+   {
+      siftDown( 0 );
+   }
+}
+
+/**
+empty
+
+Returns true if queue has no processes.
+
+@pre none
+@post none
+@return bool representing empty queue
+*/
+bool ReadyQueue::empty()
+{
+   return heap.empty();
+}
+
+/**
+isBefore
+
+Returns true if the first heap node should run before the second:
+lower estimated run time, or equal run time and queued more recently.
+
+@param first index of first node
+@param second index of second node
+@pre both indices are in heap
+@post none
+@return bool representing first node runs before second
+*/
+bool ReadyQueue::isBefore( int first, int second )
+{
+   // compare run times
+   if( heap[ first ]->estimatedRuntime != heap[ second ]->estimatedRuntime )
+   {
+      return heap[ first ]->estimatedRuntime < heap[ second ]->estimatedRuntime;
+   }
+
+   // break ties by most recently queued
+   return heap[ first ]->readySequence > heap[ second ]->readySequence;
+}
+
+/**
+swapNodes
+
+Swaps two heap nodes.
+
+@param first index of first node
+@param second index of second node
+@pre both indices are in heap
+@post nodes were swapped
+@return void
+*/
+void ReadyQueue::swapNodes( int first, int second )
+{
+   // initialize variables
+   list<PCB>::iterator temp = heap[ first ];
+
+   heap[ first ] = heap[ second ];
+   heap[ second ] = temp;
+}
+
+/**
+siftUp
+
+Moves a node up until its parent runs before it.
+
+@param index index of node to move
+@pre index is in heap
+@post heap order restored above node
+@return void
+*/
+void ReadyQueue::siftUp( int index )
+{
+   // initialize variables
+   int parent;
+
+   while( index > 0 )
+   {
+      parent = ( index - 1 ) / 2;
+
+      // check for correct order
+      if( !isBefore( index, parent ) )
+      {
+         return;
+      }
+
+      swapNodes( index, parent );
+      index = parent;
+   }
+}
+
+/**
+siftDown
+
+Moves a node down until it runs before both of its children.
+
+@param index index of node to move
+@pre index is in heap
+@post heap order restored below node
+@return void
+*/
+void ReadyQueue::siftDown( int index )
+{
+   // initialize variables
+   int heapSize = heap.size();
+   int child;
+
+   while( 2 * index + 1 < heapSize )
+   {
+      // find child that runs first
+      child = 2 * index + 1;
+
+      if( child + 1 < heapSize && isBefore( child + 1, child ) )
+      {
+         child++;
+      }
+
+      // check for correct order
+      if( !isBefore( child, index ) )
+      {
+         return;
+      }
+
+      swapNodes( index, child );
+      index = child;
+   }
+}
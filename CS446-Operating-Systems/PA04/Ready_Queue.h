@@ -0,0 +1,41 @@
+/**
+ * @file   Ready_Queue.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Shortest remaining time ready queue header for Operating System simulator
+ */
+
+// definition
+   #ifndef __READYQUEUE_H_
+   #define __READYQUEUE_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include <list> // used to store processes
+   #include <vector> // used as heap container
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class declaration
+class ReadyQueue
+{
+   public:
+      ReadyQueue();
+      void push( list<PCB>::iterator process );
+      list<PCB>::iterator top();
+      void pop();
+      bool empty();
+   private:
+      bool isBefore( int first, int second );
+      void swapNodes( int first, int second );
+      void siftUp( int index );
+      void siftDown( int index );
+      vector< list<PCB>::iterator > heap; // min-heap of processes
+      long sequence; // order processes were queued in
+};
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file   Ready_Ring.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Lock-free ready ring for Operating System simulator
+ *
+ * A bounded ring of process handles that any number of processors can
+ * push to and pop from at once without a lock. Cell i starts with
+ * sequence i. A push at position p waits for sequence p, claims p by
+ * moving the push position forward, stores the handle, and sets the
+ * sequence to p + 1. A pop at position p waits for sequence p + 1, claims
+ * p, takes the handle, and sets the sequence to p + slot count, ready for
+ * the next push one lap later. Positions only grow, so a claim cannot be
+ * confused with an old one (no ABA problem), and no memory is allocated
+ * or freed while the ring is in use. A thread that finds a cell from an
+ * earlier lap checks its position is still current before reporting the
+ * ring full or empty (it may have been descheduled for several laps), and
+ * a push that reaches a cell whose pop has claimed it but not emptied it
+ * yet waits for that pop, so a push only fails when the ring really is full.
+ */
+
+// header files
+   #include "Ready_Ring.h"
+   #include "Process_Control_Block.h"
+   #include <list> // used for process handles
+   #include <atomic> // used for lock-free positions
+   #include <cstddef> // used for sizes
+
+   using namespace std;
+
+// global constants
+   const size_t MIN_RING_SIZE = 2;
+
+// global variables
+
+// class implementation
+ReadyRing::ReadyRing()
+{
+   cells = NULL;
+   mask = 0;
+   pushPosition.store( 0 );
+   popPosition.store( 0 );
+}
+
+ReadyRing::~ReadyRing()
+{
+   delete[] cells;
+}
+
+/**
+reserve
+
+Empties the ring and makes room for at least the given number of
+handles (rounded up to a power of two).
+
+@param capacity most handles held at once
+@pre no thread is using the ring
+@post ring is empty
+@return void
+*/
+void ReadyRing::reserve( size_t capacity )
+{
+   // initialize variables
+   size_t slotCount = MIN_RING_SIZE;
+   size_t index;
+
+   while( slotCount < capacity )
+   {
+      slotCount *= 2;
+   }
+
+   delete[] cells;
+   cells = new RingCell[ slotCount ];
+   mask = slotCount - 1;
+
+   for( index = 0; index < slotCount; index++ )
+   {
+      cells[ index ].sequence.store( index, memory_order_relaxed );
+   }
+
+   pushPosition.store( 0, memory_order_relaxed );
+   popPosition.store( 0, memory_order_release );
+}
+
+/**
+push
+
+Adds a process handle to the back of the ring.
+
+@param process handle of process to add
+@pre ring was reserved
+@post handle is at back of ring, unless ring was full
+@return bool representing handle was added (false if ring held capacity handles)
+*/
+bool ReadyRing::push( list<PCB>::iterator process )
+{
+   // initialize variables
+   RingCell* cell;
+   size_t position = pushPosition.load( memory_order_relaxed );
+   size_t current;
+   size_t sequence;
+
+   while( true )
+   {
+      cell = &( cells[ position & mask ] );
+      sequence = cell->sequence.load( memory_order_acquire );
+
+      // cell is free at this position, try to claim it
+      if( sequence == position )
+      {
+         if( pushPosition.compare_exchange_weak( position, position + 1, memory_order_relaxed ) )
+         {
+            break;
+         }
+      }
+
+      // cell still holds a handle from an earlier lap
+      else if( sequence < position )
+      {
+         current = pushPosition.load( memory_order_acquire );
+
+         // ring is full (position is current and a whole lap ahead of pops)
+         if( current == position &&
+             (ptrdiff_t)( position - popPosition.load( memory_order_acquire ) ) > (ptrdiff_t) mask )
+         {
+            return false;
+         }
+
+         // otherwise position was old, or the pop one lap ago has claimed
+         // the cell but not emptied it yet, try again
+         position = current;
+      }
+
+      // another thread claimed position, try next one
+      else
+      {
+         position = pushPosition.load( memory_order_relaxed );
+      }
+   }
+
+   // fill cell and publish it to poppers
+   cell->process = process;
+   cell->sequence.store( position + 1, memory_order_release );
+
+   return true;
+}
+
+/**
+pop
+
+Removes the process handle at the front of the ring.
+
+@param process reference to save handle to
+@pre ring was reserved
+@post front handle was removed, unless ring was empty
+@return bool representing a handle was removed (false if ring was empty)
+*/
+bool ReadyRing::pop( list<PCB>::iterator& process )
+{
+   // initialize variables
+   RingCell* cell;
+   size_t position = popPosition.load( memory_order_relaxed );
+   size_t current;
+   size_t sequence;
+
+   while( true )
+   {
+      cell = &( cells[ position & mask ] );
+      sequence = cell->sequence.load( memory_order_acquire );
+
+      // cell is filled at this position, try to claim it
+      if( sequence == position + 1 )
+      {
+         if( popPosition.compare_exchange_weak( position, position + 1, memory_order_relaxed ) )
+         {
+            break;
+         }
+      }
+
+      // cell not filled at this position
+      else if( sequence < position + 1 )
+      {
+         current = popPosition.load( memory_order_acquire );
+
+         // ring is empty, or its push has not finished
+         if( current == position )
+         {
+            return false;
+         }
+
+         // otherwise position was old, try again
+         position = current;
+      }
+
+      // another thread claimed position, try next one
+      else
+      {
+         position = popPosition.load( memory_order_relaxed );
+      }
+   }
+
+   // empty cell and free it for the push one lap later
+   process = cell->process;
+   cell->sequence.store( position + mask + 1, memory_order_release );
+
+   return true;
+}
+
+/**
+capacity
+
+Returns the most handles the ring can hold.
+
+@pre none
+@post none
+@return size_t with slot count
+*/
+size_t ReadyRing::capacity()
+{
+   return cells == NULL ? 0 : mask + 1;
+}
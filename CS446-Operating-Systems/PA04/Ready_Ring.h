@@ -0,0 +1,58 @@
+/**
+ * @file   Ready_Ring.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Lock-free ready ring header for Operating System simulator
+ */
+
+// definition
+   #ifndef __READYRING_H_
+   #define __READYRING_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include <list> // used for process handles
+   #include <atomic> // used for lock-free positions
+   #include <cstddef> // used for sizes
+
+   using namespace std;
+
+// global constants
+   const int CACHE_LINE_SIZE = 64; // bytes kept between positions so processors do not share a line
+
+// global variables
+
+// class declaration
+
+// slot of the ring, with the position it is ready for
+class RingCell
+{
+   public:
+      atomic<size_t> sequence; // position this cell can next be pushed (or popped, plus one) at
+      list<PCB>::iterator process; // queued process handle
+};
+
+// bounded multi-producer multi-consumer queue of process handles, in
+// first-in first-out order, with no lock. Each push and pop claims a
+// position with one compare-and-swap, and each cell's sequence number
+// tells whether the position has been filled (or emptied) yet.
+class ReadyRing
+{
+   public:
+      ReadyRing();
+      ~ReadyRing();
+      void reserve( size_t capacity );
+      bool push( list<PCB>::iterator process );
+      bool pop( list<PCB>::iterator& process );
+      size_t capacity();
+   private:
+      RingCell* cells; // ring slots (count is a power of two)
+      size_t mask; // slot count minus one
+      char headPad[ CACHE_LINE_SIZE ];
+      atomic<size_t> pushPosition; // next position to push at
+      char middlePad[ CACHE_LINE_SIZE ];
+      atomic<size_t> popPosition; // next position to pop from
+      char tailPad[ CACHE_LINE_SIZE ];
+};
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ * @file   Run_Stats.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Scheduler statistics for Operating System simulator
+ *
+ * Each PCB keeps its own arrival, first run, exit, wait and blocked
+ * times as it changes state. When a process exits, its times are added
+ * here (a few doubles per process), and summaries with percentiles are
+ * only worked out once, at the end of the run.
+ */
+
+// header files
+   #include "Run_Stats.h"
+   #include "Process_Control_Block.h"
+   #include <vector> // used to store process times
+   #include <algorithm> // used for sorting times
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+   // measure names, indexed by TimeMeasure
+   const char* const MEASURE_NAMES[ MEASURE_COUNT ] =
+   {
+      "turnaround", "wait", "response", "blocked"
+   };
+
+// function prototypes
+   double findPercentile( const vector<double>& sortedTimes, int percent );
+
+// class implementation
+RunStats::RunStats()
+{
+   dispatches = 0;
+   pthread_mutex_init( &lock, NULL );
+}
+
+RunStats::~RunStats()
+{
+   pthread_mutex_destroy( &lock );
+}
+
+/**
+record
+
+Adds the times of an exited process.
+
+@param process process that reached Exit state
+@pre process exit time was set
+@post process times were added
+@return void
+*/
+void RunStats::record( const PCB& process )
+{
+   pthread_mutex_lock( &lock );
+
+   times[ TURNAROUND_TIME ].push_back( process.exitTime - process.arrivalTime );
+   times[ WAIT_TIME ].push_back( process.waitTime );
+   times[ RESPONSE_TIME ].push_back( process.firstRunTime - process.arrivalTime );
+   times[ BLOCKED_TIME ].push_back( process.blockedTime );
+   dispatches += process.dispatchCount;
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+processCount
+
+Returns the number of exited processes recorded.
+
+@pre none
+@post none
+@return int with number of processes
+*/
+int RunStats::processCount()
+{
+   return times[ TURNAROUND_TIME ].size();
+}
+
+/**
+dispatchCount
+
+Returns the total number of dispatches (context switches) of exited processes.
+
+@pre none
+@post none
+@return long with number of dispatches
+*/
+long RunStats::dispatchCount()
+{
+   return dispatches;
+}
+
+/**
+summarize
+
+Works out the mean, minimum, maximum and 50th/95th/99th percentiles of
+one measure. Sorts the recorded times, so should be called after the run.
+
+@param measure TimeMeasure to summarize
+@pre run has completed
+@post times of measure are sorted
+@return TimeSummary of measure (all zero if no processes exited)
+*/
+TimeSummary RunStats::summarize( int measure )
+{
+   // initialize variables
+   TimeSummary summary = { 0, 0, 0, 0, 0, 0 };
+   vector<double>& measureTimes = times[ measure ];
+   double total = 0;
+   unsigned int index;
+
+   // check for no processes
+   if( measureTimes.empty() )
+   {
+      return summary;
+   }
+
+   sort( measureTimes.begin(), measureTimes.end() );
+
+   for( index = 0; index < measureTimes.size(); index++ )
+   {
+      total += measureTimes[ index ];
+   }
+
+   summary.mean = total / measureTimes.size();
+   summary.minimum = measureTimes.front();
+   summary.p50 = findPercentile( measureTimes, 50 );
+   summary.p95 = findPercentile( measureTimes, 95 );
+   summary.p99 = findPercentile( measureTimes, 99 );
+   summary.maximum = measureTimes.back();
+
+   return summary;
+}
+
+/**
+recordLevels
+
+Saves the statistics of each MLFQ level.
+
+@param levelSummaries statistics of each level, highest level first
+@pre run has completed
+@post level statistics were saved
+@return void
+*/
+void RunStats::recordLevels( const vector<LevelSummary>& levelSummaries )
+{
+   levels = levelSummaries;
+}
+
+/**
+levelSummaries
+
+Returns the statistics of each MLFQ level.
+
+@pre none
+@post none
+@return const vector<LevelSummary>& with statistics of each level (empty if none)
+*/
+const vector<LevelSummary>& RunStats::levelSummaries()
+{
+   return levels;
+}
+
+// function implementation
+
+/**
+findPercentile
+
+Returns the nearest-rank percentile of a sorted list of times.
+
+@param sortedTimes times in increasing order
+@param percent percentile to find (1 to 100)
+@pre sortedTimes is not empty
+@post none
+@return double with percentile time
+*/
+double findPercentile( const vector<double>& sortedTimes, int percent )
+{
+   // initialize variables
+   unsigned int rank = ( (unsigned long) percent * sortedTimes.size() + 99 ) / 100;
+
+   // rank starts at 1
+   if( rank < 1 )
+   {
+      rank = 1;
+   }
+
+   return sortedTimes[ rank - 1 ];
+}
@@ -0,0 +1,74 @@
+/**
+ * @file   Run_Stats.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Scheduler statistics header for Operating System simulator
+ */
+
+// definition
+   #ifndef __RUNSTATS_H_
+   #define __RUNSTATS_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include <vector> // used to store process times
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+   // process time measures
+   enum TimeMeasure
+   {
+      TURNAROUND_TIME,
+      WAIT_TIME,
+      RESPONSE_TIME,
+      BLOCKED_TIME,
+      MEASURE_COUNT
+   };
+
+// global variables
+   extern const char* const MEASURE_NAMES[ MEASURE_COUNT ];
+
+// class declaration
+class TimeSummary
+{
+   public:
+      double mean; // average time
+      double minimum; // shortest time
+      double p50; // median time
+      double p95; // 95th percentile time
+      double p99; // 99th percentile time
+      double maximum; // longest time
+};
+
+class LevelSummary
+{
+   public:
+      float quantum; // time quantum of level (cycles)
+      double residency; // total time processes spent at level
+      long dispatches; // dispatches at level
+      long demotions; // processes demoted from level
+      long exits; // processes that exited at level
+};
+
+class RunStats
+{
+   public:
+      RunStats();
+      ~RunStats();
+      void record( const PCB& process );
+      int processCount();
+      long dispatchCount();
+      TimeSummary summarize( int measure );
+      void recordLevels( const vector<LevelSummary>& levelSummaries );
+      const vector<LevelSummary>& levelSummaries();
+   private:
+      vector<double> times[ MEASURE_COUNT ]; // each measure of each exited process
+      long dispatches; // dispatches of exited processes (context switches)
+      vector<LevelSummary> levels; // MLFQ level statistics (empty for other policies)
+      pthread_mutex_t lock; // guards times when processors exit processes at once
+};
+
+#endif
@@ -0,0 +1,872 @@
+/**
+ * @file   Scheduling_Policy.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Scheduling policies for Operating System simulator
+ *
+ * Each scheduling code is a policy class that decides where processes go
+ * in the Ready queue and which one runs next. The policy is chosen once,
+ * when the configuration is read, and runProcesses runs one dispatch loop
+ * instantiated for that policy type, so selecting a process does not
+ * compare scheduling codes or call virtual functions.
+ *
+ * The MLFQ policy keeps the Ready processes of each level in their own
+ * queue (as positions in the Ready queue list), so selecting, demoting and
+ * boosting a process do not search the Ready queue. Running and Blocked
+ * processes are moved to the top level when they next return to the Ready
+ * queue after a boost, counting their time at the old level up to the boost.
+ *
+ * The CFS policy keeps Ready processes in a std::map (a red-black tree)
+ * keyed by virtual run time, so each selection and requeue is O(log n)
+ * however many processes are Ready.
+ */
+
+// header files
+   #include "Scheduling_Policy.h"
+   #include "Process_Control_Block.h"
+   #include "Ready_Queue.h"
+   #include <string> // used for string operations
+   #include <list> // used to store processes
+   #include <deque> // used for MLFQ levels
+   #include <vector> // used for MLFQ settings
+   #include <map> // used for CFS tree
+   #include <utility> // used for CFS tree keys
+   #include <cmath> // used to round time slices
+
+   using namespace std;
+
+// global constants
+   const float MSEC_PER_SEC = 1000;
+
+// global variables
+
+   // scheduling codes, indexed by PolicyID
+   const char* const POLICY_NAMES[ POLICY_COUNT ] =
+   {
+      "FIFO", "SJF", "SRTF", "FIFO-P", "RR", "SRTF-P", "MLFQ", "CFS"
+   };
+
+// function prototypes
+
+// class implementation
+PolicySettings::PolicySettings()
+{
+   levelCount = 0;
+   boostTime = MLFQ_DEFAULT_BOOST;
+   targetLatency = 0;
+   minGranularity = 0;
+}
+
+FifoPolicy::FifoPolicy( float quantum, const PolicySettings& settings )
+{
+   timeQuantum = quantum;
+}
+
+FifoPreemptivePolicy::FifoPreemptivePolicy( float quantum, const PolicySettings& settings )
+   : FifoPolicy( quantum, settings )
+{
+}
+
+RoundRobinPolicy::RoundRobinPolicy( float quantum, const PolicySettings& settings )
+   : FifoPolicy( quantum, settings )
+{
+}
+
+ShortestRemainingPolicy::ShortestRemainingPolicy( float quantum, const PolicySettings& settings )
+   : FifoPolicy( quantum, settings )
+{
+}
+
+ShortestJobPolicy::ShortestJobPolicy( float quantum, const PolicySettings& settings )
+   : ShortestRemainingPolicy( quantum, settings )
+{
+}
+
+ShortestRemainingPreemptivePolicy::ShortestRemainingPreemptivePolicy( float quantum, const PolicySettings& settings )
+   : ShortestRemainingPolicy( quantum, settings )
+{
+}
+
+FeedbackQueuePolicy::FeedbackQueuePolicy( float quantum, const PolicySettings& settings )
+   : FifoPolicy( quantum, settings )
+{
+   // initialize variables
+   LevelSummary emptyLevel = { 0, 0, 0, 0, 0 };
+   int level;
+
+   levels.resize( settings.levelCount );
+   levelStats.resize( settings.levelCount, emptyLevel );
+
+   for( level = 0; level < settings.levelCount; level++ )
+   {
+      levelStats[ level ].quantum = settings.levelQuanta[ level ];
+   }
+
+   boostTime = settings.boostTime / MSEC_PER_SEC;
+   lastBoost = 0;
+   nextBoost = boostTime;
+}
+
+FairSharePolicy::FairSharePolicy( float quantum, const PolicySettings& settings )
+   : FifoPolicy( quantum, settings )
+{
+   sequence = 0;
+   minRuntime = 0;
+   targetLatency = settings.targetLatency;
+   minGranularity = settings.minGranularity;
+   runnableCount = 1;
+   runStart = 0;
+}
+
+/**
+admit
+
+Moves newly read processes to the end of the Ready queue.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param newProcesses processes read from meta-data file
+@param currentTime simulator time
+@pre none
+@post newProcesses is empty
+@return void
+*/
+void FifoPolicy::admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime )
+{
+   readyQueue.splice( readyQueue.end(), newProcesses );
+}
+
+/**
+selectNext
+
+Returns the front of the Ready queue.
+
+@param readyQueue non-empty list of PCB objects in the Ready queue
+@param currentTime simulator time
+@pre readyQueue is not empty
+@post none
+@return list<PCB>::iterator to selected process
+*/
+list<PCB>::iterator FifoPolicy::selectNext( list<PCB>& readyQueue, double currentTime )
+{
+   return readyQueue.begin();
+}
+
+/**
+onPreempt
+
+Moves the running process to the end of the Ready queue.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param runningQueue list holding the running process at its front
+@param usedQuantum true if process ran for its whole quantum
+@param currentTime simulator time
+@pre process was preempted
+@post process was moved into Ready queue
+@return void
+*/
+void FifoPolicy::onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime )
+{
+   readyQueue.splice( readyQueue.end(), runningQueue, runningQueue.begin() );
+}
+
+/**
+onBlock
+
+Called when a process was moved to the Blocked queue for I/O.
+
+@param process blocked process
+@param currentTime simulator time
+@pre process is Blocked
+@post none
+@return void
+*/
+void FifoPolicy::onBlock( PCB& process, double currentTime )
+{
+}
+
+/**
+onReady
+
+Moves a process whose I/O completed to the end of the Ready queue.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param blockedQueue list of PCB objects waiting on I/O
+@param process process returning from I/O
+@param currentTime simulator time
+@pre process is Ready
+@post process was moved into Ready queue
+@return void
+*/
+void FifoPolicy::onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime )
+{
+   readyQueue.splice( readyQueue.end(), blockedQueue, process );
+}
+
+/**
+onComplete
+
+Called when a process reached Exit state.
+
+@param process exited process
+@param currentTime simulator time
+@pre process is in Exit state
+@post none
+@return void
+*/
+void FifoPolicy::onComplete( PCB& process, double currentTime )
+{
+}
+
+/**
+findQuantum
+
+Returns the time quantum to run the selected process for.
+
+@param process selected process
+@pre none
+@post none
+@return float with time quantum (cycles)
+*/
+float FifoPolicy::findQuantum( const PCB& process )
+{
+   return timeQuantum;
+}
+
+/**
+setQuantum
+
+Changes the time quantum of later dispatches, after the configuration was
+reloaded. MLFQ and CFS find their own quanta, so keep their starting ones.
+
+@param quantum new time quantum (cycles)
+@pre quantum is positive
+@post processes selected later run for the new quantum
+@return void
+*/
+void FifoPolicy::setQuantum( float quantum )
+{
+   timeQuantum = quantum;
+}
+
+/**
+finish
+
+Adds statistics of the policy to the run statistics. Only MLFQ has any.
+
+@param stats statistics of the run
+@param currentTime simulator time
+@pre run has completed
+@post none
+@return void
+*/
+void FifoPolicy::finish( RunStats& stats, double currentTime )
+{
+}
+
+/**
+onPreempt
+
+Moves the running process to the front of the Ready queue, so it keeps
+its place in process number order.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param runningQueue list holding the running process at its front
+@param usedQuantum true if process ran for its whole quantum
+@param currentTime simulator time
+@pre process was preempted
+@post process was moved into Ready queue
+@return void
+*/
+void FifoPreemptivePolicy::onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime )
+{
+   readyQueue.splice( readyQueue.begin(), runningQueue, runningQueue.begin() );
+}
+
+/**
+onReady
+
+Moves a process whose I/O completed into the Ready queue in order of
+process number.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param blockedQueue list of PCB objects waiting on I/O
+@param process process returning from I/O
+@param currentTime simulator time
+@pre process is Ready
+@post process was moved into Ready queue
+@return void
+*/
+void FifoPreemptivePolicy::onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime )
+{
+   readyQueue.splice( findIDPosition( readyQueue, *process ), blockedQueue, process );
+}
+
+/**
+admit
+
+Moves newly read processes to the end of the Ready queue and adds
+them to the heap.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param newProcesses processes read from meta-data file
+@param currentTime simulator time
+@pre none
+@post newProcesses is empty
+@return void
+*/
+void ShortestRemainingPolicy::admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime )
+{
+   // initialize variables
+   list<PCB>::iterator process;
+
+   for( process = newProcesses.begin(); process != newProcesses.end(); process++ )
+   {
+      readyHeap.push( process );
+   }
+
+   readyQueue.splice( readyQueue.end(), newProcesses );
+}
+
+/**
+selectNext
+
+Removes the process with the lowest estimated remaining run time from
+the heap and returns it.
+
+@param readyQueue non-empty list of PCB objects in the Ready queue
+@param currentTime simulator time
+@pre readyQueue is not empty
+@post selected process is no longer in heap
+@return list<PCB>::iterator to selected process
+*/
+list<PCB>::iterator ShortestRemainingPolicy::selectNext( list<PCB>& readyQueue, double currentTime )
+{
+   // initialize variables
+   list<PCB>::iterator process = readyHeap.top();
+
+   readyHeap.pop();
+
+   return process;
+}
+
+/**
+onPreempt
+
+Moves the running process to the end of the Ready queue and adds it
+to the heap with its new remaining run time.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param runningQueue list holding the running process at its front
+@param usedQuantum true if process ran for its whole quantum
+@param currentTime simulator time
+@pre process was preempted
+@post process was moved into Ready queue
+@return void
+*/
+void ShortestRemainingPolicy::onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime )
+{
+   readyQueue.splice( readyQueue.end(), runningQueue, runningQueue.begin() );
+   readyHeap.push( --readyQueue.end() );
+}
+
+/**
+onReady
+
+Moves a process whose I/O completed to the end of the Ready queue and
+adds it to the heap.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param blockedQueue list of PCB objects waiting on I/O
+@param process process returning from I/O
+@param currentTime simulator time
+@pre process is Ready
+@post process was moved into Ready queue
+@return void
+*/
+void ShortestRemainingPolicy::onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime )
+{
+   readyQueue.splice( readyQueue.end(), blockedQueue, process );
+   readyHeap.push( process );
+}
+
+/**
+admit
+
+Moves newly read processes to the end of the Ready queue, at the top level.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param newProcesses processes read from meta-data file
+@param currentTime simulator time
+@pre none
+@post newProcesses is empty
+@return void
+*/
+void FeedbackQueuePolicy::admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime )
+{
+   // initialize variables
+   list<PCB>::iterator process;
+
+   for( process = newProcesses.begin(); process != newProcesses.end(); process++ )
+   {
+      process->priorityLevel = 0;
+      process->levelSince = currentTime;
+      levels[ 0 ].push_back( process );
+   }
+
+   readyQueue.splice( readyQueue.end(), newProcesses );
+}
+
+/**
+selectNext
+
+Boosts every process to the top level if a boost is due, then removes
+the first process of the highest non-empty level and returns it.
+
+@param readyQueue non-empty list of PCB objects in the Ready queue
+@param currentTime simulator time
+@pre readyQueue is not empty
+@post selected process is no longer in its level
+@return list<PCB>::iterator to selected process
+*/
+list<PCB>::iterator FeedbackQueuePolicy::selectNext( list<PCB>& readyQueue, double currentTime )
+{
+   // initialize variables
+   list<PCB>::iterator process;
+   unsigned int level = 0;
+
+   // check for priority boost
+   if( boostTime > 0 && currentTime >= nextBoost )
+   {
+      boost( currentTime );
+   }
+
+   // find highest non-empty level
+   while( levels[ level ].empty() )
+   {
+      level++;
+   }
+
+   process = levels[ level ].front();
+   levels[ level ].pop_front();
+
+   levelStats[ level ].dispatches++;
+
+   return process;
+}
+
+/**
+findQuantum
+
+Returns the time quantum of the level of the selected process.
+
+@param process selected process
+@pre none
+@post none
+@return float with time quantum (cycles)
+*/
+float FeedbackQueuePolicy::findQuantum( const PCB& process )
+{
+   return levelStats[ process.priorityLevel ].quantum;
+}
+
+/**
+onPreempt
+
+Moves a process that used its whole quantum down one level (unless it
+is at the lowest level), and to the end of the Ready queue. A process
+whose action finished before its quantum keeps its level.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param runningQueue list holding the running process at its front
+@param usedQuantum true if process ran for its whole quantum
+@param currentTime simulator time
+@pre process was preempted
+@post process was moved into Ready queue
+@return void
+*/
+void FeedbackQueuePolicy::onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime )
+{
+   // initialize variables
+   PCB& process = runningQueue.front();
+
+   applyBoost( process );
+
+   // demote process
+   if( usedQuantum && process.priorityLevel + 1 < (int) levels.size() )
+   {
+      levelStats[ process.priorityLevel ].demotions++;
+      changeLevel( process, process.priorityLevel + 1, currentTime );
+   }
+
+   readyQueue.splice( readyQueue.end(), runningQueue, runningQueue.begin() );
+   levels[ process.priorityLevel ].push_back( --readyQueue.end() );
+}
+
+/**
+onReady
+
+Moves a process whose I/O completed to the end of the Ready queue, at
+the same level (or the top level, if a boost happened while it was Blocked).
+
+@param readyQueue list of PCB objects in the Ready queue
+@param blockedQueue list of PCB objects waiting on I/O
+@param process process returning from I/O
+@param currentTime simulator time
+@pre process is Ready
+@post process was moved into Ready queue
+@return void
+*/
+void FeedbackQueuePolicy::onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime )
+{
+   applyBoost( *process );
+
+   readyQueue.splice( readyQueue.end(), blockedQueue, process );
+   levels[ process->priorityLevel ].push_back( process );
+}
+
+/**
+onComplete
+
+Adds the time an exited process spent at its last level.
+
+@param process exited process
+@param currentTime simulator time
+@pre process is in Exit state
+@post level residency was updated
+@return void
+*/
+void FeedbackQueuePolicy::onComplete( PCB& process, double currentTime )
+{
+   applyBoost( process );
+
+   levelStats[ process.priorityLevel ].residency += currentTime - process.levelSince;
+   levelStats[ process.priorityLevel ].exits++;
+}
+
+/**
+finish
+
+Saves the statistics of each level in the run statistics.
+
+@param stats statistics of the run
+@param currentTime simulator time
+@pre run has completed
+@post level statistics were saved
+@return void
+*/
+void FeedbackQueuePolicy::finish( RunStats& stats, double currentTime )
+{
+   stats.recordLevels( levelStats );
+}
+
+/**
+boost
+
+Moves every Ready process that entered its level before the boost time
+to the top level, keeping their order (top level first). Running and
+Blocked processes are moved by applyBoost when they return to the Ready
+queue.
+
+@param currentTime simulator time
+@pre boost is due
+@post every Ready process is at the top level, next boost time was set
+@return void
+*/
+void FeedbackQueuePolicy::boost( double currentTime )
+{
+   // initialize variables
+   unsigned int level;
+   list<PCB>::iterator process;
+   deque< list<PCB>::iterator > remaining;
+
+   // find latest boost time (boosts missed while idle are combined)
+   lastBoost = nextBoost + boostTime * (long) ( ( currentTime - nextBoost ) / boostTime );
+   nextBoost = lastBoost + boostTime;
+
+   // move each lower level to top level
+   for( level = 1; level < levels.size(); level++ )
+   {
+      while( !levels[ level ].empty() )
+      {
+         process = levels[ level ].front();
+         levels[ level ].pop_front();
+
+         // keep processes demoted since the boost time
+         if( process->levelSince >= lastBoost )
+         {
+            remaining.push_back( process );
+
+            continue;
+         }
+
+         changeLevel( *process, 0, lastBoost );
+         levels[ 0 ].push_back( process );
+      }
+
+      levels[ level ].swap( remaining );
+   }
+}
+
+/**
+applyBoost
+
+Moves a process to the top level if a boost happened since it entered
+its level.
+
+@param process process returning to the Ready queue or exiting
+@pre none
+@post process level is up to date
+@return void
+*/
+void FeedbackQueuePolicy::applyBoost( PCB& process )
+{
+   if( process.priorityLevel > 0 && process.levelSince < lastBoost )
+   {
+      changeLevel( process, 0, lastBoost );
+   }
+}
+
+/**
+changeLevel
+
+Moves a process to another level, adding its time at the old level.
+
+@param process process to move
+@param level new level
+@param currentTime time of move
+@pre none
+@post process is at new level
+@return void
+*/
+void FeedbackQueuePolicy::changeLevel( PCB& process, int level, double currentTime )
+{
+   levelStats[ process.priorityLevel ].residency += currentTime - process.levelSince;
+
+   process.priorityLevel = level;
+   process.levelSince = currentTime;
+}
+
+/**
+admit
+
+Moves newly read processes to the end of the Ready queue and adds them
+to the tree with the lowest virtual run time, so they neither wait
+behind nor starve processes that have already run.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param newProcesses processes read from meta-data file
+@param currentTime simulator time
+@pre none
+@post newProcesses is empty
+@return void
+*/
+void FairSharePolicy::admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime )
+{
+   // initialize variables
+   list<PCB>::iterator process;
+
+   for( process = newProcesses.begin(); process != newProcesses.end(); process++ )
+   {
+      process->virtualRuntime = minRuntime;
+      insert( process );
+   }
+
+   readyQueue.splice( readyQueue.end(), newProcesses );
+}
+
+/**
+selectNext
+
+Removes the process with the lowest virtual run time from the tree and
+returns it.
+
+@param readyQueue non-empty list of PCB objects in the Ready queue
+@param currentTime simulator time
+@pre readyQueue is not empty
+@post selected process is no longer in tree
+@return list<PCB>::iterator to selected process
+*/
+list<PCB>::iterator FairSharePolicy::selectNext( list<PCB>& readyQueue, double currentTime )
+{
+   // initialize variables
+   list<PCB>::iterator process = tree.begin()->second;
+
+   tree.erase( tree.begin() );
+
+   // count Ready processes for time slice
+   runnableCount = tree.size() + 1;
+   runStart = currentTime;
+
+   // update lowest virtual run time
+   if( process->virtualRuntime > minRuntime )
+   {
+      minRuntime = process->virtualRuntime;
+   }
+
+   return process;
+}
+
+/**
+findQuantum
+
+Returns the time slice of the selected process: the target latency
+shared among the Ready processes, in whole cycles, and no shorter than
+the minimum granularity.
+
+@param process selected process
+@pre process was selected
+@post none
+@return float with time slice (cycles)
+*/
+float FairSharePolicy::findQuantum( const PCB& process )
+{
+   // initialize variables
+   float timeSlice = floor( targetLatency / runnableCount );
+
+   if( timeSlice < minGranularity )
+   {
+      timeSlice = minGranularity;
+   }
+
+   return timeSlice;
+}
+
+/**
+onPreempt
+
+Adds the time the running process ran to its virtual run time and
+returns it to the Ready queue and tree.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param runningQueue list holding the running process at its front
+@param usedQuantum true if process ran for its whole quantum
+@param currentTime simulator time
+@pre process was preempted
+@post process was moved into Ready queue
+@return void
+*/
+void FairSharePolicy::onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime )
+{
+   chargeRuntime( runningQueue.front(), currentTime );
+
+   readyQueue.splice( readyQueue.end(), runningQueue, runningQueue.begin() );
+   insert( --readyQueue.end() );
+}
+
+/**
+onBlock
+
+Adds the time a process ran before blocking to its virtual run time.
+
+@param process blocked process
+@param currentTime simulator time
+@pre process is Blocked
+@post virtual run time was updated
+@return void
+*/
+void FairSharePolicy::onBlock( PCB& process, double currentTime )
+{
+   chargeRuntime( process, currentTime );
+}
+
+/**
+onReady
+
+Moves a process whose I/O completed into the Ready queue and tree. Its
+virtual run time is raised to the lowest one, so time spent Blocked does
+not let it run ahead of every other process.
+
+@param readyQueue list of PCB objects in the Ready queue
+@param blockedQueue list of PCB objects waiting on I/O
+@param process process returning from I/O
+@param currentTime simulator time
+@pre process is Ready
+@post process was moved into Ready queue
+@return void
+*/
+void FairSharePolicy::onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime )
+{
+   if( process->virtualRuntime < minRuntime )
+   {
+      process->virtualRuntime = minRuntime;
+   }
+
+   readyQueue.splice( readyQueue.end(), blockedQueue, process );
+   insert( process );
+}
+
+/**
+onComplete
+
+Adds the time an exited process ran to its virtual run time.
+
+@param process exited process
+@param currentTime simulator time
+@pre process is in Exit state
+@post virtual run time was updated
+@return void
+*/
+void FairSharePolicy::onComplete( PCB& process, double currentTime )
+{
+   chargeRuntime( process, currentTime );
+}
+
+/**
+insert
+
+Adds a Ready process to the tree. Processes with the same virtual run
+time are kept in the order they were queued.
+
+@param process process in Ready queue
+@pre process is not in tree
+@post process is in tree
+@return void
+*/
+void FairSharePolicy::insert( list<PCB>::iterator process )
+{
+   tree.insert( make_pair( make_pair( process->virtualRuntime, sequence++ ), process ) );
+}
+
+/**
+chargeRuntime
+
+Adds the time since the current process was selected to its virtual
+run time.
+
+@param process process that was running
+@param currentTime simulator time
+@pre process was selected at runStart
+@post virtual run time was updated
+@return void
+*/
+void FairSharePolicy::chargeRuntime( PCB& process, double currentTime )
+{
+   process.virtualRuntime += currentTime - runStart;
+   runStart = currentTime;
+}
+
+// function implementation
+
+/**
+findIDPosition
+
+Finds where a process goes in a Ready queue kept in process number order.
+
+@param readyQueue list of PCB objects in process number order
+@param process process to place
+@pre none
+@post none
+@return list<PCB>::iterator to insert process before
+*/
+list<PCB>::iterator findIDPosition( list<PCB>& readyQueue, const PCB& process )
+{
+   // initialize variables
+   list<PCB>::iterator position = readyQueue.begin();
+
+   while( position != readyQueue.end() && position->processID < process.processID )
+   {
+      position++;
+   }
+
+   return position;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file   Scheduling_Policy.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Scheduling policy header for Operating System simulator
+ */
+
+// definition
+   #ifndef __SCHEDULINGPOLICY_H_
+   #define __SCHEDULINGPOLICY_H_
+
+// header files
+   #include "Process_Control_Block.h"
+   #include "Ready_Queue.h"
+   #include "Run_Stats.h"
+   #include <string> // used for string operations
+   #include <list> // used to store processes
+   #include <deque> // used for MLFQ levels
+   #include <vector> // used for MLFQ settings
+   #include <map> // used for CFS tree
+   #include <utility> // used for CFS tree keys
+
+   using namespace std;
+
+// global constants
+
+   // scheduling policies, indexed by policy ID
+   enum PolicyID
+   {
+      POLICY_FIFO,
+      POLICY_SJF,
+      POLICY_SRTF,
+      POLICY_FIFO_P,
+      POLICY_RR,
+      POLICY_SRTF_P,
+      POLICY_MLFQ,
+      POLICY_CFS,
+      POLICY_COUNT
+   };
+
+   const int NO_POLICY = -1;
+   const int MLFQ_DEFAULT_LEVELS = 3;
+   const float MLFQ_DEFAULT_BOOST = 1000; // msec
+   const int CFS_LATENCY_QUANTA = 8; // default target latency (time quanta)
+
+// global variables
+   extern const char* const POLICY_NAMES[ POLICY_COUNT ];
+
+// function prototypes
+   list<PCB>::iterator findIDPosition( list<PCB>& readyQueue, const PCB& process );
+
+// class declaration
+
+// settings of policies beyond the time quantum, read from the configuration file
+class PolicySettings
+{
+   public:
+      PolicySettings();
+      int levelCount; // MLFQ levels (0 until configuration is read)
+      vector<float> levelQuanta; // MLFQ time quantum of each level (cycles)
+      float boostTime; // MLFQ time between priority boosts (msec, 0 for none)
+      float targetLatency; // CFS time to run every Ready process once (cycles, 0 until read)
+      float minGranularity; // CFS shortest time slice (cycles, 0 until read)
+};
+
+// Every policy has the same members, which the dispatch loop in
+// runProcesses calls on the policy type it was instantiated for
+// (no virtual functions):
+//    PREEMPTIVE   true to run one quantum at a time and send I/O to devices
+//    constructor  takes the time quantum and PolicySettings
+//    admit        moves newly read processes into the Ready queue
+//    selectNext   returns the Ready process to run next
+//    findQuantum  returns the time quantum to run the selected process for
+//    onPreempt    moves the running process back into the Ready queue
+//                 (usedQuantum is false if its action finished early)
+//    onBlock      process was moved to the Blocked queue for I/O
+//    onReady      moves a process whose I/O completed into the Ready queue
+//    onComplete   process reached Exit state
+//    finish       adds policy statistics to RunStats at the end of the run
+// A new policy is added by writing a class with these members, giving it a
+// PolicyID and name, and adding its case to runProcesses.
+
+// first-in first-out (fifo): runs processes in order of process number
+class FifoPolicy
+{
+   public:
+      static const bool PREEMPTIVE = false;
+      FifoPolicy( float quantum, const PolicySettings& settings );
+      void admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime );
+      list<PCB>::iterator selectNext( list<PCB>& readyQueue, double currentTime );
+      float findQuantum( const PCB& process );
+      void setQuantum( float quantum );
+      void onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime );
+      void onBlock( PCB& process, double currentTime );
+      void onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime );
+      void onComplete( PCB& process, double currentTime );
+      void finish( RunStats& stats, double currentTime );
+   protected:
+      float timeQuantum; // time quantum (cycles)
+};
+
+// first-in first-out preemptive (fifo-p): preempted and returning processes
+// keep their place in process number order
+class FifoPreemptivePolicy : public FifoPolicy
+{
+   public:
+      static const bool PREEMPTIVE = true;
+      FifoPreemptivePolicy( float quantum, const PolicySettings& settings );
+      void onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime );
+      void onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime );
+};
+
+// round robin (rr): preempted and returning processes go to the back
+class RoundRobinPolicy : public FifoPolicy
+{
+   public:
+      static const bool PREEMPTIVE = true;
+      RoundRobinPolicy( float quantum, const PolicySettings& settings );
+};
+
+// shortest remaining time first (srtf): runs the process with the lowest
+// estimated remaining run time, found with a heap
+class ShortestRemainingPolicy : public FifoPolicy
+{
+   public:
+      ShortestRemainingPolicy( float quantum, const PolicySettings& settings );
+      void admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime );
+      list<PCB>::iterator selectNext( list<PCB>& readyQueue, double currentTime );
+      void onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime );
+      void onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime );
+   private:
+      ReadyQueue readyHeap; // Ready processes by remaining run time
+};
+
+// shortest job first (sjf): runs processes in order of estimated run time.
+// Processes run to completion, so their remaining run time is always their
+// estimated run time, and the heap admits each arriving process in log time.
+class ShortestJobPolicy : public ShortestRemainingPolicy
+{
+   public:
+      ShortestJobPolicy( float quantum, const PolicySettings& settings );
+};
+
+// shortest remaining time first preemptive (srtf-p)
+class ShortestRemainingPreemptivePolicy : public ShortestRemainingPolicy
+{
+   public:
+      static const bool PREEMPTIVE = true;
+      ShortestRemainingPreemptivePolicy( float quantum, const PolicySettings& settings );
+};
+
+// multi-level feedback queue (mlfq): runs the first process of the highest
+// level, with a longer quantum at each lower level. A process that uses its
+// whole quantum moves down one level, and every process moves back to the
+// top level at each priority boost.
+class FeedbackQueuePolicy : public FifoPolicy
+{
+   public:
+      static const bool PREEMPTIVE = true;
+      FeedbackQueuePolicy( float quantum, const PolicySettings& settings );
+      void admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime );
+      list<PCB>::iterator selectNext( list<PCB>& readyQueue, double currentTime );
+      float findQuantum( const PCB& process );
+      void onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime );
+      void onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime );
+      void onComplete( PCB& process, double currentTime );
+      void finish( RunStats& stats, double currentTime );
+   private:
+      void boost( double currentTime );
+      void applyBoost( PCB& process );
+      void changeLevel( PCB& process, int level, double currentTime );
+      vector< deque< list<PCB>::iterator > > levels; // Ready processes of each level
+      vector<LevelSummary> levelStats; // statistics of each level
+      float boostTime; // time between priority boosts (sec, 0 for none)
+      double lastBoost; // time of latest priority boost
+      double nextBoost; // time of next priority boost
+};
+
+// completely fair (cfs): runs the process that has received the least
+// processor time, kept in a red-black tree ordered by virtual run time.
+// Time slices share the target latency among the Ready processes, but are
+// never shorter than the minimum granularity.
+class FairSharePolicy : public FifoPolicy
+{
+   public:
+      static const bool PREEMPTIVE = true;
+      FairSharePolicy( float quantum, const PolicySettings& settings );
+      void admit( list<PCB>& readyQueue, list<PCB>& newProcesses, double currentTime );
+      list<PCB>::iterator selectNext( list<PCB>& readyQueue, double currentTime );
+      float findQuantum( const PCB& process );
+      void onPreempt( list<PCB>& readyQueue, list<PCB>& runningQueue, bool usedQuantum, double currentTime );
+      void onBlock( PCB& process, double currentTime );
+      void onReady( list<PCB>& readyQueue, list<PCB>& blockedQueue, list<PCB>::iterator process, double currentTime );
+      void onComplete( PCB& process, double currentTime );
+   private:
+      void insert( list<PCB>::iterator process );
+      void chargeRuntime( PCB& process, double currentTime );
+      map< pair<double, long>, list<PCB>::iterator > tree; // Ready processes by virtual run time (then queue order)
+      long sequence; // order processes were queued in
+      double minRuntime; // lowest virtual run time (never decreases)
+      float targetLatency; // time to run every Ready process once (cycles)
+      float minGranularity; // shortest time slice (cycles)
+      int runnableCount; // Ready processes when current process was selected (including it)
+      double runStart; // time current process was selected
+};
+
+#endif
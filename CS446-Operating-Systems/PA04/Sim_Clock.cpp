@@ -0,0 +1,641 @@
+/**
+ * @file   Sim_Clock.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Simulation clock for Operating System simulator
+ *
+ * Keeps simulator time in either real mode (actions wait on the monotonic
+ * wall clock) or virtual mode (time jumps from event to event in an
+ * event queue keyed on simulated timestamps, so no time is actually spent).
+ *
+ * In virtual mode several threads (the processor and each I/O device) can
+ * wait on the clock at once. The clock only advances to the next event
+ * once every active thread is waiting on time or has gone idle, so
+ * concurrent actions overlap the same way they would in real time.
+ *
+ * Deterministic mode is virtual mode with one thread running at a time.
+ * Each thread made active takes a ticket (threads waking at the same
+ * time take them in the order they started waiting, and a thread handed
+ * work takes one from the thread that hands it over), and runs only once
+ * every earlier ticket has waited or gone idle. The order of events, and
+ * so the log, is then the same on every run.
+ *
+ * Times are kept as 64-bit nanosecond counts, so a 10 msec cycle is exact
+ * at any point of a long run (a float number of seconds is only accurate
+ * to about 8 msec after 65536 seconds). Callers read the time once per
+ * event with now() and convert it to seconds only for output.
+ *
+ * Real time is read from the monotonic clock, or optionally from the
+ * processor time stamp counter (TSC), which is read without a system call.
+ * The TSC is only used if the processor reports that it runs at a constant
+ * rate on every core (invariant TSC); its rate is measured against the
+ * monotonic clock when the clock is started.
+ */
+
+// header files
+   #include "Sim_Clock.h"
+   #include <ctime> // used to keep track of time
+   #include <stdint.h> // used for nanosecond times
+   #include <queue> // used to store pending events
+   #include <vector> // used as event queue container
+   #include <functional> // used for event ordering
+   #include <pthread.h> // used for threads
+   #include <errno.h> // used to check for interrupted sleep
+
+   #if defined( __x86_64__ ) || defined( __i386__ )
+      #include <x86intrin.h> // used to read time stamp counter
+      #include <cpuid.h> // used to check for invariant time stamp counter
+   #endif
+
+   using namespace std;
+
+// global constants
+   const int64_t TSC_CALIBRATE_TIME = 20 * NSEC_PER_MSEC; // time to measure TSC rate over
+   const int TSC_SAMPLE_COUNT = 5; // clock readings per TSC calibration point
+
+// global variables
+
+// function prototypes
+   int64_t readMonotonic();
+   uint64_t readTsc();
+   bool hasInvariantTsc();
+   void sampleClocks( int64_t& monotonicTime, uint64_t& tscTime );
+
+// class implementation
+
+/**
+operator>
+
+Orders events by time, then by the order their threads started waiting.
+
+@param other event to compare with
+@pre none
+@post none
+@return bool representing this event comes after other
+*/
+bool ClockEvent::operator>( const ClockEvent& other ) const
+{
+   return time != other.time ? time > other.time : order > other.order;
+}
+
+SimClock::SimClock()
+{
+   virtualTime = false;
+   tscTime = false;
+   deterministic = false;
+   startTime = readMonotonic();
+   tscStart = 0;
+   nanosPerTick = 0;
+   simTime = 0;
+   activeActors = 1;
+   waitCount = 0;
+   turn = 0;
+   nextTicket = 1;
+   pthread_mutex_init( &lock, NULL );
+   pthread_cond_init( &timeChanged, NULL );
+}
+
+SimClock::~SimClock()
+{
+   pthread_mutex_destroy( &lock );
+   pthread_cond_destroy( &timeChanged );
+}
+
+/**
+start
+
+Resets the clock to time zero in the given mode. The calling thread
+is counted as the only active thread (and holds the first turn).
+
+@param useVirtualTime true to use simulated time, false for real time
+@param useTsc true to read real time from the time stamp counter, if the processor has an invariant one
+@param useDeterministic true to run one thread at a time (virtual time only)
+@pre no other thread is using the clock
+@post clock is at time zero
+@return void
+*/
+void SimClock::start( bool useVirtualTime, bool useTsc, bool useDeterministic )
+{
+   // set mode
+   virtualTime = useVirtualTime;
+   deterministic = useDeterministic && useVirtualTime;
+   tscTime = useTsc && !useVirtualTime && calibrateTsc();
+
+   // reset times
+   if( tscTime )
+   {
+      sampleClocks( startTime, tscStart );
+   }
+   else
+   {
+      startTime = readMonotonic();
+   }
+
+   simTime = 0;
+   activeActors = 1;
+   waitCount = 0;
+   turn = 0;
+   nextTicket = 1;
+
+   // clear any pending events
+   while( !events.empty() )
+   {
+      events.pop();
+   }
+}
+
+/**
+now
+
+Returns the time since the clock was started, in nanoseconds.
+
+@pre clock was started
+@post none
+@return int64_t with elapsed time in nanoseconds
+*/
+int64_t SimClock::now()
+{
+   // initialize variables
+   int64_t elapsed;
+
+   // for virtual time
+   if( virtualTime )
+   {
+      pthread_mutex_lock( &lock );
+      elapsed = simTime;
+      pthread_mutex_unlock( &lock );
+
+      return elapsed;
+   }
+
+   // for time stamp counter
+   if( tscTime )
+   {
+      return (int64_t)( (double)( readTsc() - tscStart ) * nanosPerTick );
+   }
+
+   // for real time
+   return readMonotonic() - startTime;
+}
+
+/**
+currentTime
+
+Returns the time since the clock was started, in seconds.
+
+@pre clock was started
+@post none
+@return double with elapsed time in seconds
+*/
+double SimClock::currentTime()
+{
+   return toSeconds( now() );
+}
+
+/**
+waitUntil
+
+Waits until the clock reaches the given time.
+In real mode the thread sleeps until the monotonic clock reaches the end
+time (an absolute deadline, so time spent logging between actions does
+not add up). In virtual mode the end time is queued as an event and the
+thread waits until the clock advances to it (and, in deterministic
+mode, until its turn).
+
+@param endTime time (in nanoseconds) to wait until
+@pre clock was started, calling thread is active (holds the turn)
+@post clock is at or past endTime
+@return void
+*/
+void SimClock::waitUntil( int64_t endTime )
+{
+   // initialize variables
+   int64_t remaining;
+   int64_t deadline;
+   int64_t ticket = NO_TICKET;
+   ClockEvent event;
+   timespec sleepTime;
+
+   // for virtual time
+   if( virtualTime )
+   {
+      pthread_mutex_lock( &lock );
+
+      // check for time already reached
+      if( endTime > simTime )
+      {
+         // queue completion event and stop being active
+         event.time = endTime;
+         event.order = waitCount++;
+         event.ticket = &ticket;
+         events.push( event );
+         activeActors--;
+         endTurn();
+
+         // advance if every thread is waiting
+         advance();
+
+         // wait for clock to reach event (reactivated by advance)
+         while( simTime < endTime || ( deterministic && ticket != turn ) )
+         {
+            pthread_cond_wait( &timeChanged, &lock );
+         }
+      }
+
+      pthread_mutex_unlock( &lock );
+
+      return;
+   }
+
+   // for real time
+   remaining = endTime - now();
+
+   while( remaining > 0 )
+   {
+      // sleep until deadline
+      deadline = readMonotonic() + remaining;
+      sleepTime.tv_sec = deadline / NSEC_PER_SEC;
+      sleepTime.tv_nsec = deadline % NSEC_PER_SEC;
+
+      while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &sleepTime, NULL ) == EINTR )
+      {
+      }
+
+      // check again (time stamp counter may differ slightly from monotonic clock)
+      remaining = endTime - now();
+   }
+}
+
+/**
+actorIdle
+
+Marks the calling thread as idle (waiting for work from another thread
+rather than for time), ending its turn. Only used by virtual mode.
+
+@pre calling thread is active
+@post calling thread is no longer counted as active
+@return void
+*/
+void SimClock::actorIdle()
+{
+   // check for virtual time
+   if( !virtualTime )
+   {
+      return;
+   }
+
+   pthread_mutex_lock( &lock );
+
+   activeActors--;
+   endTurn();
+
+   // advance if every thread is waiting
+   advance();
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+actorWake
+
+Marks an idle thread as active again. Called by the thread that hands
+it work, before the work is handed over, so time cannot advance in between.
+The woken thread passes the ticket returned to awaitTurn before it runs.
+
+@pre an idle thread is about to be given work
+@post one more thread is counted as active
+@return int64_t with ticket of woken thread (NO_TICKET in real time)
+*/
+int64_t SimClock::actorWake()
+{
+   // initialize variables
+   int64_t ticket;
+
+   // check for virtual time
+   if( !virtualTime )
+   {
+      return NO_TICKET;
+   }
+
+   pthread_mutex_lock( &lock );
+
+   activeActors++;
+   ticket = nextTicket++;
+
+   pthread_mutex_unlock( &lock );
+
+   return ticket;
+}
+
+/**
+awaitTurn
+
+Waits until the thread with the given ticket may run. Only waits in
+deterministic mode; otherwise every active thread runs at once.
+
+@param ticket ticket returned by actorWake for the calling thread
+@pre calling thread was woken with actorWake
+@post calling thread holds the turn
+@return void
+*/
+void SimClock::awaitTurn( int64_t ticket )
+{
+   // check for deterministic mode
+   if( !deterministic )
+   {
+      return;
+   }
+
+   pthread_mutex_lock( &lock );
+
+   while( turn != ticket )
+   {
+      pthread_cond_wait( &timeChanged, &lock );
+   }
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+isVirtual
+
+Returns true if clock uses simulated time.
+
+@pre none
+@post none
+@return bool representing virtual time mode
+*/
+bool SimClock::isVirtual()
+{
+   return virtualTime;
+}
+
+/**
+isDeterministic
+
+Returns true if clock runs one thread at a time.
+
+@pre none
+@post none
+@return bool representing deterministic mode
+*/
+bool SimClock::isDeterministic()
+{
+   return deterministic;
+}
+
+/**
+usesTsc
+
+Returns true if real time is read from the time stamp counter.
+
+@pre clock was started
+@post none
+@return bool representing time stamp counter use
+*/
+bool SimClock::usesTsc()
+{
+   return tscTime;
+}
+
+/**
+toSeconds
+
+Converts a time in nanoseconds to seconds.
+
+@param nanos time in nanoseconds
+@pre none
+@post none
+@return double with time in seconds
+*/
+double SimClock::toSeconds( int64_t nanos )
+{
+   return (double) nanos / NSEC_PER_SEC;
+}
+
+/**
+fromMsec
+
+Converts a time in milliseconds to nanoseconds (rounded to nearest).
+
+@param msec time in milliseconds
+@pre none
+@post none
+@return int64_t with time in nanoseconds
+*/
+int64_t SimClock::fromMsec( double msec )
+{
+   return (int64_t)( msec * NSEC_PER_MSEC + 0.5 );
+}
+
+/**
+advance
+
+Moves simulated time to the earliest pending event if no thread is active.
+Every thread waiting on that time is counted as active again, and given
+a ticket in the order it started waiting.
+
+@pre lock is held
+@post time advanced and waiting threads signaled, if no thread was active
+@return void
+*/
+void SimClock::advance()
+{
+   // check for active threads or no events
+   if( activeActors > 0 || events.empty() )
+   {
+      return;
+   }
+
+   // move to earliest event (never backwards)
+   if( events.top().time > simTime )
+   {
+      simTime = events.top().time;
+   }
+
+   // reactivate each thread waiting on this time
+   while( !events.empty() && events.top().time <= simTime )
+   {
+      *( events.top().ticket ) = nextTicket++;
+      events.pop();
+      activeActors++;
+   }
+
+   pthread_cond_broadcast( &timeChanged );
+}
+
+/**
+endTurn
+
+Passes the turn to the next ticket, in deterministic mode.
+
+@pre lock is held, calling thread holds the turn
+@post next ticket may run
+@return void
+*/
+void SimClock::endTurn()
+{
+   if( deterministic )
+   {
+      turn++;
+      pthread_cond_broadcast( &timeChanged );
+   }
+}
+
+/**
+calibrateTsc
+
+Measures the time stamp counter rate against the monotonic clock.
+
+@pre none
+@post nanosPerTick was set, if the processor has an invariant time stamp counter
+@return bool representing time stamp counter can be used
+*/
+bool SimClock::calibrateTsc()
+{
+   // initialize variables
+   int64_t firstTime;
+   int64_t lastTime;
+   uint64_t firstTicks;
+   uint64_t lastTicks;
+   timespec sleepTime;
+
+   // check for invariant counter
+   if( !hasInvariantTsc() )
+   {
+      return false;
+   }
+
+   // read both clocks, wait, and read them again
+   sampleClocks( firstTime, firstTicks );
+
+   sleepTime.tv_sec = 0;
+   sleepTime.tv_nsec = TSC_CALIBRATE_TIME;
+   nanosleep( &sleepTime, NULL );
+
+   sampleClocks( lastTime, lastTicks );
+
+   // check for counter that did not advance
+   if( lastTicks <= firstTicks || lastTime <= firstTime )
+   {
+      return false;
+   }
+
+   nanosPerTick = (double)( lastTime - firstTime ) / (double)( lastTicks - firstTicks );
+
+   return true;
+}
+
+// function implementation
+
+/**
+readMonotonic
+
+Returns the monotonic clock time in nanoseconds.
+
+@pre none
+@post none
+@return int64_t with monotonic time in nanoseconds
+*/
+int64_t readMonotonic()
+{
+   // initialize variables
+   timespec now;
+
+   clock_gettime( CLOCK_MONOTONIC, &now );
+
+   return (int64_t) now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+}
+
+/**
+readTsc
+
+Returns the processor time stamp counter.
+
+@pre processor has a time stamp counter
+@post none
+@return uint64_t with counter ticks (0 if not an x86 processor)
+*/
+uint64_t readTsc()
+{
+   #if defined( __x86_64__ ) || defined( __i386__ )
+      return __rdtsc();
+   #else
+      return 0;
+   #endif
+}
+
+/**
+hasInvariantTsc
+
+Checks whether the processor time stamp counter runs at a constant rate
+on every core, in every power state.
+
+@pre none
+@post none
+@return bool representing invariant time stamp counter
+*/
+bool hasInvariantTsc()
+{
+   #if defined( __x86_64__ ) || defined( __i386__ )
+      // initialize variables
+      unsigned int eax;
+      unsigned int ebx;
+      unsigned int ecx;
+      unsigned int edx;
+
+      // check for advanced power management leaf
+      if( __get_cpuid_max( 0x80000000, NULL ) < 0x80000007 )
+      {
+         return false;
+      }
+
+      if( !__get_cpuid( 0x80000007, &eax, &ebx, &ecx, &edx ) )
+      {
+         return false;
+      }
+
+      // invariant TSC flag is bit 8 of edx
+      return ( edx & ( 1 << 8 ) ) != 0;
+   #else
+      return false;
+   #endif
+}
+
+/**
+sampleClocks
+
+Reads the monotonic clock and the time stamp counter at (nearly) the
+same moment. Several readings are taken and the one with the shortest
+gap between its two counter reads is used.
+
+@param monotonicTime monotonic time in nanoseconds
+@param tscTime counter ticks halfway through the monotonic clock read
+@pre none
+@post monotonicTime and tscTime were set
+@return void
+*/
+void sampleClocks( int64_t& monotonicTime, uint64_t& tscTime )
+{
+   // initialize variables
+   uint64_t before;
+   uint64_t after;
+   uint64_t shortest = 0;
+   int64_t readTime;
+   int sample;
+
+   for( sample = 0; sample < TSC_SAMPLE_COUNT; sample++ )
+   {
+      before = readTsc();
+      readTime = readMonotonic();
+      after = readTsc();
+
+      // keep reading with shortest gap
+      if( sample == 0 || after - before < shortest )
+      {
+         shortest = after - before;
+         monotonicTime = readTime;
+         tscTime = before + ( after - before ) / 2;
+      }
+   }
+}
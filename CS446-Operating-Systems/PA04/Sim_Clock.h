@@ -0,0 +1,78 @@
+/**
+ * @file   Sim_Clock.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Simulation clock header for Operating System simulator
+ */
+
+// definition
+   #ifndef __SIMCLOCK_H_
+   #define __SIMCLOCK_H_
+
+// header files
+   #include <ctime> // used to keep track of time
+   #include <stdint.h> // used for nanosecond times
+   #include <queue> // used to store pending events
+   #include <vector> // used as event queue container
+   #include <functional> // used for event ordering
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+   const int64_t NSEC_PER_SEC = 1000000000;
+   const int64_t NSEC_PER_MSEC = 1000000;
+   const int64_t NO_TICKET = -1;
+
+// global variables
+
+// class declaration
+
+// time a thread waits on, in order of time then of waiting
+class ClockEvent
+{
+   public:
+      bool operator>( const ClockEvent& other ) const;
+      int64_t time; // simulated time to wake at (nsec)
+      int64_t order; // number of waits before this one
+      int64_t* ticket; // turn given to waiting thread (deterministic mode)
+};
+
+class SimClock
+{
+   public:
+      SimClock();
+      ~SimClock();
+      void start( bool useVirtualTime, bool useTsc = false, bool useDeterministic = false );
+      int64_t now();
+      double currentTime();
+      void waitUntil( int64_t endTime );
+      void actorIdle();
+      int64_t actorWake();
+      void awaitTurn( int64_t ticket );
+      bool isVirtual();
+      bool isDeterministic();
+      bool usesTsc();
+      static double toSeconds( int64_t nanos );
+      static int64_t fromMsec( double msec );
+   private:
+      void advance();
+      void endTurn();
+      bool calibrateTsc();
+      bool virtualTime; // true if simulated time is used instead of real time
+      bool tscTime; // true if real time is read from the time stamp counter
+      bool deterministic; // true if one thread runs at a time, in turn order
+      int64_t startTime; // real start time (monotonic nsec)
+      uint64_t tscStart; // time stamp counter at start time
+      double nanosPerTick; // time stamp counter rate (nsec per tick)
+      int64_t simTime; // current simulated time (nsec)
+      int activeActors; // threads that are running (not waiting on time or work)
+      int64_t waitCount; // waits on simulated time so far (orders events)
+      int64_t turn; // ticket of thread allowed to run (deterministic mode)
+      int64_t nextTicket; // ticket given to next thread made active
+      priority_queue< ClockEvent, vector<ClockEvent>, greater<ClockEvent> > events; // pending events
+      pthread_mutex_t lock; // guards simulated time, events and turns
+      pthread_cond_t timeChanged; // signaled when simulated time advances or the turn moves
+};
+
+#endif
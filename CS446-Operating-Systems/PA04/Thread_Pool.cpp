@@ -0,0 +1,233 @@
+/**
+ * @file   Thread_Pool.cpp
+ * @author 831835
+ * @date   April 2015
+ * @brief  Worker thread pool for Operating System simulator
+ *
+ * Keeps a fixed number of long-lived worker threads that pull work items
+ * from a shared queue, so actions do not pay for a thread being created
+ * and joined every time they run.
+ */
+
+// header files
+   #include "Thread_Pool.h"
+   #include <queue> // used to store work items
+   #include <vector> // used to store worker threads
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class implementation
+ThreadPool::ThreadPool()
+{
+   pending = 0;
+   stopping = false;
+   pthread_mutex_init( &lock, NULL );
+   pthread_cond_init( &workReady, NULL );
+   pthread_cond_init( &workDone, NULL );
+}
+
+ThreadPool::~ThreadPool()
+{
+   stop();
+   pthread_mutex_destroy( &lock );
+   pthread_cond_destroy( &workReady );
+   pthread_cond_destroy( &workDone );
+}
+
+/**
+start
+
+Creates the worker threads. Does nothing if the pool is already running.
+
+@param size number of worker threads to create (at least one is created)
+@pre none
+@post size worker threads are waiting for work
+@return void
+*/
+void ThreadPool::start( int size )
+{
+   // initialize variables
+   pthread_t tid;
+   int index;
+
+   // check for running pool
+   if( !workers.empty() )
+   {
+      return;
+   }
+
+   // always keep at least one worker
+   if( size < 1 )
+   {
+      size = 1;
+   }
+
+   stopping = false;
+
+   // create each worker
+   for( index = 0; index < size; index++ )
+   {
+      pthread_create( &tid, NULL, worker, this );
+      workers.push_back( tid );
+   }
+}
+
+/**
+submit
+
+Queues a function to be run by the next free worker.
+
+@param function function to run
+@param argument argument to pass to function
+@pre pool was started
+@post work item was queued
+@return void
+*/
+void ThreadPool::submit( void *(*function)( void* ), void* argument )
+{
+   // initialize variables
+   WorkItem item;
+   item.function = function;
+   item.argument = argument;
+
+   // queue work and wake a worker
+   pthread_mutex_lock( &lock );
+   work.push( item );
+   pending++;
+   pthread_cond_signal( &workReady );
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+wait
+
+Waits until every submitted work item has completed.
+
+@pre pool was started
+@post no work is queued or running
+@return void
+*/
+void ThreadPool::wait()
+{
+   pthread_mutex_lock( &lock );
+
+   while( pending > 0 )
+   {
+      pthread_cond_wait( &workDone, &lock );
+   }
+
+   pthread_mutex_unlock( &lock );
+}
+
+/**
+stop
+
+Finishes queued work, then ends and joins every worker thread.
+
+@pre none
+@post no worker threads are running
+@return void
+*/
+void ThreadPool::stop()
+{
+   // initialize variables
+   unsigned int index;
+
+   // check for stopped pool
+   if( workers.empty() )
+   {
+      return;
+   }
+
+   // finish remaining work
+   wait();
+
+   // tell workers to exit
+   pthread_mutex_lock( &lock );
+   stopping = true;
+   pthread_cond_broadcast( &workReady );
+   pthread_mutex_unlock( &lock );
+
+   // join each worker
+   for( index = 0; index < workers.size(); index++ )
+   {
+      pthread_join( workers[ index ], NULL );
+   }
+
+   workers.clear();
+}
+
+/**
+size
+
+Returns the number of worker threads.
+
+@pre none
+@post none
+@return int with number of workers
+*/
+int ThreadPool::size()
+{
+   return workers.size();
+}
+
+/**
+worker
+
+Runs on each worker thread. Takes work items from the queue and runs
+them until the pool is stopped.
+
+@param poolVoidPtr void pointer to the owning ThreadPool
+@pre pool was started
+@post pool was stopped
+@return void
+*/
+void *ThreadPool::worker( void* poolVoidPtr )
+{
+   // initialize variables
+   ThreadPool* poolPtr = static_cast<ThreadPool*>( poolVoidPtr );
+   WorkItem item;
+
+   pthread_mutex_lock( &poolPtr->lock );
+
+   while( true )
+   {
+      // wait for work
+      while( poolPtr->work.empty() && !poolPtr->stopping )
+      {
+         pthread_cond_wait( &poolPtr->workReady, &poolPtr->lock );
+      }
+
+      // check for exit
+      if( poolPtr->work.empty() )
+      {
+         break;
+      }
+
+      // take next work item
+      item = poolPtr->work.front();
+      poolPtr->work.pop();
+
+      // run work without holding lock
+      pthread_mutex_unlock( &poolPtr->lock );
+      item.function( item.argument );
+      pthread_mutex_lock( &poolPtr->lock );
+
+      // mark work complete
+      poolPtr->pending--;
+
+      if( poolPtr->pending == 0 )
+      {
+         pthread_cond_broadcast( &poolPtr->workDone );
+      }
+   }
+
+   pthread_mutex_unlock( &poolPtr->lock );
+
+   return NULL;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file   Thread_Pool.h
+ * @author 831835
+ * @date   April 2015
+ * @brief  Worker thread pool header for Operating System simulator
+ */
+
+// definition
+   #ifndef __THREADPOOL_H_
+   #define __THREADPOOL_H_
+
+// header files
+   #include <queue> // used to store work items
+   #include <vector> // used to store worker threads
+   #include <pthread.h> // used for threads
+
+   using namespace std;
+
+// global constants
+
+// global variables
+
+// class declaration
+class WorkItem
+{
+   public:
+      void *(*function)( void* ); // function to run
+      void* argument; // argument passed to function
+};
+
+class ThreadPool
+{
+   public:
+      ThreadPool();
+      ~ThreadPool();
+      void start( int size );
+      void submit( void *(*function)( void* ), void* argument );
+      void wait();
+      void stop();
+      int size();
+   private:
+      static void *worker( void* poolVoidPtr );
+      vector<pthread_t> workers; // long-lived worker threads
+      queue<WorkItem> work; // work waiting for a worker
+      int pending; // work submitted but not yet completed
+      bool stopping; // true when workers should exit
+      pthread_mutex_t lock; // guards work queue and counters
+      pthread_cond_t workReady; // signaled when work is queued
+      pthread_cond_t workDone; // signaled when all work completes
+};
+
+#endif
@@ -0,0 +1,313 @@
+#!/bin/bash
+#
+# @file   run_regression.sh
+# @author 831835
+# @date   April 2015
+# @brief  Golden log regression tests for the Operating System simulators
+#
+# Builds each phase, then runs every bundled config/meta pair (configN with
+# metaN of the same folder) in deterministic mode, so log times are simulated
+# and the log is the same on every run. Each log is compared with its golden
+# log, and each repeat with the first, so both changed output and lost
+# determinism are reported. Phase 3 is also run with each scheduling code on
+# a larger generated workload (and with RR and dispatch overhead); those
+# logs are compared by checksum. Phase 3 memory is run with each page
+# replacement policy on a small workload of M actions (data/memory_meta).
+# Last, phase 3 is run once in real time while its time quantum is changed
+# and SIGHUP is sent, to check the configuration is reloaded.
+#
+# Each case is run REPEAT times and its fastest time is compared with the
+# golden time. A case fails if it is slower than FACTOR times the golden
+# time plus FLOOR milliseconds (so short runs are not failed by noise).
+#
+# usage: run_regression.sh [--update] [--repeat N] [--factor F] [--floor MS]
+#    --update   save current logs and times as the golden ones
+#
+# Exits with 1 if any case failed.
+
+# global constants
+REGRESSION_DIR="$( cd "$( dirname "$0" )" && pwd )"
+ROOT_DIR="$( dirname "$REGRESSION_DIR" )"
+GOLDEN_DIR="$REGRESSION_DIR/golden"
+DATA_DIR="$REGRESSION_DIR/data"
+TIMINGS_FILE="$GOLDEN_DIR/timings"
+BENCH_SEED=7
+BENCH_PROCESSES=1000
+BENCH_POLICIES="FIFO SJF SRTF FIFO-P RR SRTF-P MLFQ CFS"
+MEMORY_FRAMES=8
+MEMORY_POLICIES="FIFO LRU CLOCK"
+DIFF_LINES=10
+RELOAD_DELAY=0.2
+RELOAD_QUANTUM=3
+
+# global variables
+update=false
+repeat=3
+factor=1.5
+floor=50
+passCount=0
+failCount=0
+
+# read in arguments
+while [ $# -gt 0 ]
+do
+   case "$1" in
+      --update) update=true ;;
+      --repeat) repeat="$2"; shift ;;
+      --factor) factor="$2"; shift ;;
+      --floor) floor="$2"; shift ;;
+      *) echo "Incorrect arguments given. Please try again."; exit 1 ;;
+   esac
+   shift
+done
+
+workDir="$( mktemp -d )"
+trap 'rm -rf "$workDir"' EXIT
+
+# makeConfig source meta log config
+#
+# Copies a configuration file, reading the given meta-data and logging
+# only to the given log file.
+makeConfig()
+{
+   sed -e "s#^File Path:.*#File Path: $2#" \
+       -e "s#^Log:.*#Log: Log to File#" \
+       -e "s#^Log File Path:.*#Log File Path: $3#" "$1" > "$4"
+}
+
+# findTime name
+#
+# Prints the golden time of a case (nothing if none).
+findTime()
+{
+   [ -f "$TIMINGS_FILE" ] && awk -v name="$1" '$1 == name { print $2 }' "$TIMINGS_FILE"
+}
+
+# runCase name program config log golden
+#
+# Runs one case REPEAT times and checks its log and time. The log is
+# compared in full with golden, or by checksum if golden ends in .sha256.
+runCase()
+{
+   # initialize variables
+   local name="$1" program="$2" config="$3" log="$4" golden="$5"
+   local run startTime endTime runTime fastest="" baseline limit
+   local problem=""
+
+   for (( run = 1; run <= repeat; run++ ))
+   do
+      startTime=$( date +%s%N )
+
+      if ! "$program" --deterministic "$config" > /dev/null 2>&1
+      then
+         problem="exited with failure"
+         break
+      fi
+
+      endTime=$( date +%s%N )
+      runTime=$(( ( endTime - startTime ) / 1000000 ))
+
+      if [ -z "$fastest" ] || [ "$runTime" -lt "$fastest" ]
+      then
+         fastest=$runTime
+      fi
+
+      # check each repeat matches first run
+      if [ $run -eq 1 ]
+      then
+         cp "$log" "$workDir/first.log"
+      elif ! cmp -s "$log" "$workDir/first.log"
+      then
+         problem="log changed between runs (not deterministic)"
+         break
+      fi
+   done
+
+   # save golden log and time
+   if [ -z "$problem" ] && $update
+   then
+      mkdir -p "$( dirname "$golden" )"
+
+      if [[ "$golden" == *.sha256 ]]
+      then
+         sha256sum < "$log" | cut -d ' ' -f 1 > "$golden"
+      else
+         cp "$log" "$golden"
+      fi
+
+      echo "$name $fastest" >> "$workDir/timings"
+      echo "SAVED $name ${fastest} ms"
+      passCount=$(( passCount + 1 ))
+      return
+   fi
+
+   # compare with golden log
+   if [ -z "$problem" ]
+   then
+      if [ ! -f "$golden" ]
+      then
+         problem="no golden log (run with --update)"
+      elif [[ "$golden" == *.sha256 ]]
+      then
+         if [ "$( sha256sum < "$log" | cut -d ' ' -f 1 )" != "$( cat "$golden" )" ]
+         then
+            problem="log checksum differs from golden"
+         fi
+      elif ! cmp -s "$golden" "$log"
+      then
+         problem="log differs from golden"
+         diff "$golden" "$log" | head -n $DIFF_LINES > "$workDir/diff"
+      fi
+   fi
+
+   # compare with golden time
+   baseline="$( findTime "$name" )"
+
+   if [ -z "$problem" ] && [ -n "$baseline" ]
+   then
+      limit=$( awk -v base="$baseline" -v factor="$factor" -v floor="$floor" 'BEGIN { printf "%d", base * factor + floor }' )
+
+      if [ "$fastest" -gt "$limit" ]
+      then
+         problem="slower than golden (${fastest} ms, limit ${limit} ms)"
+      fi
+   fi
+
+   # print result
+   if [ -z "$problem" ]
+   then
+      echo "PASS $name ${fastest} ms (golden ${baseline:-none} ms)"
+      passCount=$(( passCount + 1 ))
+   else
+      echo "FAIL $name: $problem"
+      failCount=$(( failCount + 1 ))
+
+      if [ -s "$workDir/diff" ]
+      then
+         sed 's/^/   /' "$workDir/diff"
+         rm -f "$workDir/diff"
+      fi
+   fi
+}
+
+# runReloadCase name program config log
+#
+# Runs one case in real time, changes its time quantum and sends SIGHUP
+# part way through, and checks the log shows the new quantum was loaded.
+runReloadCase()
+{
+   # initialize variables
+   local name="$1" program="$2" config="$3" log="$4"
+   local programID problem=""
+
+   "$program" "$config" > /dev/null 2>&1 &
+   programID=$!
+
+   sleep $RELOAD_DELAY
+   sed -i "s#^Quantum time (cycles):.*#Quantum time (cycles): $RELOAD_QUANTUM#" "$config"
+   kill -HUP $programID 2> /dev/null
+
+   if ! wait $programID
+   then
+      problem="exited with failure"
+   elif ! grep -q "OS: configuration reloaded (quantum $RELOAD_QUANTUM\.0* cycles)" "$log"
+   then
+      problem="configuration not reloaded"
+      grep "OS: configuration" "$log" | head -n $DIFF_LINES > "$workDir/diff"
+   fi
+
+   # print result
+   if [ -z "$problem" ]
+   then
+      echo "PASS $name"
+      passCount=$(( passCount + 1 ))
+   else
+      echo "FAIL $name: $problem"
+      failCount=$(( failCount + 1 ))
+
+      if [ -s "$workDir/diff" ]
+      then
+         sed 's/^/   /' "$workDir/diff"
+         rm -f "$workDir/diff"
+      fi
+   fi
+}
+
+# runPairs phase program dataDir count
+#
+# Runs configN with metaN of a data folder, for N from 1 to count.
+runPairs()
+{
+   # initialize variables
+   local phase="$1" program="$2" dataDir="$3" count="$4" index
+
+   for (( index = 1; index <= count; index++ ))
+   do
+      makeConfig "$dataDir/config$index" "$dataDir/meta$index" "$workDir/log" "$workDir/config"
+      runCase "$phase/config$index" "$program" "$workDir/config" "$workDir/log" "$GOLDEN_DIR/$phase/config$index.log"
+   done
+}
+
+# build each phase
+for target in "PA02 OS_Phase_1" "PA02 workloadgenerator" "PA03 OS_Phase_2" "PA04 OS_Phase_3"
+do
+   set -- $target
+
+   if ! make -s -C "$ROOT_DIR/$1" "$2" > "$workDir/build" 2>&1
+   then
+      cat "$workDir/build"
+      echo "FAIL build of $1 $2"
+      exit 1
+   fi
+done
+
+# run bundled pairs
+runPairs PA02 "$ROOT_DIR/PA02/OS_Phase_1" "$ROOT_DIR/PA02/support-files" 2
+runPairs PA03 "$ROOT_DIR/PA03/OS_Phase_2" "$ROOT_DIR/PA03/data" 5
+runPairs PA04 "$ROOT_DIR/PA04/OS_Phase_3" "$ROOT_DIR/PA04/data" 5
+
+# run generated workload with each scheduling code
+if ! "$ROOT_DIR/PA02/support-files/workloadgenerator" --output "$workDir/bench_meta" --seed $BENCH_SEED --processes $BENCH_PROCESSES > /dev/null 2>&1
+then
+   echo "FAIL generating bench meta-data"
+   exit 1
+fi
+
+for policy in $BENCH_POLICIES
+do
+   makeConfig "$ROOT_DIR/PA04/data/config5" "$workDir/bench_meta" "$workDir/log" "$workDir/config"
+   sed -i "s#^CPU Scheduling:.*#CPU Scheduling: $policy#" "$workDir/config"
+   runCase "PA04/bench_$policy" "$ROOT_DIR/PA04/OS_Phase_3" "$workDir/config" "$workDir/log" "$GOLDEN_DIR/PA04/bench_$policy.sha256"
+done
+
+# run generated workload with dispatch overhead
+makeConfig "$ROOT_DIR/PA04/data/config5" "$workDir/bench_meta" "$workDir/log" "$workDir/config"
+sed -i "s#^End Simulator Configuration File#Dispatch time (msec): 0.1\nContext switch time (msec): 1\n&#" "$workDir/config"
+runCase "PA04/bench_RR_switch" "$ROOT_DIR/PA04/OS_Phase_3" "$workDir/config" "$workDir/log" "$GOLDEN_DIR/PA04/bench_RR_switch.sha256"
+
+# run memory workload with each page replacement policy
+for replacement in $MEMORY_POLICIES
+do
+   makeConfig "$ROOT_DIR/PA04/data/config5" "$DATA_DIR/memory_meta" "$workDir/log" "$workDir/config"
+   sed -i "s#^End Simulator Configuration File#Memory frames: $MEMORY_FRAMES\nPage replacement: $replacement\n&#" "$workDir/config"
+   runCase "PA04/memory_$replacement" "$ROOT_DIR/PA04/OS_Phase_3" "$workDir/config" "$workDir/log" "$GOLDEN_DIR/PA04/memory_$replacement.log"
+done
+
+# reload configuration part way through a real time run
+makeConfig "$ROOT_DIR/PA04/data/config5" "$ROOT_DIR/PA04/data/meta4" "$workDir/log" "$workDir/config"
+sed -i -e "s#^Processor cycle time (msec):.*#Processor cycle time (msec): 1#" \
+       -e "s#^Monitor display time (msec):.*#Monitor display time (msec): 6#" \
+       -e "s#^Hard drive cycle time (msec):.*#Hard drive cycle time (msec): 1#" \
+       -e "s#^Printer cycle time (msec):.*#Printer cycle time (msec): 1#" \
+       -e "s#^Keyboard cycle time (msec):.*#Keyboard cycle time (msec): 3#" "$workDir/config"
+runReloadCase "PA04/reload" "$ROOT_DIR/PA04/OS_Phase_3" "$workDir/config" "$workDir/log"
+
+# save golden times
+if $update && [ $failCount -eq 0 ]
+then
+   cp "$workDir/timings" "$TIMINGS_FILE"
+fi
+
+echo "$passCount passed, $failCount failed"
+
+[ $failCount -eq 0 ]